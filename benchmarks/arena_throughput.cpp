@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/memory/stack_alloc.hpp>
+#include <cstddef>
+
+/**
+ * Arena throughput for the different block providers of stack_alloc.
+ *
+ * Each iteration builds an arena of state.range(0) MB out of 48 byte
+ * chunks, the size of a binary vari, writes to every chunk, reads all
+ * chunks back in reverse order as a reverse sweep would, and recovers
+ * the memory.  The first iteration pays for growing and first-touching
+ * the blocks; later iterations measure steady-state throughput.
+ *
+ * Build with `make benchmarks/arena_throughput`.
+ */
+template <typename BlockProvider>
+static void arena_throughput(benchmark::State& state,
+                             BlockProvider provider) {
+  using stan::math::basic_stack_alloc;
+  constexpr std::size_t chunk = 48;
+  const std::size_t n = (state.range(0) << 20) / chunk;
+  for (auto _ : state) {
+    basic_stack_alloc<BlockProvider> arena(
+        stan::math::internal::DEFAULT_INITIAL_NBYTES, provider);
+    for (int sweep = 0; sweep < 4; ++sweep) {
+      double* last = nullptr;
+      for (std::size_t i = 0; i < n; ++i) {
+        double* x = arena.template alloc_array<double>(chunk / sizeof(double));
+        x[0] = i;
+        x[1] = 0;
+        last = x;
+      }
+      benchmark::DoNotOptimize(last);
+      arena.recover_all();
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 4 * (state.range(0) << 20));
+}
+
+static void malloc_blocks(benchmark::State& state) {
+  arena_throughput(state, stan::math::malloc_block_provider());
+}
+
+static void mmap_blocks(benchmark::State& state) {
+  arena_throughput(state, stan::math::mmap_block_provider(false, false));
+}
+
+static void mmap_huge_page_blocks(benchmark::State& state) {
+  arena_throughput(state, stan::math::mmap_block_provider(true, false));
+}
+
+static void mmap_huge_page_prefaulted_blocks(benchmark::State& state) {
+  arena_throughput(state, stan::math::mmap_block_provider(true, true));
+}
+
+BENCHMARK(malloc_blocks)->RangeMultiplier(4)->Range(1, 1 << 9);
+BENCHMARK(mmap_blocks)->RangeMultiplier(4)->Range(1, 1 << 9);
+BENCHMARK(mmap_huge_page_blocks)->RangeMultiplier(4)->Range(1, 1 << 9);
+BENCHMARK(mmap_huge_page_prefaulted_blocks)
+    ->RangeMultiplier(4)
+    ->Range(1, 1 << 9);
+BENCHMARK_MAIN();
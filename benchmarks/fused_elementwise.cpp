@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/mix.hpp>
+
+/**
+ * Gradient of sum(exp(a .* b + c)) for vectors a, b and c of
+ * state.range(0) var_value elements, computed with a chain of
+ * vectorized functions and with one fused_elementwise() call.
+ *
+ * The counter reports the arena bytes used by one evaluation.
+ *
+ * Build with `make benchmarks/fused_elementwise`.
+ */
+struct exp_fma {
+  template <typename T1, typename T2, typename T3>
+  auto operator()(const T1& x, const T2& y, const T3& z) const {
+    using stan::math::exp;
+    return exp(x * y + z);
+  }
+};
+
+template <typename F>
+static void sum_exp_fma(benchmark::State& state, const F& f) {
+  using stan::math::var_value;
+  const int n = state.range(0);
+  Eigen::VectorXd a_val = Eigen::VectorXd::Random(n);
+  Eigen::VectorXd b_val = Eigen::VectorXd::Random(n);
+  Eigen::VectorXd c_val = Eigen::VectorXd::Random(n);
+  double bytes = 0;
+  for (auto _ : state) {
+    var_value<Eigen::VectorXd> a(a_val);
+    var_value<Eigen::VectorXd> b(b_val);
+    var_value<Eigen::VectorXd> c(c_val);
+    stan::math::var lp = stan::math::sum(f(a, b, c));
+    lp.grad();
+    bytes = stan::math::ChainableStack::instance_->memalloc_.bytes_used();
+    benchmark::DoNotOptimize(a.adj().data());
+    stan::math::recover_memory();
+  }
+  state.counters["arena_bytes"] = bytes;
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void unfused(benchmark::State& state) {
+  sum_exp_fma(state, [](const auto& a, const auto& b, const auto& c) {
+    return stan::math::exp(stan::math::add(stan::math::elt_multiply(a, b), c));
+  });
+}
+
+static void fused(benchmark::State& state) {
+  sum_exp_fma(state, [](const auto& a, const auto& b, const auto& c) {
+    return stan::math::fused_elementwise(exp_fma{}, a, b, c);
+  });
+}
+
+BENCHMARK(unfused)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(fused)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK_MAIN();
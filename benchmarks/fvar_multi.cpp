@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/mix.hpp>
+
+/**
+ * Forward-mode Jacobian and mixed Hessian of a function of
+ * state.range(0) arguments, with one tangent per evaluation and with
+ * blocks of 4 and 8 tangents carried by fvar_multi.
+ *
+ * Build with `make benchmarks/fvar_multi`.
+ */
+struct coupled {
+  template <typename T>
+  Eigen::Matrix<T, Eigen::Dynamic, 1> operator()(
+      const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log1p;
+    using stan::math::square;
+    const Eigen::Index N = x.size();
+    Eigen::Matrix<T, Eigen::Dynamic, 1> y(N);
+    T s = 0;
+    for (Eigen::Index i = 0; i < N; ++i) {
+      s += square(x(i));
+    }
+    for (Eigen::Index i = 0; i < N; ++i) {
+      y(i) = exp(0.1 * x(i)) * x((i + 1) % N) + log1p(s) / (i + 1);
+    }
+    return y;
+  }
+};
+
+struct coupled_sum {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    return coupled()(x).sum();
+  }
+};
+
+template <int K>
+static void jacobian(benchmark::State& state) {
+  Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(0));
+  Eigen::VectorXd fx;
+  Eigen::MatrixXd J;
+  for (auto _ : state) {
+    if (K == 0) {
+      stan::math::jacobian<double>(coupled(), x, fx, J);
+    } else {
+      stan::math::jacobian<K == 0 ? 1 : K>(coupled(), x, fx, J);
+    }
+    benchmark::DoNotOptimize(J.data());
+  }
+}
+
+template <int K>
+static void hessian(benchmark::State& state) {
+  Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(0));
+  double fx;
+  Eigen::VectorXd grad;
+  Eigen::MatrixXd H;
+  for (auto _ : state) {
+    if (K == 0) {
+      stan::math::hessian(coupled_sum(), x, fx, grad, H);
+    } else {
+      stan::math::hessian<K == 0 ? 1 : K>(coupled_sum(), x, fx, grad, H);
+    }
+    benchmark::DoNotOptimize(H.data());
+  }
+}
+
+BENCHMARK_TEMPLATE(jacobian, 0)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK_TEMPLATE(jacobian, 4)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK_TEMPLATE(jacobian, 8)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK_TEMPLATE(hessian, 0)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK_TEMPLATE(hessian, 4)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK_TEMPLATE(hessian, 8)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK_MAIN();
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/mix.hpp>
+#include <tbb/task_arena.h>
+
+/**
+ * Hessian of a log density of state.range(1) parameters computed with
+ * the rows split over state.range(0) threads.  Build with
+ * `STAN_THREADS` defined, for example with `CXXFLAGS += -DSTAN_THREADS`
+ * in make/local, and `make benchmarks/hessian_parallel`.  Without it
+ * the rows are computed serially.
+ */
+struct ar_lp {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    using stan::math::log1p;
+    using stan::math::square;
+    T lp = 0;
+    for (Eigen::Index i = 1; i < x.size(); ++i) {
+      lp -= 0.5 * square(x(i) - 0.9 * x(i - 1));
+    }
+    for (Eigen::Index i = 0; i < x.size(); ++i) {
+      lp -= log1p(square(x(i)));
+    }
+    return lp;
+  }
+};
+
+static void hessian(benchmark::State& state) {
+  const int threads = state.range(0);
+  Eigen::VectorXd x = Eigen::VectorXd::Random(state.range(1));
+  double fx;
+  Eigen::VectorXd grad;
+  Eigen::MatrixXd H;
+  tbb::task_arena arena(threads);
+  for (auto _ : state) {
+    arena.execute([&] { stan::math::hessian(ar_lp(), x, fx, grad, H, 1); });
+    benchmark::DoNotOptimize(H.data());
+  }
+}
+
+static void thread_counts(benchmark::internal::Benchmark* b) {
+  for (int N : {100, 300, 1000}) {
+    for (int threads = 1; threads <= 16; threads *= 2) {
+      b->Args({threads, N});
+    }
+  }
+}
+
+BENCHMARK(hessian)->Apply(thread_counts)->UseRealTime();
+BENCHMARK_MAIN();
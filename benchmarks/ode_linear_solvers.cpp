@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <stan/math.hpp>
+#include <vector>
+
+/**
+ * Gradients of the solution of a stiff discretized reaction diffusion
+ * equation with N states with respect to its two parameters, solved
+ * with ode_bdf with the dense direct linear solver, the banded direct
+ * linear solver and the matrix-free Krylov linear solver.
+ *
+ * The dense solver forms and factorizes an N x N Jacobian at every
+ * Newton setup, the banded solver a tridiagonal one from three RHS
+ * evaluations and the Krylov solver none at all. state.range(0) is N.
+ *
+ * Build with `make benchmarks/ode_linear_solvers`.
+ */
+struct reaction_diffusion {
+  template <typename T_y, typename T_theta>
+  Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1>
+  operator()(double t, const Eigen::Matrix<T_y, Eigen::Dynamic, 1>& y,
+             std::ostream* msgs, const std::vector<T_theta>& theta) const {
+    const int N = y.size();
+    Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1> dy_dt(
+        N);
+    for (int i = 0; i < N; ++i) {
+      const auto& left = i > 0 ? y.coeff(i - 1) : y.coeff(i);
+      const auto& right = i < N - 1 ? y.coeff(i + 1) : y.coeff(i);
+      dy_dt.coeffRef(i) = theta[0] * (left - 2 * y.coeff(i) + right)
+                          - theta[1] * stan::math::square(y.coeff(i));
+    }
+    return dy_dt;
+  }
+};
+
+template <typename Solve>
+static void ode_gradient(benchmark::State& state, const Solve& solve) {
+  using stan::math::var;
+  const int N = state.range(0);
+  Eigen::VectorXd y0(N);
+  for (int i = 0; i < N; ++i) {
+    y0.coeffRef(i) = 1.0 / (1.0 + i);
+  }
+  std::vector<double> ts{0.1, 1.0};
+  for (auto _ : state) {
+    std::vector<var> theta{0.1 * N * N, 0.5};
+    std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>> ys
+        = solve(reaction_diffusion(), y0, ts, theta);
+    var lp = 0;
+    for (const auto& y : ys) {
+      lp += stan::math::sum(y);
+    }
+    lp.grad();
+    benchmark::DoNotOptimize(theta[0].adj());
+    stan::math::recover_memory();
+  }
+}
+
+static void dense(benchmark::State& state) {
+  ode_gradient(state, [](const auto& f, const auto& y0, const auto& ts,
+                         const auto& theta) {
+    return stan::math::ode_bdf_tol(f, y0, 0.0, ts, 1e-6, 1e-6, 100000,
+                                   nullptr, theta);
+  });
+}
+
+static void banded(benchmark::State& state) {
+  ode_gradient(state, [](const auto& f, const auto& y0, const auto& ts,
+                         const auto& theta) {
+    return stan::math::ode_bdf_banded_tol(f, y0, 0.0, ts, 1e-6, 1e-6, 100000,
+                                          1, 1, nullptr, theta);
+  });
+}
+
+static void krylov(benchmark::State& state) {
+  ode_gradient(state, [](const auto& f, const auto& y0, const auto& ts,
+                         const auto& theta) {
+    return stan::math::ode_bdf_krylov_tol(f, y0, 0.0, ts, 1e-6, 1e-6, 100000,
+                                          nullptr, theta);
+  });
+}
+
+BENCHMARK(dense)->RangeMultiplier(4)->Range(16, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(banded)->RangeMultiplier(4)->Range(16, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(krylov)->RangeMultiplier(4)->Range(16, 1024)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK_MAIN();
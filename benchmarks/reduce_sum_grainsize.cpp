@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+#include <stan/math.hpp>
+#include <vector>
+
+/**
+ * Gradient of a normal log density of 4096 observations computed with
+ * reduce_sum at a grainsize of state.range(0), with a shared vector of
+ * state.range(1) parameters of which each observation uses one.  Small
+ * grainsizes measure the fixed cost of each work chunk.
+ *
+ * Build with `make benchmarks/reduce_sum_grainsize`.
+ */
+struct partial_lpdf {
+  template <typename T>
+  stan::return_type_t<T> operator()(const std::vector<double>& y_slice,
+                                    int start, int end, std::ostream* msgs,
+                                    const std::vector<T>& theta) const {
+    stan::return_type_t<T> lp = 0;
+    for (size_t i = 0; i < y_slice.size(); ++i) {
+      lp += stan::math::normal_lpdf(y_slice[i], theta[(start + i) % theta.size()],
+                                    1.0);
+    }
+    return lp;
+  }
+};
+
+template <bool Static>
+static void reduce_sum_gradient(benchmark::State& state) {
+  using stan::math::var;
+  std::vector<double> y(4096);
+  for (size_t i = 0; i < y.size(); ++i) {
+    y[i] = 0.001 * i;
+  }
+  for (auto _ : state) {
+    std::vector<var> theta;
+    for (int k = 0; k < state.range(1); ++k) {
+      theta.emplace_back(0.1 * k);
+    }
+    var lp = Static ? stan::math::reduce_sum_static<partial_lpdf>(
+                 y, state.range(0), nullptr, theta)
+                    : stan::math::reduce_sum<partial_lpdf>(
+                        y, state.range(0), nullptr, theta);
+    lp.grad();
+    benchmark::DoNotOptimize(theta[0].adj());
+    stan::math::recover_memory();
+  }
+}
+
+BENCHMARK_TEMPLATE(reduce_sum_gradient, false)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 1024}, {16, 4096}});
+BENCHMARK_TEMPLATE(reduce_sum_gradient, true)
+    ->RangeMultiplier(4)
+    ->Ranges({{1, 1024}, {16, 4096}});
+BENCHMARK_MAIN();
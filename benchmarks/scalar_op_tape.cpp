@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <cmath>
+#include <vector>
+
+/**
+ * Reverse sweep over a tape of state.range(0) scalar operations, once
+ * with one virtual chain() call per operation (the default operators)
+ * and once recorded on the scalar operation tape, which runs the
+ * reverse sweep in a switch-dispatched loop.
+ *
+ * Only the reverse sweep is timed.  Build with
+ * `make benchmarks/scalar_op_tape`.
+ */
+using stan::math::var;
+
+static var virtual_tape(const std::vector<var>& x, int n) {
+  var lp = 0;
+  for (int i = 0; i < n; i += 4) {
+    const var& xi = x[i % x.size()];
+    var t = xi * xi;
+    t = stan::math::make_callback_var(std::exp(t.val()), [t](auto& vi) mutable {
+      t.adj() += vi.adj() * vi.val();
+    });
+    t = stan::math::make_callback_var(std::log(t.val()), [t](auto& vi) mutable {
+      t.adj() += vi.adj() / t.val();
+    });
+    lp = lp + t;
+  }
+  return lp;
+}
+
+static var op_tape(const std::vector<var>& x, int n) {
+  using stan::math::internal::push_scalar_op;
+  using stan::math::internal::scalar_op;
+  var lp = 0;
+  for (int i = 0; i < n; i += 4) {
+    const var& xi = x[i % x.size()];
+    var t = push_scalar_op(scalar_op::multiply_vv, xi.val() * xi.val(), xi.vi_,
+                           xi.vi_);
+    t = push_scalar_op(scalar_op::exp_v, std::exp(t.val()), t.vi_);
+    t = push_scalar_op(scalar_op::log_v, std::log(t.val()), t.vi_);
+    lp = push_scalar_op(scalar_op::add_vv, lp.val() + t.val(), lp.vi_, t.vi_);
+  }
+  return lp;
+}
+
+template <typename F>
+static void reverse_sweep(benchmark::State& state, F&& f) {
+  std::vector<double> x_val(100, 0.1);
+  for (auto _ : state) {
+    std::vector<var> x(x_val.begin(), x_val.end());
+    var lp = f(x, state.range(0));
+    auto start = std::chrono::high_resolution_clock::now();
+    lp.grad();
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmark::DoNotOptimize(x[0].adj());
+    state.SetIterationTime(
+        std::chrono::duration_cast<std::chrono::duration<double>>(end - start)
+            .count());
+    stan::math::recover_memory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void virtual_dispatch(benchmark::State& state) {
+  reverse_sweep(state, virtual_tape);
+}
+
+static void scalar_op_tape(benchmark::State& state) {
+  reverse_sweep(state, op_tape);
+}
+
+BENCHMARK(virtual_dispatch)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22)
+    ->UseManualTime();
+BENCHMARK(scalar_op_tape)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22)
+    ->UseManualTime();
+BENCHMARK_MAIN();
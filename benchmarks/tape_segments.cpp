@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <tbb/task_arena.h>
+#include <vector>
+
+/**
+ * Reverse sweep of a hierarchical normal log density of 64 groups of
+ * state.range(1) observations each, recorded as one independent tape
+ * segment per group and chained on state.range(0) threads.  One
+ * thread runs the segments serially.
+ *
+ * Only the reverse sweep is timed.  Build with
+ * `make benchmarks/tape_segments`.
+ */
+using stan::math::var;
+
+static void tape_segments(benchmark::State& state) {
+  const int threads = state.range(0);
+  const int G = 64;
+  const int N = state.range(1);
+  std::vector<Eigen::VectorXd> y(G, Eigen::VectorXd::Random(N));
+  tbb::task_arena arena(threads);
+  for (auto _ : state) {
+    var mu = 0.1;
+    var tau = 0.5;
+    std::vector<var> theta(G);
+    for (auto& x : theta) {
+      x = 0.2;
+    }
+    stan::math::tape_segments segments;
+    std::vector<var> terms(G);
+    for (int g = 0; g < G; ++g) {
+      segments.begin();
+      var mu_g = segments.local(mu);
+      var tau_g = segments.local(tau);
+      var theta_g = segments.local(theta[g]);
+      terms[g] = stan::math::normal_lpdf(theta_g, mu_g, tau_g);
+      for (int n = 0; n < N; ++n) {
+        terms[g] += stan::math::normal_lpdf(y[g](n), theta_g, 1.0);
+      }
+      segments.end();
+    }
+    segments.join();
+    var lp = stan::math::sum(terms);
+    auto start = std::chrono::high_resolution_clock::now();
+    arena.execute([&] { lp.grad(); });
+    auto end = std::chrono::high_resolution_clock::now();
+    benchmark::DoNotOptimize(mu.adj());
+    state.SetIterationTime(
+        std::chrono::duration_cast<std::chrono::duration<double>>(end - start)
+            .count());
+    stan::math::recover_memory();
+  }
+}
+
+static void thread_counts(benchmark::internal::Benchmark* b) {
+  for (int N : {256, 4096}) {
+    for (int threads = 1; threads <= 16; threads *= 2) {
+      b->Args({threads, N});
+    }
+  }
+}
+
+BENCHMARK(tape_segments)->Apply(thread_counts)->UseManualTime();
+BENCHMARK_MAIN();
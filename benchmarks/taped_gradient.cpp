@@ -0,0 +1,90 @@
+#define STAN_SCALAR_OP_TAPE
+#include <benchmark/benchmark.h>
+#include <stan/math/mix.hpp>
+#include <vector>
+
+/**
+ * Gradient of a scalar normal log density of state.range(0)
+ * observations, computed by gradient() and by replaying the program
+ * recorded by taped_gradient, and its Hessian-vector product computed
+ * with fvar<var> by hessian_times_vector() and by forward-over-reverse
+ * replay of the program recorded by taped_hessian.
+ *
+ * Build with `make benchmarks/taped_gradient`.
+ */
+struct normal_lp {
+  Eigen::VectorXd y_;
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& theta) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::square;
+    T mu = theta(0);
+    T sigma = exp(theta(1));
+    T lp = 0;
+    for (Eigen::Index i = 0; i < y_.size(); ++i) {
+      lp -= square((y_(i) - mu) / sigma);
+    }
+    return 0.5 * lp - y_.size() * log(sigma);
+  }
+};
+
+static void gradient(benchmark::State& state) {
+  normal_lp f{Eigen::VectorXd::Random(state.range(0))};
+  Eigen::VectorXd theta = Eigen::VectorXd::Random(2);
+  double fx;
+  Eigen::VectorXd grad_fx;
+  for (auto _ : state) {
+    stan::math::gradient(f, theta, fx, grad_fx);
+    benchmark::DoNotOptimize(grad_fx.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void taped_gradient(benchmark::State& state) {
+  normal_lp f{Eigen::VectorXd::Random(state.range(0))};
+  Eigen::VectorXd theta = Eigen::VectorXd::Random(2);
+  stan::math::taped_gradient<normal_lp> taped(f);
+  double fx;
+  Eigen::VectorXd grad_fx;
+  for (auto _ : state) {
+    taped(theta, fx, grad_fx);
+    benchmark::DoNotOptimize(grad_fx.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void hessian_times_vector(benchmark::State& state) {
+  normal_lp f{Eigen::VectorXd::Random(state.range(0))};
+  Eigen::VectorXd theta = Eigen::VectorXd::Random(2);
+  Eigen::VectorXd v = Eigen::VectorXd::Random(2);
+  double fx;
+  Eigen::VectorXd Hv;
+  for (auto _ : state) {
+    stan::math::hessian_times_vector(f, theta, v, fx, Hv);
+    benchmark::DoNotOptimize(Hv.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void taped_hessian_times_vector(benchmark::State& state) {
+  normal_lp f{Eigen::VectorXd::Random(state.range(0))};
+  Eigen::VectorXd theta = Eigen::VectorXd::Random(2);
+  Eigen::VectorXd v = Eigen::VectorXd::Random(2);
+  stan::math::taped_hessian<normal_lp> taped(f);
+  double fx;
+  Eigen::VectorXd Hv;
+  for (auto _ : state) {
+    taped.hessian_times_vector(theta, v, fx, Hv);
+    benchmark::DoNotOptimize(Hv.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(gradient)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(taped_gradient)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(hessian_times_vector)->RangeMultiplier(8)->Range(1 << 6, 1 << 18);
+BENCHMARK(taped_hessian_times_vector)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 18);
+BENCHMARK_MAIN();
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <stan/math.hpp>
+
+/**
+ * Gradients of multivariate log densities with the matrix arguments
+ * held as `Eigen::Matrix<var, ...>` (matvar) or as
+ * `var_value<Eigen::Matrix<double, ...>>` (varmat).
+ *
+ * Each iteration creates the arguments, evaluates the log density,
+ * runs the reverse pass and recovers the memory.  The counters report
+ * the number of varis on the stack and the arena bytes used by one
+ * evaluation.  state.range(0) is the dimension of the matrices.
+ *
+ * Build with `make benchmarks/varmat_compatibility`.
+ */
+template <typename Mat, typename Vec, typename F>
+static void lpdf_gradient(benchmark::State& state, const F& f,
+                          const Eigen::MatrixXd& L_val,
+                          const Eigen::VectorXd& y_val) {
+  auto& stack = *stan::math::ChainableStack::instance_;
+  double varis = 0;
+  double bytes = 0;
+  for (auto _ : state) {
+    Mat L(L_val);
+    Vec y(y_val);
+    stan::math::var lp = f(L, y);
+    lp.grad();
+    varis = stack.var_stack_.size() + stack.var_nochain_stack_.size();
+    bytes = stack.memalloc_.bytes_used();
+    benchmark::DoNotOptimize(L.adj().data());
+    stan::math::recover_memory();
+  }
+  state.counters["varis"] = varis;
+  state.counters["arena_bytes"] = bytes;
+}
+
+static Eigen::MatrixXd corr_cholesky(int K) {
+  Eigen::VectorXd x = 0.1 * Eigen::VectorXd::Random((K * (K - 1)) / 2);
+  return stan::math::cholesky_corr_constrain(x, K);
+}
+
+template <typename Mat, typename Vec>
+static void lkj_corr_cholesky(benchmark::State& state) {
+  const int K = state.range(0);
+  lpdf_gradient<Mat, Vec>(
+      state,
+      [](const auto& L, const auto& y) {
+        return stan::math::lkj_corr_cholesky_lpdf(L, 2.0);
+      },
+      corr_cholesky(K), Eigen::VectorXd::Random(K));
+}
+
+template <typename Mat, typename Vec>
+static void multi_normal_cholesky(benchmark::State& state) {
+  const int K = state.range(0);
+  lpdf_gradient<Mat, Vec>(
+      state,
+      [](const auto& L, const auto& y) {
+        return stan::math::multi_normal_cholesky_lpdf(y, y * 0.5, L);
+      },
+      corr_cholesky(K), Eigen::VectorXd::Random(K));
+}
+
+template <typename Mat, typename Vec>
+static void wishart_cholesky(benchmark::State& state) {
+  const int K = state.range(0);
+  lpdf_gradient<Mat, Vec>(
+      state,
+      [K](const auto& L, const auto& y) {
+        return stan::math::wishart_cholesky_lpdf(L, K + 1.0, L);
+      },
+      corr_cholesky(K), Eigen::VectorXd::Random(K));
+}
+
+template <typename Mat, typename Vec>
+static void multi_gp_cholesky(benchmark::State& state) {
+  const int K = state.range(0);
+  lpdf_gradient<Mat, Vec>(
+      state,
+      [](const auto& L, const auto& y) {
+        return stan::math::multi_gp_cholesky_lpdf(L, L, stan::math::exp(y));
+      },
+      corr_cholesky(K), Eigen::VectorXd::Random(K));
+}
+
+using matvar_m = Eigen::Matrix<stan::math::var, Eigen::Dynamic, Eigen::Dynamic>;
+using matvar_v = Eigen::Matrix<stan::math::var, Eigen::Dynamic, 1>;
+using varmat_m = stan::math::var_value<Eigen::MatrixXd>;
+using varmat_v = stan::math::var_value<Eigen::VectorXd>;
+
+BENCHMARK_TEMPLATE(lkj_corr_cholesky, matvar_m, matvar_v)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+BENCHMARK_TEMPLATE(lkj_corr_cholesky, varmat_m, varmat_v)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+BENCHMARK_TEMPLATE(multi_normal_cholesky, matvar_m, matvar_v)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+BENCHMARK_TEMPLATE(multi_normal_cholesky, varmat_m, varmat_v)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+BENCHMARK_TEMPLATE(wishart_cholesky, matvar_m, matvar_v)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+BENCHMARK_TEMPLATE(wishart_cholesky, varmat_m, varmat_v)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+BENCHMARK_TEMPLATE(multi_gp_cholesky, matvar_m, matvar_v)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+BENCHMARK_TEMPLATE(multi_gp_cholesky, varmat_m, varmat_v)
+    ->RangeMultiplier(4)
+    ->Range(4, 256);
+BENCHMARK_MAIN();
@@ -0,0 +1,347 @@
+#ifndef STAN_MATH_FWD_CORE_FVAR_MULTI_HPP
+#define STAN_MATH_FWD_CORE_FVAR_MULTI_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <ostream>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+/**
+ * Forward-mode autodiff variable carrying several tangents at once.
+ *
+ * Where an <code>fvar&lt;T&gt;</code> propagates one directional
+ * derivative, an <code>fvar_multi&lt;T, K&gt;</code> propagates
+ * <code>K</code> of them through a single evaluation of a function,
+ * so that a Jacobian or Hessian needs a <code>K</code>-th of the
+ * function evaluations.  The tangents are stored contiguously in an
+ * Eigen array and updated with array expressions, which vectorize for
+ * double values and a fixed number of tangents.
+ *
+ * If <code>K</code> is <code>Eigen::Dynamic</code> the number of
+ * tangents is set at run time.  Constants then have no tangents, which
+ * the operators treat as zero tangents of any size.
+ *
+ * The arithmetic, comparison and unary operators are defined for
+ * <code>fvar_multi</code>, as are <code>exp</code>, <code>log</code>,
+ * <code>sqrt</code>, <code>square</code>, <code>inv</code>,
+ * <code>sin</code>, <code>cos</code>, <code>log1p</code>,
+ * <code>inv_logit</code> and <code>pow</code>, including their
+ * vectorized versions.
+ *
+ * @tparam T type of value and tangents
+ * @tparam K number of tangents
+ */
+template <typename T, int K = Eigen::Dynamic>
+struct fvar_multi {
+  using Scalar = std::decay_t<T>;
+  using tangent_t = Eigen::Array<Scalar, K, 1>;
+
+  /**
+   * The value of this variable.
+   */
+  Scalar val_;
+
+  /**
+   * The tangents of this variable.
+   */
+  tangent_t d_;
+
+  /**
+   * Return the value of this variable.
+   *
+   * @return value of this variable
+   */
+  Scalar val() const { return val_; }
+
+  /**
+   * Return the tangents of this variable.
+   *
+   * @return tangents of this variable
+   */
+  const tangent_t& d() const { return d_; }
+
+  /**
+   * Construct a variable with zero value and zero tangents.
+   */
+  fvar_multi()
+      : val_(0.0), d_(tangent_t::Zero(K == Eigen::Dynamic ? 0 : K)) {}
+
+  /**
+   * Construct a variable with the specified value and zero tangents.
+   *
+   * @tparam V type of value, which must be promotable to <code>T</code>
+   * @param v value
+   */
+  template <typename V, std::enable_if_t<ad_promotable<V, T>::value>* = nullptr,
+            require_not_same_t<V, fvar_multi<T, K>>* = nullptr>
+  fvar_multi(const V& v)  // NOLINT(runtime/explicit)
+      : val_(v), d_(tangent_t::Zero(K == Eigen::Dynamic ? 0 : K)) {}
+
+  /**
+   * Construct a variable with the specified value and tangents.
+   *
+   * @tparam V type of value
+   * @tparam D type of tangents, an Eigen array expression
+   * @param v value
+   * @param d tangents
+   */
+  template <typename V, typename D>
+  fvar_multi(const V& v, const D& d) : val_(v), d_(d) {}
+
+  inline fvar_multi& operator+=(const fvar_multi& x2);
+  inline fvar_multi& operator-=(const fvar_multi& x2);
+  inline fvar_multi& operator*=(const fvar_multi& x2);
+  inline fvar_multi& operator/=(const fvar_multi& x2);
+
+  inline fvar_multi& operator+=(double x2) {
+    val_ += x2;
+    return *this;
+  }
+
+  inline fvar_multi& operator-=(double x2) {
+    val_ -= x2;
+    return *this;
+  }
+
+  inline fvar_multi& operator*=(double x2) {
+    val_ *= x2;
+    d_ *= x2;
+    return *this;
+  }
+
+  inline fvar_multi& operator/=(double x2) {
+    val_ /= x2;
+    d_ /= x2;
+    return *this;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const fvar_multi& v) {
+    return os << v.val_;
+  }
+};
+
+namespace internal {
+
+template <typename T>
+struct is_fvar_multi : std::false_type {};
+
+template <typename T, int K>
+struct is_fvar_multi<fvar_multi<T, K>> : std::true_type {};
+
+template <typename T1, typename T2>
+using require_any_fvar_multi_t = std::enable_if_t<
+    is_fvar_multi<std::decay_t<T1>>::value
+    || is_fvar_multi<std::decay_t<T2>>::value>;
+
+template <typename T>
+inline const T& multi_val(const T& x) {
+  return x;
+}
+
+template <typename T, int K>
+inline const T& multi_val(const fvar_multi<T, K>& x) {
+  return x.val_;
+}
+
+/**
+ * Return the sum of two sets of tangents.  An empty set of a dynamic
+ * number of tangents stands for zero tangents.
+ */
+template <typename Tangent>
+inline Tangent tangent_add(const Tangent& x, const Tangent& y) {
+  if (x.size() == 0) {
+    return y;
+  } else if (y.size() == 0) {
+    return x;
+  }
+  return x + y;
+}
+
+/**
+ * Return the difference of two sets of tangents.  An empty set of a
+ * dynamic number of tangents stands for zero tangents.
+ */
+template <typename Tangent>
+inline Tangent tangent_subtract(const Tangent& x, const Tangent& y) {
+  if (x.size() == 0) {
+    return -y;
+  } else if (y.size() == 0) {
+    return x;
+  }
+  return x - y;
+}
+
+/**
+ * Return the linear combination <code>a * x + b * y</code> of two sets
+ * of tangents.  An empty set of a dynamic number of tangents stands
+ * for zero tangents.
+ */
+template <typename Tangent, typename A, typename B>
+inline Tangent tangent_combine(const A& a, const Tangent& x, const B& b,
+                               const Tangent& y) {
+  if (x.size() == 0) {
+    return y * b;
+  } else if (y.size() == 0) {
+    return x * a;
+  }
+  return x * a + y * b;
+}
+
+}  // namespace internal
+
+template <typename T, int K>
+inline fvar_multi<T, K>& fvar_multi<T, K>::operator+=(const fvar_multi& x2) {
+  val_ += x2.val_;
+  d_ = internal::tangent_add(d_, x2.d_);
+  return *this;
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K>& fvar_multi<T, K>::operator-=(const fvar_multi& x2) {
+  val_ -= x2.val_;
+  d_ = internal::tangent_subtract(d_, x2.d_);
+  return *this;
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K>& fvar_multi<T, K>::operator*=(const fvar_multi& x2) {
+  d_ = internal::tangent_combine(x2.val_, d_, val_, x2.d_);
+  val_ *= x2.val_;
+  return *this;
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K>& fvar_multi<T, K>::operator/=(const fvar_multi& x2) {
+  const T inv_x2 = 1 / x2.val_;
+  d_ = internal::tangent_combine(inv_x2, d_, -val_ * inv_x2 * inv_x2, x2.d_);
+  val_ *= inv_x2;
+  return *this;
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K> operator+(const fvar_multi<T, K>& x1,
+                                  const fvar_multi<T, K>& x2) {
+  return fvar_multi<T, K>(x1.val_ + x2.val_,
+                          internal::tangent_add(x1.d_, x2.d_));
+}
+
+template <typename T, int K, typename V, require_arithmetic_t<V>* = nullptr>
+inline fvar_multi<T, K> operator+(const fvar_multi<T, K>& x1, V x2) {
+  return fvar_multi<T, K>(x1.val_ + x2, x1.d_);
+}
+
+template <typename T, int K, typename V, require_arithmetic_t<V>* = nullptr>
+inline fvar_multi<T, K> operator+(V x1, const fvar_multi<T, K>& x2) {
+  return fvar_multi<T, K>(x1 + x2.val_, x2.d_);
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K> operator-(const fvar_multi<T, K>& x1,
+                                  const fvar_multi<T, K>& x2) {
+  return fvar_multi<T, K>(x1.val_ - x2.val_,
+                          internal::tangent_subtract(x1.d_, x2.d_));
+}
+
+template <typename T, int K, typename V, require_arithmetic_t<V>* = nullptr>
+inline fvar_multi<T, K> operator-(const fvar_multi<T, K>& x1, V x2) {
+  return fvar_multi<T, K>(x1.val_ - x2, x1.d_);
+}
+
+template <typename T, int K, typename V, require_arithmetic_t<V>* = nullptr>
+inline fvar_multi<T, K> operator-(V x1, const fvar_multi<T, K>& x2) {
+  return fvar_multi<T, K>(x1 - x2.val_, -x2.d_);
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K> operator*(const fvar_multi<T, K>& x1,
+                                  const fvar_multi<T, K>& x2) {
+  return fvar_multi<T, K>(
+      x1.val_ * x2.val_,
+      internal::tangent_combine(x2.val_, x1.d_, x1.val_, x2.d_));
+}
+
+template <typename T, int K, typename V, require_arithmetic_t<V>* = nullptr>
+inline fvar_multi<T, K> operator*(const fvar_multi<T, K>& x1, V x2) {
+  return fvar_multi<T, K>(x1.val_ * x2, x1.d_ * x2);
+}
+
+template <typename T, int K, typename V, require_arithmetic_t<V>* = nullptr>
+inline fvar_multi<T, K> operator*(V x1, const fvar_multi<T, K>& x2) {
+  return fvar_multi<T, K>(x1 * x2.val_, x2.d_ * x1);
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K> operator/(const fvar_multi<T, K>& x1,
+                                  const fvar_multi<T, K>& x2) {
+  const T inv_x2 = 1 / x2.val_;
+  const T val = x1.val_ * inv_x2;
+  return fvar_multi<T, K>(
+      val, internal::tangent_combine(inv_x2, x1.d_, -val * inv_x2, x2.d_));
+}
+
+template <typename T, int K, typename V, require_arithmetic_t<V>* = nullptr>
+inline fvar_multi<T, K> operator/(const fvar_multi<T, K>& x1, V x2) {
+  return fvar_multi<T, K>(x1.val_ / x2, x1.d_ / x2);
+}
+
+template <typename T, int K, typename V, require_arithmetic_t<V>* = nullptr>
+inline fvar_multi<T, K> operator/(V x1, const fvar_multi<T, K>& x2) {
+  const T val = x1 / x2.val_;
+  return fvar_multi<T, K>(val, x2.d_ * (-val / x2.val_));
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K> operator-(const fvar_multi<T, K>& x) {
+  return fvar_multi<T, K>(-x.val_, -x.d_);
+}
+
+template <typename T, int K>
+inline fvar_multi<T, K> operator+(const fvar_multi<T, K>& x) {
+  return x;
+}
+
+/**
+ * Comparisons of multi-tangent variables compare their values.
+ */
+template <typename T1, typename T2,
+          internal::require_any_fvar_multi_t<T1, T2>* = nullptr>
+inline bool operator==(const T1& x1, const T2& x2) {
+  return internal::multi_val(x1) == internal::multi_val(x2);
+}
+
+template <typename T1, typename T2,
+          internal::require_any_fvar_multi_t<T1, T2>* = nullptr>
+inline bool operator!=(const T1& x1, const T2& x2) {
+  return internal::multi_val(x1) != internal::multi_val(x2);
+}
+
+template <typename T1, typename T2,
+          internal::require_any_fvar_multi_t<T1, T2>* = nullptr>
+inline bool operator<(const T1& x1, const T2& x2) {
+  return internal::multi_val(x1) < internal::multi_val(x2);
+}
+
+template <typename T1, typename T2,
+          internal::require_any_fvar_multi_t<T1, T2>* = nullptr>
+inline bool operator<=(const T1& x1, const T2& x2) {
+  return internal::multi_val(x1) <= internal::multi_val(x2);
+}
+
+template <typename T1, typename T2,
+          internal::require_any_fvar_multi_t<T1, T2>* = nullptr>
+inline bool operator>(const T1& x1, const T2& x2) {
+  return internal::multi_val(x1) > internal::multi_val(x2);
+}
+
+template <typename T1, typename T2,
+          internal::require_any_fvar_multi_t<T1, T2>* = nullptr>
+inline bool operator>=(const T1& x1, const T2& x2) {
+  return internal::multi_val(x1) >= internal::multi_val(x2);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -216,6 +216,63 @@ struct ScalarBinaryOpTraits<std::complex<stan::math::fvar<T>>,
   using ReturnType = std::complex<stan::math::fvar<T>>;
 };
 
+/**
+ * Numerical traits template override for Eigen for automatic
+ * gradient variables with several tangents.
+ *
+ * @tparam T value and tangent type of autodiff variable
+ * @tparam K number of tangents
+ */
+template <typename T, int K>
+struct NumTraits<stan::math::fvar_multi<T, K>>
+    : GenericNumTraits<stan::math::fvar_multi<T, K>> {
+  enum {
+    RequireInitialization = 1,
+    ReadCost = (K == Dynamic ? 2 : K + 1) * NumTraits<double>::ReadCost,
+    AddCost = (K == Dynamic ? 2 : K + 1) * NumTraits<T>::AddCost,
+    MulCost = (K == Dynamic ? 3 : 2 * K + 1) * NumTraits<T>::MulCost
+              + NumTraits<T>::AddCost
+  };
+
+  /**
+   * Return the number of decimal digits that can be represented
+   * without change.  Delegates to
+   * <code>std::numeric_limits<double>::digits10()</code>.
+   *
+   * @return number of decimal digits that can be represented without
+   * change
+   */
+  static int digits10() { return std::numeric_limits<double>::digits10; }
+};
+
+/**
+ * Traits specialization for Eigen binary operations for multi-tangent
+ * autodiff and `double` arguments.
+ *
+ * @tparam T value and tangent type of autodiff variable
+ * @tparam K number of tangents
+ * @tparam BinaryOp type of binary operation for which traits are
+ * defined
+ */
+template <typename T, int K, typename BinaryOp>
+struct ScalarBinaryOpTraits<stan::math::fvar_multi<T, K>, double, BinaryOp> {
+  using ReturnType = stan::math::fvar_multi<T, K>;
+};
+
+/**
+ * Traits specialization for Eigen binary operations for `double` and
+ * multi-tangent autodiff arguments.
+ *
+ * @tparam T value and tangent type of autodiff variable
+ * @tparam K number of tangents
+ * @tparam BinaryOp type of binary operation for which traits are
+ * defined
+ */
+template <typename T, int K, typename BinaryOp>
+struct ScalarBinaryOpTraits<double, stan::math::fvar_multi<T, K>, BinaryOp> {
+  using ReturnType = stan::math::fvar_multi<T, K>;
+};
+
 namespace internal {
 
 /**
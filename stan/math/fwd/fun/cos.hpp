@@ -17,6 +17,13 @@ inline fvar<T> cos(const fvar<T>& x) {
   return fvar<T>(cos(x.val_), x.d_ * -sin(x.val_));
 }
 
+template <typename T, int K>
+inline fvar_multi<T, K> cos(const fvar_multi<T, K>& x) {
+  using std::cos;
+  using std::sin;
+  return fvar_multi<T, K>(cos(x.val_), x.d_ * -sin(x.val_));
+}
+
 /**
  * Return the cosine of the complex argument.
  *
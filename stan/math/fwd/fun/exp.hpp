@@ -15,6 +15,13 @@ inline fvar<T> exp(const fvar<T>& x) {
   return fvar<T>(exp(x.val_), x.d_ * exp(x.val_));
 }
 
+template <typename T, int K>
+inline fvar_multi<T, K> exp(const fvar_multi<T, K>& x) {
+  using std::exp;
+  const T exp_x = exp(x.val_);
+  return fvar_multi<T, K>(exp_x, x.d_ * exp_x);
+}
+
 /**
  * Return the natural exponentiation (base e) of the specified complex number.
  *
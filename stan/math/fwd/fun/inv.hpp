@@ -12,6 +12,12 @@ template <typename T>
 inline fvar<T> inv(const fvar<T>& x) {
   return fvar<T>(1 / x.val_, -x.d_ / square(x.val_));
 }
+
+template <typename T, int K>
+inline fvar_multi<T, K> inv(const fvar_multi<T, K>& x) {
+  const T inv_x = 1 / x.val_;
+  return fvar_multi<T, K>(inv_x, x.d_ * (-inv_x * inv_x));
+}
 }  // namespace math
 }  // namespace stan
 #endif
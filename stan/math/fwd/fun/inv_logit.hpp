@@ -24,6 +24,13 @@ inline fvar<T> inv_logit(const fvar<T>& x) {
                  x.d_ * inv_logit(x.val_) * (1 - inv_logit(x.val_)));
 }
 
+template <typename T, int K>
+inline fvar_multi<T, K> inv_logit(const fvar_multi<T, K>& x) {
+  const T inv_logit_x = inv_logit(x.val_);
+  return fvar_multi<T, K>(inv_logit_x,
+                          x.d_ * (inv_logit_x * (1 - inv_logit_x)));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
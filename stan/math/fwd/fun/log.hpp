@@ -21,6 +21,15 @@ inline fvar<T> log(const fvar<T>& x) {
   }
 }
 
+template <typename T, int K>
+inline fvar_multi<T, K> log(const fvar_multi<T, K>& x) {
+  using std::log;
+  if (x.val_ < 0.0) {
+    return fvar_multi<T, K>(NOT_A_NUMBER, x.d_ * NOT_A_NUMBER);
+  }
+  return fvar_multi<T, K>(log(x.val_), x.d_ / x.val_);
+}
+
 /**
  * Return the natural logarithm (base e) of the specified complex argument.
  *
@@ -13,6 +13,11 @@ inline fvar<T> log1p(const fvar<T>& x) {
   return fvar<T>(log1p(x.val_), x.d_ / (1 + x.val_));
 }
 
+template <typename T, int K>
+inline fvar_multi<T, K> log1p(const fvar_multi<T, K>& x) {
+  return fvar_multi<T, K>(log1p(x.val_), x.d_ / (1 + x.val_));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -57,6 +57,33 @@ inline fvar<T> pow(const fvar<T>& x1, U x2) {
   return fvar<T>(pow(x1.val_, x2), x1.d_ * x2 * pow(x1.val_, x2 - 1));
 }
 
+template <typename T, int K>
+inline fvar_multi<T, K> pow(const fvar_multi<T, K>& x1,
+                            const fvar_multi<T, K>& x2) {
+  using std::log;
+  using std::pow;
+  const T pow_x1_x2 = pow(x1.val_, x2.val_);
+  return fvar_multi<T, K>(
+      pow_x1_x2,
+      internal::tangent_combine(x2.val_ / x1.val_ * pow_x1_x2, x1.d_,
+                                log(x1.val_) * pow_x1_x2, x2.d_));
+}
+
+template <typename T, int K, typename U, require_arithmetic_t<U>* = nullptr>
+inline fvar_multi<T, K> pow(U x1, const fvar_multi<T, K>& x2) {
+  using std::log;
+  using std::pow;
+  const T u = pow(x1, x2.val_);
+  return fvar_multi<T, K>(u, x2.d_ * (log(x1) * u));
+}
+
+template <typename T, int K, typename U, require_arithmetic_t<U>* = nullptr>
+inline fvar_multi<T, K> pow(const fvar_multi<T, K>& x1, U x2) {
+  using std::pow;
+  return fvar_multi<T, K>(pow(x1.val_, x2),
+                          x1.d_ * (x2 * pow(x1.val_, x2 - 1)));
+}
+
 // must uniquely match all pairs of:
 //    { complex<fvar<V>>, complex<T>, fvar<V>, T }
 // with at least one fvar<V> and at least one complex, where T is arithmetic:
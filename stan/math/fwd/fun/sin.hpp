@@ -17,6 +17,13 @@ inline fvar<T> sin(const fvar<T>& x) {
   return fvar<T>(sin(x.val_), x.d_ * cos(x.val_));
 }
 
+template <typename T, int K>
+inline fvar_multi<T, K> sin(const fvar_multi<T, K>& x) {
+  using std::cos;
+  using std::sin;
+  return fvar_multi<T, K>(sin(x.val_), x.d_ * cos(x.val_));
+}
+
 /**
  * Return the sine of the complex argument.
  *
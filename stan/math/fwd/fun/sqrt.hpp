@@ -19,6 +19,13 @@ inline fvar<T> sqrt(const fvar<T>& x) {
   return fvar<T>(sqrt(x.val_), 0.5 * x.d_ * inv_sqrt(x.val_));
 }
 
+template <typename T, int K>
+inline fvar_multi<T, K> sqrt(const fvar_multi<T, K>& x) {
+  using std::sqrt;
+  const T sqrt_x = sqrt(x.val_);
+  return fvar_multi<T, K>(sqrt_x, x.d_ * (0.5 / sqrt_x));
+}
+
 /**
  * Return the square root of the complex argument.
  *
@@ -12,6 +12,11 @@ template <typename T>
 inline fvar<T> square(const fvar<T>& x) {
   return fvar<T>(square(x.val_), x.d_ * 2 * x.val_);
 }
+
+template <typename T, int K>
+inline fvar_multi<T, K> square(const fvar_multi<T, K>& x) {
+  return fvar_multi<T, K>(square(x.val_), x.d_ * (2 * x.val_));
+}
 }  // namespace math
 }  // namespace stan
 #endif
@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/functor/apply_scalar_unary.hpp>
 #include <stan/math/fwd/core/fvar.hpp>
+#include <stan/math/fwd/core/fvar_multi.hpp>
 
 namespace stan {
 namespace math {
@@ -34,6 +35,35 @@ struct apply_scalar_unary<F, fvar<T> > {
   static inline return_t apply(const fvar<T>& x) { return F::fun(x); }
 };
 
+/**
+ * Template specialization to fvar_multi for vectorizing a unary scalar
+ * function.  This is a base scalar specialization.  It applies the
+ * function specified by the template parameter to the argument.
+ *
+ * @tparam F Type of function to apply.
+ * @tparam T Value and tangent type for for forward-mode
+ * autodiff variable.
+ * @tparam K Number of tangents.
+ */
+template <typename F, typename T, int K>
+struct apply_scalar_unary<F, fvar_multi<T, K> > {
+  /**
+   * Function return type, which is same as the argument type for
+   * the function, <code>fvar_multi&lt;T, K&gt;</code>.
+   */
+  using return_t = fvar_multi<T, K>;
+
+  /**
+   * Apply the function specified by F to the specified argument.
+   *
+   * @param x Argument variable.
+   * @return Function applied to the variable.
+   */
+  static inline return_t apply(const fvar_multi<T, K>& x) {
+    return F::fun(x);
+  }
+};
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -2,7 +2,12 @@
 #define STAN_MATH_FWD_FUNCTOR_JACOBIAN_HPP
 
 #include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <algorithm>
 
 namespace stan {
 namespace math {
@@ -14,14 +19,13 @@ void jacobian(const F& f, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x,
   using Eigen::Dynamic;
   using Eigen::Matrix;
   Matrix<fvar<T>, Dynamic, 1> x_fvar(x.size());
-  J.resize(x_fvar.size(), x.size());
-  fx.resize(x_fvar.size());
   for (int k = 0; k < x.size(); ++k) {
     x_fvar(k) = fvar<T>(x(k), 0);
   }
   x_fvar(0) = fvar<T>(x(0), 1);
   Matrix<fvar<T>, Dynamic, 1> fx_fvar = f(x_fvar);
   fx = fx_fvar.val();
+  J.resize(fx_fvar.size(), x.size());
   J.col(0) = fx_fvar.d();
   const fvar<T> switch_fvar(0, 1);  // flips the tangents on and off
   for (int i = 1; i < x.size(); ++i) {
@@ -32,6 +36,126 @@ void jacobian(const F& f, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x,
   }
 }
 
+/**
+ * Calculate the value and the Jacobian of the specified function at
+ * the specified argument, computing the columns of the Jacobian
+ * concurrently on the TBB thread pool.
+ *
+ * Each column takes one evaluation of the function with a single
+ * tangent, as in the serial <code>jacobian()</code>.  The first column
+ * is computed up front to size the result.  The remaining columns are
+ * split into chunks of at least <code>grainsize</code> columns, each
+ * with its own copy of the argument.  Every column is written by
+ * exactly one chunk, so the result does not depend on the scheduling.
+ * Forward mode with <code>double</code> values does not use the
+ * autodiff stack, so the functor only needs to be safe to call from
+ * several threads at once.
+ *
+ * @tparam F type of function
+ * @param[in] f function
+ * @param[in] x argument to function
+ * @param[out] fx function applied to argument
+ * @param[out] J Jacobian of function at argument
+ * @param[in] grainsize minimum number of columns per chunk
+ * @throw std::domain_error if grainsize is not positive
+ */
+template <typename F>
+void jacobian(const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+              Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+              Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& J,
+              int grainsize) {
+  check_positive("jacobian", "grainsize", grainsize);
+  const Eigen::Index N = x.size();
+  Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> x_fvar(N);
+  for (Eigen::Index k = 0; k < N; ++k) {
+    x_fvar.coeffRef(k) = fvar<double>(x.coeff(k), k == 0);
+  }
+  Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> fx_fvar = f(x_fvar);
+  fx = fx_fvar.val();
+  J.resize(fx_fvar.size(), N);
+  if (N == 0) {
+    return;
+  }
+  J.col(0) = fx_fvar.d();
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(
+        tbb::blocked_range<Eigen::Index>(1, N, grainsize),
+        [&](const tbb::blocked_range<Eigen::Index>& r) {
+          Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> x_local(N);
+          for (Eigen::Index k = 0; k < N; ++k) {
+            x_local.coeffRef(k) = fvar<double>(x.coeff(k), 0);
+          }
+          for (Eigen::Index i = r.begin(); i < r.end(); ++i) {
+            x_local.coeffRef(i).d_ = 1;
+            Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> fx_local
+                = f(x_local);
+            J.col(i) = fx_local.d();
+            x_local.coeffRef(i).d_ = 0;
+          }
+        });
+  });
+}
+
+/**
+ * Calculate the value and the Jacobian of the specified function at
+ * the specified argument, propagating <code>K</code> tangents per
+ * evaluation of the function.
+ *
+ * The columns of the Jacobian are computed in blocks of
+ * <code>K</code>, each with a single evaluation of the function on
+ * <code>fvar_multi&lt;T, K&gt;</code> arguments, so that it needs a
+ * <code>K</code>-th of the evaluations of the single tangent
+ * <code>jacobian()</code>.  The functor must implement
+ *
+ * <code>
+ * Eigen::Matrix\<fvar_multi\<T, K\>, Eigen::Dynamic, 1\>
+ * operator()(const
+ * Eigen::Matrix\<fvar_multi\<T, K\>, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for <code>fvar_multi</code>.
+ *
+ * @tparam K number of tangents per evaluation
+ * @tparam T type of elements of the argument
+ * @tparam F type of function
+ * @param[in] f function
+ * @param[in] x argument to function
+ * @param[out] fx function applied to argument
+ * @param[out] J Jacobian of function at argument
+ */
+template <int K, typename T, typename F>
+void jacobian(const F& f, const Eigen::Matrix<T, Eigen::Dynamic, 1>& x,
+              Eigen::Matrix<T, Eigen::Dynamic, 1>& fx,
+              Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& J) {
+  static_assert(K > 0, "jacobian: the number of tangents must be positive");
+  using fvar_t = fvar_multi<T, K>;
+  using tangent_t = typename fvar_t::tangent_t;
+  const Eigen::Index N = x.size();
+  Eigen::Matrix<fvar_t, Eigen::Dynamic, 1> x_fvar(N);
+  for (Eigen::Index begin = 0; begin == 0 || begin < N; begin += K) {
+    for (Eigen::Index j = 0; j < N; ++j) {
+      x_fvar.coeffRef(j) = fvar_t(x.coeff(j), tangent_t::Zero());
+    }
+    const Eigen::Index block_size = std::min<Eigen::Index>(K, N - begin);
+    for (Eigen::Index k = 0; k < block_size; ++k) {
+      x_fvar.coeffRef(begin + k).d_.coeffRef(k) = 1;
+    }
+    Eigen::Matrix<fvar_t, Eigen::Dynamic, 1> fx_fvar = f(x_fvar);
+    if (begin == 0) {
+      fx.resize(fx_fvar.size());
+      J.resize(fx_fvar.size(), N);
+      for (Eigen::Index i = 0; i < fx_fvar.size(); ++i) {
+        fx.coeffRef(i) = fx_fvar.coeff(i).val_;
+      }
+    }
+    for (Eigen::Index k = 0; k < block_size; ++k) {
+      for (Eigen::Index i = 0; i < fx_fvar.size(); ++i) {
+        J.coeffRef(i, begin + k) = fx_fvar.coeff(i).d_.coeff(k);
+      }
+    }
+  }
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -0,0 +1,83 @@
+#ifndef STAN_MATH_FWD_FUNCTOR_SPARSE_JACOBIAN_HPP
+#define STAN_MATH_FWD_FUNCTOR_SPARSE_JACOBIAN_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/column_coloring.hpp>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Calculate the value and the sparse Jacobian of the specified
+ * function at the specified argument, given the sparsity pattern of
+ * the Jacobian.
+ *
+ * The columns of the pattern are colored so that no two columns of a
+ * color have a nonzero in the same row (see
+ * <code>internal::column_coloring()</code>).  The function is then
+ * evaluated once per color in forward mode, with the tangents of all
+ * arguments of that color set to one, and each nonzero of the Jacobian
+ * is read off the directional derivative of its column's color.  A
+ * banded Jacobian of bandwidth <code>b</code> thus takes
+ * <code>2 * b + 1</code> evaluations instead of one per argument.
+ *
+ * Entries outside of the pattern are taken to be zero.  If the
+ * function depends on an argument through an entry missing from the
+ * pattern the result is wrong.
+ *
+ * @tparam F type of function
+ * @param[in] f function taking and returning an Eigen column vector of
+ * <code>fvar&lt;double&gt;</code>
+ * @param[in] x argument to function
+ * @param[in] pattern sparsity pattern of the Jacobian, whose values are
+ * ignored
+ * @param[out] fx function applied to argument
+ * @param[out] J Jacobian of function at argument, with the nonzeros of
+ * the pattern
+ * @throw std::invalid_argument if the number of columns of the pattern
+ * is not the size of the argument or its number of rows is not the size
+ * of the result
+ */
+template <typename F>
+void sparse_jacobian(const F& f,
+                     const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                     const Eigen::SparseMatrix<double>& pattern,
+                     Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+                     Eigen::SparseMatrix<double>& J) {
+  check_size_match("sparse_jacobian", "columns of pattern", pattern.cols(),
+                   "size of argument", x.size());
+  int num_colors = 0;
+  const std::vector<int> colors = internal::column_coloring(pattern,
+                                                            num_colors);
+  const Eigen::Index N = x.size();
+  Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> x_fvar(N);
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> directional;
+  for (int c = 0; c == 0 || c < num_colors; ++c) {
+    for (Eigen::Index j = 0; j < N; ++j) {
+      x_fvar.coeffRef(j) = fvar<double>(x.coeff(j), colors[j] == c);
+    }
+    Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> fx_fvar = f(x_fvar);
+    if (c == 0) {
+      fx = fx_fvar.val();
+      check_size_match("sparse_jacobian", "rows of pattern", pattern.rows(),
+                       "size of result", fx.size());
+      directional.resize(fx.size(), num_colors);
+    }
+    if (c < num_colors) {
+      directional.col(c) = fx_fvar.d();
+    }
+  }
+  J = pattern;
+  for (Eigen::Index j = 0; j < J.outerSize(); ++j) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(J, j); it; ++it) {
+      it.valueRef() = directional.coeff(it.row(), colors[j]);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,265 @@
+#ifndef STAN_MATH_MEMORY_BLOCK_PROVIDER_HPP
+#define STAN_MATH_MEMORY_BLOCK_PROVIDER_HPP
+
+#include <stdint.h>
+#include <cstdlib>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define STAN_MATH_MEMORY_HAS_MMAP
+#endif
+
+namespace stan {
+namespace math {
+
+namespace internal {
+constexpr size_t DEFAULT_PAGE_NBYTES = 1 << 12;  // 4KB
+constexpr size_t HUGE_PAGE_NBYTES = 1 << 21;     // 2MB
+
+constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+/**
+ * Return a block of the specified number of bytes aligned to
+ * <code>BLOCK_ALIGNMENT</code> bytes, or <code>nullptr</code> if the
+ * allocation fails.  The block must be released with
+ * <code>aligned_block_free()</code>.
+ *
+ * @param size Number of bytes.
+ * @return Pointer to the block.
+ */
+inline char* aligned_block_malloc(size_t size) {
+#ifdef _WIN32
+  return static_cast<char*>(_aligned_malloc(size, BLOCK_ALIGNMENT));
+#else
+  void* ptr = nullptr;
+  if (posix_memalign(&ptr, BLOCK_ALIGNMENT, size) != 0) {
+    return nullptr;
+  }
+  return static_cast<char*>(ptr);
+#endif
+}
+
+/**
+ * Release a block obtained from <code>aligned_block_malloc()</code>.
+ *
+ * @param ptr Pointer to the block.
+ */
+inline void aligned_block_free(char* ptr) {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+/**
+ * Round the specified number of bytes up to the next multiple of
+ * the granularity, which must be non-zero.
+ */
+inline size_t round_up_nbytes(size_t nbytes, size_t granularity) {
+  return ((nbytes + granularity - 1) / granularity) * granularity;
+}
+}  // namespace internal
+
+/**
+ * Policy deciding how large each new block of a <code>stack_alloc</code>
+ * should be.
+ *
+ * A new block holds at least the requested number of bytes and is
+ * <code>growth_factor</code> times the size of the previous block.  All
+ * block sizes are rounded up to a multiple of <code>granularity</code>
+ * bytes, which lets page-based providers hand out whole pages.
+ */
+struct block_size_policy {
+  size_t growth_factor_;
+  size_t granularity_;
+
+  explicit block_size_policy(size_t growth_factor = 2, size_t granularity = 8)
+      : growth_factor_(growth_factor < 1 ? 1 : growth_factor),
+        granularity_(granularity < 1 ? 1 : granularity) {}
+
+  /**
+   * Return the size of a block that can hold the specified number of
+   * bytes.
+   *
+   * @param nbytes Minimum number of bytes.
+   * @return Size of block in bytes.
+   */
+  inline size_t block_size(size_t nbytes) const {
+    return internal::round_up_nbytes(nbytes, granularity_);
+  }
+
+  /**
+   * Return the size of the block following a block of the specified
+   * size which must hold at least <code>len</code> bytes.
+   *
+   * @param last_nbytes Size of the last block in bytes.
+   * @param len Number of bytes which must fit into the new block.
+   * @return Size of the next block in bytes.
+   */
+  inline size_t next_block_size(size_t last_nbytes, size_t len) const {
+    size_t newsize = last_nbytes * growth_factor_;
+    if (newsize < len) {
+      newsize = len;
+    }
+    return block_size(newsize);
+  }
+};
+
+/**
+ * Block provider for <code>stack_alloc</code> which gets its memory
+ * from the C heap, aligned to <code>alignof(std::max_align_t)</code>
+ * bytes.  This is the default provider.
+ *
+ * A block provider must supply <code>allocate(nbytes)</code> returning
+ * an 8-byte aligned block or <code>nullptr</code> on failure,
+ * <code>deallocate(ptr, nbytes)</code> releasing a block obtained from
+ * <code>allocate</code>, and the sizing functions
+ * <code>block_size(nbytes)</code> and
+ * <code>next_block_size(last_nbytes, len)</code>.
+ */
+class malloc_block_provider {
+ private:
+  block_size_policy policy_;
+
+ public:
+  explicit malloc_block_provider(block_size_policy policy = block_size_policy())
+      : policy_(policy) {}
+
+  inline char* allocate(size_t nbytes) {
+    return internal::aligned_block_malloc(nbytes);
+  }
+
+  inline void deallocate(char* ptr, size_t nbytes) {
+    internal::aligned_block_free(ptr);
+  }
+
+  inline size_t block_size(size_t nbytes) const {
+    return policy_.block_size(nbytes);
+  }
+
+  inline size_t next_block_size(size_t last_nbytes, size_t len) const {
+    return policy_.next_block_size(last_nbytes, len);
+  }
+};
+
+/**
+ * Block provider for <code>stack_alloc</code> which maps anonymous
+ * memory directly from the operating system.
+ *
+ * When huge pages are requested the blocks are rounded to a multiple
+ * of 2MB and advised with <code>MADV_HUGEPAGE</code> so that the kernel
+ * can back them with transparent huge pages, which cuts TLB misses on
+ * large tapes.  When pre-faulting is requested every page of a new
+ * block is touched once at allocation time, so that the first reverse
+ * sweep over the block does not pay for page faults.
+ *
+ * On platforms without <code>mmap()</code> this provider falls back to
+ * <code>malloc()</code>.
+ */
+class mmap_block_provider {
+ private:
+  bool huge_pages_;
+  bool prefault_;
+  block_size_policy policy_;
+
+  inline void prefault(char* ptr, size_t nbytes) {
+    for (size_t i = 0; i < nbytes; i += internal::DEFAULT_PAGE_NBYTES) {
+      ptr[i] = 0;
+    }
+  }
+
+ public:
+  /**
+   * Construct a provider.
+   *
+   * @param huge_pages If true, advise the kernel to use transparent
+   * huge pages for the blocks.
+   * @param prefault If true, touch all pages of a block when it is
+   * allocated.
+   * @param growth_factor Each new block is this many times larger than
+   * the previous one.
+   */
+  explicit mmap_block_provider(bool huge_pages = true, bool prefault = false,
+                               size_t growth_factor = 2)
+      : huge_pages_(huge_pages),
+        prefault_(prefault),
+        policy_(growth_factor, huge_pages ? internal::HUGE_PAGE_NBYTES
+                                          : internal::DEFAULT_PAGE_NBYTES) {}
+
+  inline char* allocate(size_t nbytes) {
+#ifdef STAN_MATH_MEMORY_HAS_MMAP
+    void* ptr = mmap(nullptr, nbytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+      return nullptr;
+    }
+    char* block = static_cast<char*>(ptr);
+#ifdef MADV_HUGEPAGE
+    if (huge_pages_) {
+      // advisory only, failure just means regular pages are used
+      madvise(ptr, nbytes, MADV_HUGEPAGE);
+    }
+#endif
+#else
+    char* block = internal::aligned_block_malloc(nbytes);
+    if (!block) {
+      return block;
+    }
+#endif
+    if (prefault_) {
+      prefault(block, nbytes);
+    }
+    return block;
+  }
+
+  inline void deallocate(char* ptr, size_t nbytes) {
+#ifdef STAN_MATH_MEMORY_HAS_MMAP
+    munmap(ptr, nbytes);
+#else
+    internal::aligned_block_free(ptr);
+#endif
+  }
+
+  inline size_t block_size(size_t nbytes) const {
+    return policy_.block_size(nbytes);
+  }
+
+  inline size_t next_block_size(size_t last_nbytes, size_t len) const {
+    return policy_.next_block_size(last_nbytes, len);
+  }
+
+  inline bool huge_pages() const { return huge_pages_; }
+  inline bool prefaults() const { return prefault_; }
+};
+
+/**
+ * Block provider used by the autodiff arena.  Defining
+ * <code>STAN_ARENA_HUGEPAGES</code> switches the arena to
+ * <code>mmap_block_provider</code> with transparent huge pages, and
+ * additionally defining <code>STAN_ARENA_PREFAULT</code> pre-faults
+ * every block.  Both macros change the type of the arena allocator,
+ * so each must be defined for all or none of the translation units
+ * of a program.
+ */
+#ifdef STAN_ARENA_HUGEPAGES
+struct default_block_provider : public mmap_block_provider {
+#ifdef STAN_ARENA_PREFAULT
+  default_block_provider() : mmap_block_provider(true, true) {}
+#else
+  default_block_provider() : mmap_block_provider(true, false) {}
+#endif
+};
+#else
+using default_block_provider = malloc_block_provider;
+#endif
+
+}  // namespace math
+}  // namespace stan
+#endif
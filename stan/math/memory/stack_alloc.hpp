@@ -5,6 +5,7 @@
 //            is best we can do to get safe pointer casts to uints.
 #include <stdint.h>
 #include <stan/math/prim/meta.hpp>
+#include <stan/math/memory/block_provider.hpp>
 #include <cstdlib>
 #include <cstddef>
 #include <sstream>
@@ -32,22 +33,6 @@ bool is_aligned(T* ptr, unsigned int bytes_aligned) {
 
 namespace internal {
 const size_t DEFAULT_INITIAL_NBYTES = 1 << 16;  // 64KB
-
-// FIXME: enforce alignment
-// big fun to inline, but only called twice
-inline char* eight_byte_aligned_malloc(size_t size) {
-  char* ptr = static_cast<char*>(malloc(size));
-  if (!ptr) {
-    return ptr;  // malloc failed to alloc
-  }
-  if (!is_aligned(ptr, 8U)) {
-    std::stringstream s;
-    s << "invalid alignment to 8 bytes, ptr="
-      << reinterpret_cast<uintptr_t>(ptr) << std::endl;
-    throw std::runtime_error(s.str());
-  }
-  return ptr;
-}
 }  // namespace internal
 
 /**
@@ -68,9 +53,18 @@ inline char* eight_byte_aligned_malloc(size_t size) {
  * and after that it's up to the caller.  On 64-bit architectures,
  * all struct values should be padded to 8-byte boundaries if they
  * contain an 8-byte member or a virtual function.
+ *
+ * The blocks themselves are obtained from the block provider, which
+ * also decides how large each new block is; see
+ * <code>malloc_block_provider</code> and
+ * <code>mmap_block_provider</code>.
+ *
+ * @tparam BlockProvider type supplying and releasing memory blocks
  */
-class stack_alloc {
+template <typename BlockProvider>
+class basic_stack_alloc {
  private:
+  BlockProvider provider_;
   std::vector<char*> blocks_;  // storage for blocks,
                                // may be bigger than cur_block_
   std::vector<size_t> sizes_;  // could store initial & shift for others
@@ -82,6 +76,9 @@ class stack_alloc {
   std::vector<size_t> nested_cur_blocks_;
   std::vector<char*> nested_next_locs_;
   std::vector<char*> nested_cur_block_ends_;
+  size_t peak_bytes_used_;  // high-water mark of nested recoveries
+  size_t initial_nbytes_;   // size of the first block
+  size_t num_block_allocations_;  // blocks requested from provider_
 
   /**
    * Moves us to the next block of memory, allocating that block
@@ -100,12 +97,11 @@ class stack_alloc {
     }
     // Allocate a new block if necessary.
     if (unlikely(cur_block_ >= blocks_.size())) {
-      // New block should be max(2*size of last block, len) bytes.
-      size_t newsize = sizes_.back() * 2;
-      if (newsize < len) {
-        newsize = len;
-      }
-      blocks_.push_back(internal::eight_byte_aligned_malloc(newsize));
+      // New block should be max(2*size of last block, len) bytes,
+      // subject to the provider's size policy.
+      size_t newsize = provider_.next_block_size(sizes_.back(), len);
+      blocks_.push_back(provider_.allocate(newsize));
+      ++num_block_allocations_;
       if (!blocks_.back()) {
         throw std::bad_alloc();
       }
@@ -118,6 +114,31 @@ class stack_alloc {
     return result;
   }
 
+  /**
+   * Free all blocks and replace them by a single block of the
+   * specified size.
+   *
+   * @param nbytes Size of the new block.
+   * @throws std::bad_alloc if the block can not be allocated
+   */
+  void replace_blocks(size_t nbytes) {
+    for (size_t i = 0; i < blocks_.size(); ++i) {
+      if (blocks_[i]) {
+        provider_.deallocate(blocks_[i], sizes_[i]);
+      }
+    }
+    blocks_.resize(1);
+    sizes_.resize(1);
+    blocks_[0] = provider_.allocate(nbytes);
+    ++num_block_allocations_;
+    sizes_[0] = blocks_[0] ? nbytes : 0;
+    recover_all();
+    peak_bytes_used_ = 0;
+    if (!blocks_[0]) {
+      throw std::bad_alloc();
+    }
+  }
+
  public:
   /**
    * Construct a resizable stack allocator initially holding the
@@ -125,15 +146,21 @@ class stack_alloc {
    *
    * @param initial_nbytes Initial number of bytes for the
    * allocator.  Defaults to <code>(1 << 16) = 64KB</code> initial bytes.
-   * @throws std::runtime_error if the underlying malloc is not 8-byte
-   * aligned.
+   * @param provider Provider of the memory blocks.
+   * @throws std::bad_alloc if the initial block cannot be allocated.
    */
-  explicit stack_alloc(size_t initial_nbytes = internal::DEFAULT_INITIAL_NBYTES)
-      : blocks_(1, internal::eight_byte_aligned_malloc(initial_nbytes)),
-        sizes_(1, initial_nbytes),
+  explicit basic_stack_alloc(
+      size_t initial_nbytes = internal::DEFAULT_INITIAL_NBYTES,
+      BlockProvider provider = BlockProvider())
+      : provider_(provider),
+        blocks_(1, provider_.allocate(provider_.block_size(initial_nbytes))),
+        sizes_(1, provider_.block_size(initial_nbytes)),
         cur_block_(0),
-        cur_block_end_(blocks_[0] + initial_nbytes),
-        next_loc_(blocks_[0]) {
+        cur_block_end_(blocks_[0] + sizes_[0]),
+        next_loc_(blocks_[0]),
+        peak_bytes_used_(0),
+        initial_nbytes_(sizes_[0]),
+        num_block_allocations_(1) {
     if (!blocks_[0]) {
       throw std::bad_alloc();  // no msg allowed in bad_alloc ctor
     }
@@ -145,11 +172,11 @@ class stack_alloc {
    * This is implemented as a no-op as there is no destruction
    * required.
    */
-  ~stack_alloc() {
+  ~basic_stack_alloc() {
     // free ALL blocks
-    for (auto& block : blocks_) {
-      if (block) {
-        free(block);
+    for (size_t i = 0; i < blocks_.size(); ++i) {
+      if (blocks_[i]) {
+        provider_.deallocate(blocks_[i], sizes_[i]);
       }
     }
   }
@@ -220,6 +247,8 @@ class stack_alloc {
       recover_all();
     }
 
+    peak_bytes_used_ = peak_bytes_used();
+
     cur_block_ = nested_cur_blocks_.back();
     nested_cur_blocks_.pop_back();
 
@@ -232,19 +261,26 @@ class stack_alloc {
 
   /**
    * Free all memory used by the stack allocator other than the
-   * initial block allocation back to the system.  Note:  the
+   * initial block allocation back to the system.  If the blocks have
+   * been coalesced, the single block is replaced by a block of the
+   * initial size.  Note:  the
    * destructor will free all memory.
    */
   inline void free_all() {
     // frees all BUT the first (index 0) block
     for (size_t i = 1; i < blocks_.size(); ++i) {
       if (blocks_[i]) {
-        free(blocks_[i]);
+        provider_.deallocate(blocks_[i], sizes_[i]);
       }
     }
     sizes_.resize(1);
     blocks_.resize(1);
     recover_all();
+    peak_bytes_used_ = 0;
+    // a block made by coalesce() is replaced by one of initial size
+    if (sizes_[0] != initial_nbytes_) {
+      replace_blocks(initial_nbytes_);
+    }
   }
 
   /**
@@ -265,6 +301,88 @@ class stack_alloc {
     return sum;
   }
 
+  /**
+   * Return the number of bytes currently in use.  This counts the
+   * unused space at the end of the blocks before the current block,
+   * so it is the size of a single block which would have held all
+   * allocations made so far.
+   *
+   * @return number of bytes in use
+   */
+  inline size_t bytes_used() const {
+    size_t sum = next_loc_ - blocks_[cur_block_];
+    for (size_t i = 0; i < cur_block_; ++i) {
+      sum += sizes_[i];
+    }
+    return sum;
+  }
+
+  /**
+   * Return the largest number of bytes in use since construction or
+   * the last call to <code>reset_peak_bytes_used()</code>, taking
+   * into account memory recovered by <code>recover_nested()</code>.
+   *
+   * @return peak number of bytes in use
+   */
+  inline size_t peak_bytes_used() const {
+    size_t used = bytes_used();
+    return used > peak_bytes_used_ ? used : peak_bytes_used_;
+  }
+
+  /**
+   * Reset the peak number of bytes in use to the current number.
+   */
+  inline void reset_peak_bytes_used() { peak_bytes_used_ = bytes_used(); }
+
+  /**
+   * Return the number of blocks held by this allocator.
+   *
+   * @return number of blocks
+   */
+  inline size_t num_blocks() const { return blocks_.size(); }
+
+  /**
+   * Return the number of blocks requested from the block provider
+   * since construction, including blocks which have since been freed.
+   * Each is a heap allocation or a memory mapping.
+   *
+   * @return number of block allocations
+   */
+  inline size_t num_block_allocations() const {
+    return num_block_allocations_;
+  }
+
+  /**
+   * Return true if there is an active nested allocation which was
+   * started on an empty allocator, so that recovering it recovers
+   * all memory.
+   *
+   * @return true if the only nested allocation started on an empty
+   * allocator
+   */
+  inline bool nested_starts_empty() const {
+    return nested_cur_blocks_.size() == 1 && nested_cur_blocks_[0] == 0
+           && nested_next_locs_[0] == blocks_[0];
+  }
+
+  /**
+   * Replace all blocks by a single block holding at least the specified
+   * number of bytes.  Nothing is done if there already is a single
+   * block of at least that size.
+   *
+   * All memory must have been recovered and there must be no nested
+   * allocations when this is called.
+   *
+   * @param nbytes Minimum number of bytes of the single block.
+   * @throws std::bad_alloc if the block can not be allocated
+   */
+  inline void coalesce(size_t nbytes) {
+    if (blocks_.size() == 1 && sizes_[0] >= nbytes) {
+      return;
+    }
+    replace_blocks(provider_.block_size(nbytes));
+  }
+
   /**
    * Indicates whether the memory in the pointer
    * is in the stack.
@@ -284,8 +402,21 @@ class stack_alloc {
     }
     return false;
   }
+
+  /**
+   * Return the block provider of this allocator.
+   *
+   * @return block provider
+   */
+  inline const BlockProvider& provider() const { return provider_; }
 };
 
+/**
+ * The stack allocator used by the autodiff arena.  The block provider
+ * is selected at compile time, see <code>default_block_provider</code>.
+ */
+using stack_alloc = basic_stack_alloc<default_block_provider>;
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -10,5 +10,7 @@
 #include <stan/math/mix/functor/hessian.hpp>
 #include <stan/math/mix/functor/hessian_times_vector.hpp>
 #include <stan/math/mix/functor/partial_derivative.hpp>
+#include <stan/math/mix/functor/sparse_hessian.hpp>
+#include <stan/math/mix/functor/taped_hessian.hpp>
 
 #endif
@@ -2,13 +2,62 @@
 #define STAN_MATH_MIX_FUNCTOR_HESSIAN_HPP
 
 #include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/nested_parallel_for.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <stdexcept>
 
 namespace stan {
 namespace math {
 
+namespace internal {
+
+/**
+ * Calculate the specified rows of the Hessian and elements of the
+ * gradient of the specified function, with one forward and one reverse
+ * pass per row in a nested autodiff stack.  The value of the function
+ * is set by the first row.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument, if <code>start</code>
+ * is zero
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument
+ * @param[in] start first row
+ * @param[in] end one past the last row
+ */
+template <typename F>
+void hessian_rows(const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                  double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+                  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& H,
+                  Eigen::Index start, Eigen::Index end) {
+  for (Eigen::Index i = start; i < end; ++i) {
+    // Run nested autodiff in this scope
+    nested_rev_autodiff nested;
+
+    Eigen::Matrix<fvar<var>, Eigen::Dynamic, 1> x_fvar(x.size());
+    for (int j = 0; j < x.size(); ++j) {
+      x_fvar(j) = fvar<var>(x(j), i == j);
+    }
+    fvar<var> fx_fvar = f(x_fvar);
+    grad(i) = fx_fvar.d_.val();
+    if (i == 0) {
+      fx = fx_fvar.val_.val();
+    }
+    stan::math::grad(fx_fvar.d_.vi_);
+    for (int j = 0; j < x.size(); ++j) {
+      H(i, j) = x_fvar(j).val_.adj();
+    }
+  }
+}
+
+}  // namespace internal
+
 /**
  * Calculate the value, the gradient, and the Hessian,
  * of the specified function at the specified argument in
@@ -50,22 +99,124 @@ void hessian(const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
     fx = f(x);
     return;
   }
-  for (int i = 0; i < x.size(); ++i) {
+  internal::hessian_rows(f, x, fx, grad, H, 0, x.size());
+}
+
+/**
+ * Calculate the value, the gradient, and the Hessian of the specified
+ * function at the specified argument, computing the rows of the
+ * Hessian concurrently on the TBB thread pool.
+ *
+ * Each row takes one forward and one reverse pass as in the serial
+ * <code>hessian()</code>.  The rows are split into chunks of at least
+ * <code>grainsize</code> rows by <code>internal::nested_parallel_for</code>,
+ * which computes them serially unless <code>STAN_THREADS</code> is
+ * defined.  Every row is written by exactly one chunk, so the result
+ * does not depend on the scheduling.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument
+ * @param[in] grainsize minimum number of rows per chunk
+ * @throw std::domain_error if grainsize is not positive
+ */
+template <typename F>
+void hessian(const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+             double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+             Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& H,
+             int grainsize) {
+  check_positive("hessian", "grainsize", grainsize);
+  H.resize(x.size(), x.size());
+  grad.resize(x.size());
+
+  // need to compute fx even with size = 0
+  if (x.size() == 0) {
+    fx = f(x);
+    return;
+  }
+  internal::nested_parallel_for(
+      x.size(), grainsize, [&](std::size_t start, std::size_t end) {
+        internal::hessian_rows(f, x, fx, grad, H, start, end);
+      });
+}
+
+/**
+ * Calculate the value, the gradient, and the Hessian of the specified
+ * function at the specified argument, propagating <code>K</code>
+ * tangents per evaluation of the function.
+ *
+ * The rows of the Hessian are computed in blocks of <code>K</code>.
+ * Each block takes a single evaluation of the function on
+ * <code>fvar_multi&lt;var, K&gt;</code> arguments, followed by one
+ * reverse pass per tangent over the nested tape, so that it needs a
+ * <code>K</code>-th of the function evaluations of the single tangent
+ * <code>hessian()</code>.  As each reverse pass runs over the tangents
+ * of the whole block, this only pays off if evaluating the function
+ * costs more than its tape, for instance when much of the function
+ * does not depend on the argument.  The functor must implement
+ *
+ * <code>
+ * fvar_multi\<var, K\>
+ * operator()(const
+ * Eigen::Matrix\<fvar_multi\<var, K\>, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for <code>fvar_multi</code>
+ * and <code>var</code>.
+ *
+ * @tparam K number of tangents per evaluation
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[out] fx Function applied to argument
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument
+ */
+template <int K, typename F>
+void hessian(const F& f, const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+             double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+             Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& H) {
+  static_assert(K > 0, "hessian: the number of tangents must be positive");
+  using fvar_t = fvar_multi<var, K>;
+  using tangent_t = typename fvar_t::tangent_t;
+  const Eigen::Index N = x.size();
+  H.resize(N, N);
+  grad.resize(N);
+
+  // need to compute fx even with size = 0
+  if (N == 0) {
+    fx = f(x);
+    return;
+  }
+  for (Eigen::Index begin = 0; begin < N; begin += K) {
     // Run nested autodiff in this scope
     nested_rev_autodiff nested;
 
-    Eigen::Matrix<fvar<var>, Eigen::Dynamic, 1> x_fvar(x.size());
-    for (int j = 0; j < x.size(); ++j) {
-      x_fvar(j) = fvar<var>(x(j), i == j);
+    Eigen::Matrix<fvar_t, Eigen::Dynamic, 1> x_fvar(N);
+    const Eigen::Index block_size = std::min<Eigen::Index>(K, N - begin);
+    for (Eigen::Index j = 0; j < N; ++j) {
+      tangent_t d = tangent_t::Zero();
+      if (j >= begin && j < begin + block_size) {
+        d.coeffRef(j - begin) = 1;
+      }
+      x_fvar.coeffRef(j) = fvar_t(x.coeff(j), d);
     }
-    fvar<var> fx_fvar = f(x_fvar);
-    grad(i) = fx_fvar.d_.val();
-    if (i == 0) {
+    fvar_t fx_fvar = f(x_fvar);
+    if (begin == 0) {
       fx = fx_fvar.val_.val();
     }
-    stan::math::grad(fx_fvar.d_.vi_);
-    for (int j = 0; j < x.size(); ++j) {
-      H(i, j) = x_fvar(j).val_.adj();
+    for (Eigen::Index k = 0; k < block_size; ++k) {
+      if (k > 0) {
+        nested.set_zero_all_adjoints();
+      }
+      grad.coeffRef(begin + k) = fx_fvar.d_.coeff(k).val();
+      stan::math::grad(fx_fvar.d_.coeff(k).vi_);
+      for (Eigen::Index j = 0; j < N; ++j) {
+        H.coeffRef(begin + k, j) = x_fvar.coeff(j).val_.adj();
+      }
     }
   }
 }
@@ -0,0 +1,118 @@
+#ifndef STAN_MATH_MIX_FUNCTOR_SPARSE_HESSIAN_HPP
+#define STAN_MATH_MIX_FUNCTOR_SPARSE_HESSIAN_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/column_coloring.hpp>
+#include <stan/math/rev/core.hpp>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Calculate the value, the gradient, and the sparse Hessian of the
+ * specified function at the specified argument, given the sparsity
+ * pattern of the Hessian.
+ *
+ * The pattern is symmetrized and its diagonal added.  Its columns are
+ * then colored so that no two columns of a color have a nonzero in the
+ * same row (see <code>internal::column_coloring()</code>), and each
+ * color takes one forward-over-reverse pass as in
+ * <code>hessian()</code>, with the tangents of all arguments of that
+ * color set to one.  The pass yields the product of the Hessian with
+ * the sum of the unit vectors of the color, from which each nonzero of
+ * the Hessian is read off.  A banded Hessian of bandwidth
+ * <code>b</code> thus takes <code>2 * b + 1</code> passes instead of
+ * one per argument, for instance three for a tridiagonal Hessian.  The
+ * gradient takes one more reverse pass.
+ *
+ * Entries outside of the pattern are taken to be zero.  If the Hessian
+ * has a nonzero missing from the pattern the result is wrong.
+ *
+ * The functor must implement
+ *
+ * <code>
+ * fvar\<var\>
+ * operator()(const
+ * Eigen::Matrix\<fvar\<var\>, Eigen::Dynamic, 1\>&)
+ * </code>
+ *
+ * using only operations that are defined for
+ * <code>fvar</code> and <code>var</code>.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] x Argument to function
+ * @param[in] pattern sparsity pattern of the Hessian, whose values are
+ * ignored
+ * @param[out] fx Function applied to argument
+ * @param[out] grad gradient of function at argument
+ * @param[out] H Hessian of function at argument, with the nonzeros of
+ * the symmetrized pattern and the diagonal
+ * @throw std::invalid_argument if the pattern is not square with the
+ * size of the argument
+ */
+template <typename F>
+void sparse_hessian(const F& f,
+                    const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                    const Eigen::SparseMatrix<double>& pattern, double& fx,
+                    Eigen::Matrix<double, Eigen::Dynamic, 1>& grad,
+                    Eigen::SparseMatrix<double>& H) {
+  check_size_match("sparse_hessian", "rows of pattern", pattern.rows(),
+                   "size of argument", x.size());
+  check_size_match("sparse_hessian", "columns of pattern", pattern.cols(),
+                   "size of argument", x.size());
+  const Eigen::Index N = x.size();
+  grad.resize(N);
+  // need to compute fx even with size = 0
+  if (N == 0) {
+    fx = f(x);
+    H.resize(0, 0);
+    return;
+  }
+  Eigen::SparseMatrix<double> identity(N, N);
+  identity.setIdentity();
+  const Eigen::SparseMatrix<double> abs_pattern = pattern.cwiseAbs();
+  Eigen::SparseMatrix<double> full_pattern
+      = abs_pattern + Eigen::SparseMatrix<double>(abs_pattern.transpose())
+        + identity;
+  int num_colors = 0;
+  const std::vector<int> colors
+      = internal::column_coloring(full_pattern, num_colors);
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> directional(
+      N, num_colors);
+  for (int c = 0; c < num_colors; ++c) {
+    // Run nested autodiff in this scope
+    nested_rev_autodiff nested;
+
+    Eigen::Matrix<fvar<var>, Eigen::Dynamic, 1> x_fvar(N);
+    for (Eigen::Index j = 0; j < N; ++j) {
+      x_fvar.coeffRef(j) = fvar<var>(x.coeff(j), colors[j] == c);
+    }
+    fvar<var> fx_fvar = f(x_fvar);
+    stan::math::grad(fx_fvar.d_.vi_);
+    for (Eigen::Index j = 0; j < N; ++j) {
+      directional.coeffRef(j, c) = x_fvar.coeff(j).val_.adj();
+    }
+    if (c == 0) {
+      fx = fx_fvar.val_.val();
+      nested.set_zero_all_adjoints();
+      stan::math::grad(fx_fvar.val_.vi_);
+      for (Eigen::Index j = 0; j < N; ++j) {
+        grad.coeffRef(j) = x_fvar.coeff(j).val_.adj();
+      }
+    }
+  }
+  H = full_pattern;
+  for (Eigen::Index j = 0; j < H.outerSize(); ++j) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(H, j); it; ++it) {
+      it.valueRef() = directional.coeff(it.row(), colors[j]);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
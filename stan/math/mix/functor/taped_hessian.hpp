@@ -0,0 +1,272 @@
+#ifndef STAN_MATH_MIX_FUNCTOR_TAPED_HESSIAN_HPP
+#define STAN_MATH_MIX_FUNCTOR_TAPED_HESSIAN_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/taped_gradient.hpp>
+#include <stan/math/mix/functor/hessian_times_vector.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/err.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Taped gradient functor which also computes Hessian-vector products,
+ * with a fast path for functions whose recording can be replayed.
+ *
+ * For a replayable function (see <code>taped_gradient</code>) the
+ * adjoint sweep of the recorded program is differentiated in the
+ * direction of the vector, forward-over-reverse on the doubles of the
+ * program: the forward sweep carries the directional derivatives of
+ * all values and the reverse sweep those of all adjoints.  This needs
+ * neither <code>fvar</code> nor an autodiff stack and costs a few
+ * replayed gradients.  It covers only scalar functions made of the
+ * operations on the scalar operation tape, and only if
+ * <code>STAN_SCALAR_OP_TAPE</code> is defined.  All other functions,
+ * including those with <code>var_value</code> matrices, and every
+ * function in a build without the macro, get the product from
+ * <code>hessian_times_vector()</code> with <code>fvar&lt;var&gt;</code>,
+ * so the functor must also be callable with
+ * <code>Eigen::Matrix&lt;fvar&lt;var&gt;, -1, 1&gt;</code>.
+ *
+ * @tparam F Type of function
+ */
+template <typename F>
+class taped_hessian : public taped_gradient<F> {
+ private:
+  using base_t = taped_gradient<F>;
+  using typename base_t::op;
+  using base_t::adjs_;
+  using base_t::f_;
+  using base_t::forward;
+  using base_t::num_inputs_;
+  using base_t::num_replays_;
+  using base_t::ops_;
+  using base_t::output_;
+  using base_t::record;
+  using base_t::recorded_;
+  using base_t::vals_;
+
+  std::vector<double> dvals_;
+  std::vector<double> dadjs_;
+
+  /**
+   * Propagate the tangents of the inputs in the specified direction
+   * through the program.  Must follow <code>forward()</code>.
+   */
+  void forward_tangent(const Eigen::Matrix<double, Eigen::Dynamic, 1>& v) {
+    dvals_.assign(vals_.size(), 0.0);
+    for (Eigen::Index i = 0; i < num_inputs_; ++i) {
+      dvals_[i] = v.coeff(i);
+    }
+    using internal::scalar_op;
+    for (const auto& o : ops_) {
+      const double a = vals_[o.a_];
+      const double da = dvals_[o.a_];
+      const double res = vals_[o.res_];
+      double& dres = dvals_[o.res_];
+      switch (o.op_) {
+        case scalar_op::add_vv:
+          dres = da + dvals_[o.b_.slot_];
+          break;
+        case scalar_op::add_vd:
+        case scalar_op::subtract_vd:
+          dres = da;
+          break;
+        case scalar_op::subtract_vv:
+          dres = da - dvals_[o.b_.slot_];
+          break;
+        case scalar_op::subtract_dv:
+        case scalar_op::negate_v:
+          dres = -da;
+          break;
+        case scalar_op::multiply_vv:
+          dres = da * vals_[o.b_.slot_] + a * dvals_[o.b_.slot_];
+          break;
+        case scalar_op::multiply_vd:
+          dres = da * o.b_.d_;
+          break;
+        case scalar_op::divide_vv:
+          dres = (da - res * dvals_[o.b_.slot_]) / vals_[o.b_.slot_];
+          break;
+        case scalar_op::divide_vd:
+          dres = da / o.b_.d_;
+          break;
+        case scalar_op::divide_dv:
+          dres = -res * da / a;
+          break;
+        case scalar_op::exp_v:
+          dres = res * da;
+          break;
+        case scalar_op::log_v:
+          dres = da / a;
+          break;
+        case scalar_op::sqrt_v:
+          dres = da / (2.0 * res);
+          break;
+        case scalar_op::square_v:
+          dres = 2.0 * a * da;
+          break;
+      }
+    }
+  }
+
+  /**
+   * Propagate the adjoints of the program from the output back to the
+   * inputs together with their tangents, the derivatives of the
+   * adjoints in the direction given to <code>forward_tangent()</code>.
+   * The tangents of the adjoints of the inputs are the product of the
+   * Hessian with that direction.
+   */
+  void reverse_tangent() {
+    std::fill(adjs_.begin(), adjs_.end(), 0.0);
+    dadjs_.assign(vals_.size(), 0.0);
+    adjs_[output_] = 1.0;
+    using internal::scalar_op;
+    for (size_t i = ops_.size(); i-- > 0;) {
+      const op& o = ops_[i];
+      const double adj = adjs_[o.res_];
+      const double dadj = dadjs_[o.res_];
+      const double a = vals_[o.a_];
+      const double da = dvals_[o.a_];
+      double& a_adj = adjs_[o.a_];
+      double& a_dadj = dadjs_[o.a_];
+      switch (o.op_) {
+        case scalar_op::add_vv:
+          a_adj += adj;
+          a_dadj += dadj;
+          adjs_[o.b_.slot_] += adj;
+          dadjs_[o.b_.slot_] += dadj;
+          break;
+        case scalar_op::add_vd:
+        case scalar_op::subtract_vd:
+          a_adj += adj;
+          a_dadj += dadj;
+          break;
+        case scalar_op::subtract_vv:
+          a_adj += adj;
+          a_dadj += dadj;
+          adjs_[o.b_.slot_] -= adj;
+          dadjs_[o.b_.slot_] -= dadj;
+          break;
+        case scalar_op::subtract_dv:
+        case scalar_op::negate_v:
+          a_adj -= adj;
+          a_dadj -= dadj;
+          break;
+        case scalar_op::multiply_vv: {
+          const double b = vals_[o.b_.slot_];
+          const double db = dvals_[o.b_.slot_];
+          a_adj += b * adj;
+          a_dadj += db * adj + b * dadj;
+          adjs_[o.b_.slot_] += a * adj;
+          dadjs_[o.b_.slot_] += da * adj + a * dadj;
+          break;
+        }
+        case scalar_op::multiply_vd:
+          a_adj += adj * o.b_.d_;
+          a_dadj += dadj * o.b_.d_;
+          break;
+        case scalar_op::divide_vv: {
+          const double b = vals_[o.b_.slot_];
+          const double db = dvals_[o.b_.slot_];
+          const double res = vals_[o.res_];
+          const double dres = dvals_[o.res_];
+          // d(a / b) / da = 1 / b and d(a / b) / db = -res / b
+          a_adj += adj / b;
+          a_dadj += (dadj - adj * db / b) / b;
+          adjs_[o.b_.slot_] -= adj * res / b;
+          dadjs_[o.b_.slot_]
+              -= (dadj * res + adj * dres - adj * res * db / b) / b;
+          break;
+        }
+        case scalar_op::divide_vd:
+          a_adj += adj / o.b_.d_;
+          a_dadj += dadj / o.b_.d_;
+          break;
+        case scalar_op::divide_dv: {
+          // d(c / a) / da = -c / a^2 = -res / a
+          const double res = vals_[o.res_];
+          const double dres = dvals_[o.res_];
+          a_adj -= adj * res / a;
+          a_dadj -= (dadj * res + adj * dres - adj * res * da / a) / a;
+          break;
+        }
+        case scalar_op::exp_v: {
+          const double res = vals_[o.res_];
+          a_adj += adj * res;
+          a_dadj += dadj * res + adj * dvals_[o.res_];
+          break;
+        }
+        case scalar_op::log_v:
+          a_adj += adj / a;
+          a_dadj += (dadj - adj * da / a) / a;
+          break;
+        case scalar_op::sqrt_v: {
+          const double res = vals_[o.res_];
+          a_adj += adj / (2.0 * res);
+          a_dadj += (dadj - adj * dvals_[o.res_] / res) / (2.0 * res);
+          break;
+        }
+        case scalar_op::square_v:
+          a_adj += adj * 2.0 * a;
+          a_dadj += 2.0 * (dadj * a + adj * da);
+          break;
+      }
+    }
+  }
+
+ public:
+  /**
+   * Construct a taped Hessian for the specified function.
+   *
+   * @param f Function taking an <code>Eigen::Matrix<var, -1, 1></code>
+   * or an <code>Eigen::Matrix<fvar<var>, -1, 1></code> and returning a
+   * scalar of the same type
+   */
+  explicit taped_hessian(const F& f) : base_t(f) {}
+
+  /**
+   * Calculate the value of the function and the product of its
+   * Hessian with the specified vector at the specified argument,
+   * replaying the recorded program if there is one.  The function is
+   * recorded first if needed.
+   *
+   * @param[in] x Argument to function
+   * @param[in] v Vector to multiply the Hessian with
+   * @param[out] fx Function applied to argument
+   * @param[out] Hv Product of the Hessian of the function at the
+   * argument with the vector
+   * @throw std::invalid_argument if the sizes of the argument and the
+   * vector do not match
+   */
+  void hessian_times_vector(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                            const Eigen::Matrix<double, Eigen::Dynamic, 1>& v,
+                            double& fx,
+                            Eigen::Matrix<double, Eigen::Dynamic, 1>& Hv) {
+    check_size_match("taped_hessian::hessian_times_vector", "argument",
+                     x.size(), "vector", v.size());
+    if (!recorded_ || x.size() != num_inputs_ || !forward(x)) {
+      Eigen::Matrix<double, Eigen::Dynamic, 1> grad_fx;
+      record(x, fx, grad_fx);
+      if (!recorded_) {
+        stan::math::hessian_times_vector(f_, x, v, fx, Hv);
+        return;
+      }
+    }
+    forward_tangent(v);
+    reverse_tangent();
+    fx = vals_[output_];
+    Hv.resize(num_inputs_);
+    for (Eigen::Index i = 0; i < num_inputs_; ++i) {
+      Hv.coeffRef(i) = dadjs_[i];
+    }
+    ++num_replays_;
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -51,6 +51,32 @@
     using ReturnType = double;
   };
 
+  /**
+   * Traits specialization for Eigen binary operations for `float`
+   * and `double` arguments, so that single precision data can be
+   * combined with double precision parameters without first being
+   * copied to double precision.
+   *
+   * @tparam BinaryOp type of binary operation for which traits are
+   * defined
+   */
+  template <typename BinaryOp>
+  struct ScalarBinaryOpTraits<float, double, BinaryOp> {
+    using ReturnType = double;
+  };
+
+  /**
+   * Traits specialization for Eigen binary operations for `double`
+   * and `float` arguments.
+   *
+   * @tparam BinaryOp type of binary operation for which traits are
+   * defined
+   */
+  template <typename BinaryOp>
+  struct ScalarBinaryOpTraits<double, float, BinaryOp> {
+    using ReturnType = double;
+  };
+
   /**
    * Traits specialization for Eigen binary operations for `int`
    * and complex `double` arguments.
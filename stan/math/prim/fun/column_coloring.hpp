@@ -0,0 +1,65 @@
+#ifndef STAN_MATH_PRIM_FUN_COLUMN_COLORING_HPP
+#define STAN_MATH_PRIM_FUN_COLUMN_COLORING_HPP
+
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Return a coloring of the columns of a sparsity pattern in which no
+ * two columns of the same color have a nonzero in the same row.
+ *
+ * Columns of the same color are structurally orthogonal, so a single
+ * directional derivative along the sum of their unit vectors recovers
+ * every nonzero in them.  This is a distance-2 coloring of the
+ * bipartite graph of rows and columns, computed greedily in column
+ * order.  Banded patterns of bandwidth <code>b</code> get
+ * <code>2 * b + 1</code> colors.
+ *
+ * @tparam T type of elements of the pattern, which are ignored
+ * @param pattern sparsity pattern
+ * @param[out] num_colors number of colors used
+ * @return color of each column, from zero to
+ * <code>num_colors - 1</code>
+ */
+template <typename T>
+inline std::vector<int> column_coloring(const Eigen::SparseMatrix<T>& pattern,
+                                        int& num_colors) {
+  using col_iterator = typename Eigen::SparseMatrix<T>::InnerIterator;
+  using row_iterator =
+      typename Eigen::SparseMatrix<T, Eigen::RowMajor>::InnerIterator;
+  const Eigen::SparseMatrix<T, Eigen::RowMajor> rows = pattern;
+  const int N = pattern.cols();
+  std::vector<int> colors(N, -1);
+  // forbidden[c] == j if color c is used by a neighbour of column j
+  std::vector<int> forbidden;
+  num_colors = 0;
+  for (int j = 0; j < N; ++j) {
+    for (col_iterator col(pattern, j); col; ++col) {
+      for (row_iterator row(rows, col.row()); row; ++row) {
+        const int c = colors[row.col()];
+        if (c >= 0) {
+          forbidden[c] = j;
+        }
+      }
+    }
+    int c = 0;
+    while (c < num_colors && forbidden[c] == j) {
+      ++c;
+    }
+    if (c == num_colors) {
+      ++num_colors;
+      forbidden.push_back(-1);
+    }
+    colors[j] = c;
+  }
+  return colors;
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
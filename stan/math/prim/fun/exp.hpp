@@ -101,6 +101,23 @@ inline std::complex<V> complex_exp(const std::complex<V>& z) {
   V exp_re = exp(z.real());
   return {exp_re * cos(z.imag()), exp_re * sin(z.imag())};
 }
+
+/**
+ * Return the exponential of each double in the specified packet.  The
+ * packet exponential of Eigen clamps its argument to
+ * <code>[-709.784, 709.784]</code>, so that it does not underflow to
+ * zero; this version returns zero below that range instead.
+ *
+ * @tparam Packet type of packet of doubles
+ * @param x packet
+ * @return Exponential of each element of the packet.
+ */
+template <typename Packet>
+inline Packet pexp_underflow(const Packet& x) {
+  return Eigen::internal::pselect(
+      Eigen::internal::pcmp_lt(x, Eigen::internal::pset1<Packet>(-709.784)),
+      Eigen::internal::pzero(x), Eigen::internal::pexp(x));
+}
 }  // namespace internal
 }  // namespace math
 }  // namespace stan
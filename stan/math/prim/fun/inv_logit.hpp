@@ -6,6 +6,7 @@
 #include <stan/math/prim/fun/exp.hpp>
 #include <stan/math/prim/fun/inv.hpp>
 #include <stan/math/prim/functor/apply_scalar_unary.hpp>
+#include <stan/math/prim/functor/apply_vector_unary.hpp>
 #include <cmath>
 
 namespace stan {
@@ -82,16 +83,73 @@ struct inv_logit_fun {
  * @return Inverse logit applied to each value in x.
  */
 template <
-    typename T, require_not_var_matrix_t<T>* = nullptr,
+    typename T, require_not_container_st<std::is_arithmetic, T>* = nullptr,
+    require_not_var_matrix_t<T>* = nullptr,
     require_all_not_nonscalar_prim_or_rev_kernel_expression_t<T>* = nullptr>
 inline auto inv_logit(const T& x) {
   return apply_scalar_unary<inv_logit_fun, T>::apply(x);
 }
 
-// TODO(Tadej): Eigen is introducing their implementation logistic() of this
-// in 3.4. Use that once we switch to Eigen 3.4
+namespace internal {
+/**
+ * Eigen functor for <code>inv_logit()</code> of doubles, which Eigen
+ * vectorizes with its packet exponential.  The packet version
+ * computes <code>exp(-|x|)</code> once and returns
+ * <code>1 / (1 + exp(-|x|))</code> for nonnegative arguments and
+ * <code>exp(x) / (1 + exp(x))</code> for negative ones, so unlike
+ * <code>logistic()</code> of Eigen it does not underflow early.
+ */
+struct inv_logit_op {
+  EIGEN_EMPTY_STRUCT_CTOR(inv_logit_op)
+  inline double operator()(double x) const { return inv_logit(x); }
+
+  template <typename Packet>
+  inline Packet packetOp(const Packet& x) const {
+    using Eigen::internal::pset1;
+    const Packet one = pset1<Packet>(1.0);
+    const Packet exp_m_abs_x
+        = pexp_underflow(Eigen::internal::pnegate(Eigen::internal::pabs(x)));
+    const Packet inv_logit_abs_x
+        = Eigen::internal::pdiv(one, Eigen::internal::padd(one, exp_m_abs_x));
+    return Eigen::internal::pselect(
+        Eigen::internal::pcmp_lt(x, Eigen::internal::pzero(x)),
+        Eigen::internal::pmul(exp_m_abs_x, inv_logit_abs_x), inv_logit_abs_x);
+  }
+};
+}  // namespace internal
+
+/**
+ * Vectorized version of inv_logit() for containers of arithmetic
+ * values, which are evaluated a packet at a time with the SIMD
+ * instructions Eigen is compiled for.
+ *
+ * @tparam T type of container
+ * @param x container
+ * @return Inverse logit applied to each value in x.
+ */
+template <typename T, require_container_st<std::is_arithmetic, T>* = nullptr>
+inline auto inv_logit(const T& x) {
+  return apply_vector_unary<T>::apply(x, [](const auto& v) {
+    return v.array().template cast<double>().unaryExpr(
+        internal::inv_logit_op());
+  });
+}
 
 }  // namespace math
 }  // namespace stan
 
+namespace Eigen {
+namespace internal {
+template <>
+struct functor_traits<stan::math::internal::inv_logit_op> {
+  enum {
+    Cost = functor_traits<scalar_exp_op<double>>::Cost
+           + 3 * NumTraits<double>::AddCost + scalar_div_cost<double>::value,
+    PacketAccess = packet_traits<double>::HasExp
+                   && packet_traits<double>::HasDiv
+  };
+};
+}  // namespace internal
+}  // namespace Eigen
+
 #endif
@@ -5,7 +5,9 @@
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/prim/fun/is_nan.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/functor/apply_scalar_unary.hpp>
+#include <stan/math/prim/functor/apply_vector_unary.hpp>
 #include <cmath>
 
 namespace stan {
@@ -77,13 +79,74 @@ struct log1p_fun {
  * @return Elementwise log1p of members of container.
  */
 template <typename T,
+          require_not_container_st<std::is_arithmetic, T>* = nullptr,
           require_not_nonscalar_prim_or_rev_kernel_expression_t<T>* = nullptr,
           require_not_var_matrix_t<T>* = nullptr>
 inline auto log1p(const T& x) {
   return apply_scalar_unary<log1p_fun, T>::apply(x);
 }
 
+namespace internal {
+/**
+ * Eigen functor for <code>log1p()</code> of doubles without argument
+ * checks, which Eigen vectorizes with its packet logarithm.  The packet
+ * version computes <code>x * log(u) / (u - 1)</code> with
+ * <code>u = 1 + x</code>, in which the rounding error of
+ * <code>u</code> cancels, so it is accurate to a few ulp.
+ */
+struct log1p_op {
+  EIGEN_EMPTY_STRUCT_CTOR(log1p_op)
+  inline double operator()(double x) const { return std::log1p(x); }
+
+  template <typename Packet>
+  inline Packet packetOp(const Packet& x) const {
+    return Eigen::internal::generic_plog1p(x);
+  }
+};
+}  // namespace internal
+
+/**
+ * Return the elementwise application of <code>log1p()</code> to
+ * specified container of arithmetic values.  The logarithms are
+ * evaluated a packet at a time with the SIMD instructions Eigen is
+ * compiled for.
+ *
+ * @tparam T type of container
+ * @param x container
+ * @return Elementwise log1p of members of container.
+ * @throw std::domain_error If any argument is less than -1.
+ */
+template <typename T, require_container_st<std::is_arithmetic, T>* = nullptr>
+inline auto log1p(const T& x) {
+  return make_holder(
+      [](const auto& v_ref) {
+        return apply_vector_unary<ref_type_t<T>>::apply(
+            v_ref, [](const auto& v) {
+              if ((v.array() < -1.0).any()) {
+                check_greater_or_equal("log1p", "x", v, -1.0);
+              }
+              return v.array().template cast<double>().unaryExpr(
+                  internal::log1p_op());
+            });
+      },
+      to_ref(x));
+}
+
 }  // namespace math
 }  // namespace stan
 
+namespace Eigen {
+namespace internal {
+template <>
+struct functor_traits<stan::math::internal::log1p_op> {
+  enum {
+    Cost = functor_traits<scalar_log_op<double>>::Cost
+           + 3 * NumTraits<double>::AddCost + scalar_div_cost<double>::value,
+    PacketAccess = packet_traits<double>::HasLog
+                   && packet_traits<double>::HasDiv
+  };
+};
+}  // namespace internal
+}  // namespace Eigen
+
 #endif
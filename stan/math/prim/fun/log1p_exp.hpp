@@ -6,6 +6,7 @@
 #include <stan/math/prim/fun/log.hpp>
 #include <stan/math/prim/fun/log1p.hpp>
 #include <stan/math/prim/functor/apply_scalar_unary.hpp>
+#include <stan/math/prim/functor/apply_vector_unary.hpp>
 #include <cmath>
 
 namespace stan {
@@ -73,13 +74,71 @@ struct log1p_exp_fun {
  * @return Natural log of (1 + exp()) applied to each value in x.
  */
 template <typename T,
+          require_not_container_st<std::is_arithmetic, T>* = nullptr,
           require_not_nonscalar_prim_or_rev_kernel_expression_t<T>* = nullptr,
           require_not_var_matrix_t<T>* = nullptr>
 inline auto log1p_exp(const T& x) {
   return apply_scalar_unary<log1p_exp_fun, T>::apply(x);
 }
 
+namespace internal {
+/**
+ * Eigen functor for <code>log1p_exp()</code> of doubles, which Eigen
+ * vectorizes with its packet exponential and logarithm.  The packet
+ * version computes <code>max(x, 0) + log1p(exp(-|x|))</code>, which
+ * neither overflows nor needs a branch.
+ */
+struct log1p_exp_op {
+  EIGEN_EMPTY_STRUCT_CTOR(log1p_exp_op)
+  inline double operator()(double x) const { return log1p_exp(x); }
+
+  template <typename Packet>
+  inline Packet packetOp(const Packet& x) const {
+    using Eigen::internal::pabs;
+    using Eigen::internal::pnegate;
+    return Eigen::internal::padd(
+        Eigen::internal::pmax(x, Eigen::internal::pzero(x)),
+        Eigen::internal::generic_plog1p(pexp_underflow(pnegate(pabs(x)))));
+  }
+};
+}  // namespace internal
+
+/**
+ * Vectorized version of log1p_exp() for containers of arithmetic
+ * values, which are evaluated a packet at a time with the SIMD
+ * instructions Eigen is compiled for.
+ *
+ * @tparam T type of container
+ * @param x container
+ * @return Natural log of (1 + exp()) applied to each value in x.
+ */
+template <typename T, require_container_st<std::is_arithmetic, T>* = nullptr>
+inline auto log1p_exp(const T& x) {
+  return apply_vector_unary<T>::apply(x, [](const auto& v) {
+    return v.array().template cast<double>().unaryExpr(
+        internal::log1p_exp_op());
+  });
+}
+
 }  // namespace math
 }  // namespace stan
 
+namespace Eigen {
+namespace internal {
+template <>
+struct functor_traits<stan::math::internal::log1p_exp_op> {
+  enum {
+    Cost = functor_traits<scalar_exp_op<double>>::Cost
+           + functor_traits<stan::math::internal::log1p_op>::Cost
+           + 2 * NumTraits<double>::AddCost,
+    // with two doubles per packet the scalar version is faster
+    PacketAccess = packet_traits<double>::size > 2
+                   && packet_traits<double>::HasExp
+                   && packet_traits<double>::HasLog
+                   && packet_traits<double>::HasDiv
+  };
+};
+}  // namespace internal
+}  // namespace Eigen
+
 #endif
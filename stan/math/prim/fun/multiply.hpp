@@ -5,6 +5,8 @@
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/prim/fun/dot_product.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
+#include <algorithm>
 #include <type_traits>
 
 namespace stan {
@@ -84,6 +86,18 @@ inline auto multiply(Scal c, const Mat& m) {
   return c * m;
 }
 
+namespace internal {
+/**
+ * Whether the product of the specified types is a column major matrix
+ * of single precision values times a column vector of doubles.
+ */
+template <typename Mat, typename Vec>
+using is_float_matrix_double_vector = bool_constant<
+    std::is_same<value_type_t<Mat>, float>::value && !Mat::IsRowMajor
+    && std::is_same<value_type_t<Vec>, double>::value
+    && is_eigen_col_vector<Vec>::value>;
+}  // namespace internal
+
 /**
  * Return the product of the specified matrices. The number of
  * columns in the first matrix must be the same as the number of rows
@@ -100,13 +114,61 @@ inline auto multiply(Scal c, const Mat& m) {
  */
 template <typename Mat1, typename Mat2,
           require_all_eigen_vt<std::is_arithmetic, Mat1, Mat2>* = nullptr,
-          require_not_eigen_row_and_col_t<Mat1, Mat2>* = nullptr>
+          require_not_eigen_row_and_col_t<Mat1, Mat2>* = nullptr,
+          require_not_t<
+              internal::is_float_matrix_double_vector<Mat1, Mat2>>* = nullptr>
 inline auto multiply(const Mat1& m1, const Mat2& m2) {
   check_size_match("multiply", "Columns of m1", m1.cols(), "Rows of m2",
                    m2.rows());
   return m1 * m2;
 }
 
+/**
+ * Return the product of the specified column major matrix of single
+ * precision values and column vector of doubles, accumulated in double
+ * precision.
+ *
+ * The product of Eigen for mixed scalar types is not vectorized, so
+ * instead each block of rows of the result is accumulated as a sum of
+ * the columns of the matrix converted to double precision times the
+ * elements of the vector.  The matrix is read once and is never
+ * copied to double precision, so a matrix of data held in single
+ * precision takes half the memory bandwidth of the same product in
+ * double precision.
+ *
+ * @tparam Mat type of the matrix or expression
+ * @tparam Vec type of the vector or expression
+ *
+ * @param m matrix or expression
+ * @param v vector or expression
+ * @return the product of the matrix and the vector
+ * @throw <code>std::invalid_argument</code> if the number of columns of m does
+ * not match the number of rows of v.
+ */
+template <typename Mat, typename Vec,
+          require_t<internal::is_float_matrix_double_vector<Mat, Vec>>* =
+              nullptr>
+inline Eigen::Matrix<double, Mat::RowsAtCompileTime, 1> multiply(
+    const Mat& m, const Vec& v) {
+  check_size_match("multiply", "Columns of m1", m.cols(), "Rows of m2",
+                   v.rows());
+  const auto& m_ref = to_ref(m);
+  const auto& v_ref = to_ref(v);
+  Eigen::Matrix<double, Mat::RowsAtCompileTime, 1> res
+      = Eigen::Matrix<double, Mat::RowsAtCompileTime, 1>::Zero(m.rows());
+  // blocks of the result small enough to stay in the L1 cache
+  constexpr Eigen::Index block_rows = 256;
+  for (Eigen::Index i = 0; i < m.rows(); i += block_rows) {
+    const Eigen::Index n = std::min(block_rows, m.rows() - i);
+    auto res_block = res.segment(i, n);
+    for (Eigen::Index k = 0; k < m.cols(); ++k) {
+      res_block += m_ref.col(k).segment(i, n).template cast<double>()
+                   * v_ref.coeff(k);
+    }
+  }
+  return res;
+}
+
 /**
  * Return the product of the specified matrices. The number of
  * columns in the first matrix must be the same as the number of rows
@@ -86,6 +86,10 @@ class empty_broadcast_array<ViewElt, T, require_eigen_t<T>> {
    * Not implemented so cannot be called.
    */
   T& col(int /*i*/);
+  /** \ingroup type_trait
+   * Not implemented so cannot be called.
+   */
+  Eigen::Diagonal<T_arg> diagonal();
 };
 }  // namespace internal
 }  // namespace math
@@ -0,0 +1,29 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_CHECKPOINT_HPP
+#define STAN_MATH_PRIM_FUNCTOR_CHECKPOINT_HPP
+
+#include <stan/math/prim/meta.hpp>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return the result of applying the specified function to the
+ * specified arguments.  Without any variables among the arguments
+ * there is nothing to differentiate, so the function is simply
+ * called.
+ *
+ * @tparam F Type of function
+ * @tparam Args Types of arguments
+ * @param f Function to evaluate
+ * @param args Arguments to the function
+ * @return <code>f(args...)</code>
+ */
+template <typename F, typename... Args,
+          require_all_not_st_var<Args...>* = nullptr>
+inline auto checkpoint(const F& f, const Args&... args) {
+  return f(args...);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
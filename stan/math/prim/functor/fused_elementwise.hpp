@@ -0,0 +1,130 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_FUSED_ELEMENTWISE_HPP
+#define STAN_MATH_PRIM_FUNCTOR_FUSED_ELEMENTWISE_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Set the dimensions of the result of <code>fused_elementwise()</code>
+ * from the first matrix argument and check that the other matrix
+ * arguments match them.  Scalar arguments are broadcast and have no
+ * dimensions.
+ */
+template <typename T, require_stan_scalar_t<T>* = nullptr>
+inline void fused_dims(const T& x, Eigen::Index& rows, Eigen::Index& cols) {}
+
+template <typename T, require_matrix_t<T>* = nullptr>
+inline void fused_dims(const T& x, Eigen::Index& rows, Eigen::Index& cols) {
+  if (rows < 0) {
+    rows = x.rows();
+    cols = x.cols();
+    return;
+  }
+  check_size_match("fused_elementwise", "Rows of argument", x.rows(),
+                   "rows of first matrix argument", rows);
+  check_size_match("fused_elementwise", "Columns of argument", x.cols(),
+                   "columns of first matrix argument", cols);
+}
+
+/**
+ * Return the element of an argument of <code>fused_elementwise()</code>
+ * at the specified linear index, or the argument itself if it is a
+ * scalar.
+ */
+template <typename T, require_stan_scalar_t<T>* = nullptr>
+inline const T& fused_coeff(const T& x, Eigen::Index i) {
+  return x;
+}
+
+template <typename T, require_eigen_t<T>* = nullptr>
+inline decltype(auto) fused_coeff(const T& x, Eigen::Index i) {
+  return x.coeff(i);
+}
+
+/**
+ * The type of the first matrix in a list of types.
+ */
+template <typename... Ts>
+struct fused_matrix;
+
+template <typename T, typename... Ts>
+struct fused_matrix<T, Ts...> {
+  using type = typename std::conditional_t<is_matrix<T>::value,
+                                           std::decay<T>,
+                                           fused_matrix<Ts...>>::type;
+};
+
+template <>
+struct fused_matrix<> {
+  using type = void;
+};
+
+template <typename... Ts>
+using fused_matrix_t = typename fused_matrix<Ts...>::type;
+
+template <typename F, typename Ret, typename... Args>
+inline void fused_apply(const F& f, Ret& ret, const Args&... args) {
+  for (Eigen::Index i = 0; i < ret.size(); ++i) {
+    ret.coeffRef(i) = f(fused_coeff(args, i)...);
+  }
+}
+
+}  // namespace internal
+
+/**
+ * Return the result of applying the specified scalar function to the
+ * elements of the specified matrices in a single loop.
+ *
+ * The arguments are matrices of the same dimensions, or scalars which
+ * are passed to every call of the function.  The element of the result
+ * at linear index <code>i</code> is <code>f</code> applied to the
+ * elements of the matrix arguments at index <code>i</code> and to the
+ * scalar arguments, so that an expression such as
+ * <code>exp(elt_multiply(a, b) + c)</code> can be written as
+ *
+ *     fused_elementwise([](const auto& a, const auto& b, const auto& c) {
+ *       return exp(a * b + c);
+ *     }, a, b, c);
+ *
+ * without any intermediate matrices.  With reverse mode arguments the
+ * whole function is one node on the autodiff stack.
+ *
+ * @tparam F Type of scalar function
+ * @tparam Args Types of arguments, matrices or scalars
+ * @param f Scalar function, which must accept the scalar types of the
+ * arguments
+ * @param args Arguments, at least one of which is a matrix
+ * @return Matrix of the results of the function
+ * @throw std::invalid_argument if the dimensions of the matrix
+ * arguments do not match
+ */
+template <typename F, typename... Args,
+          require_all_not_st_var<Args...>* = nullptr,
+          require_any_matrix_t<Args...>* = nullptr>
+inline auto fused_elementwise(const F& f, const Args&... args) {
+  using T_return = std::decay_t<decltype(f(
+      std::declval<const scalar_type_t<Args>&>()...))>;
+  using T_matrix = internal::fused_matrix_t<Args...>;
+  using ret_type = Eigen::Matrix<T_return, T_matrix::RowsAtCompileTime,
+                                 T_matrix::ColsAtCompileTime>;
+  Eigen::Index rows = -1;
+  Eigen::Index cols = -1;
+  static_cast<void>(std::initializer_list<int>{
+      (internal::fused_dims(args, rows, cols), 0)...});
+  ret_type ret(rows, cols);
+  internal::fused_apply(f, ret, to_ref(args)...);
+  return ret;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
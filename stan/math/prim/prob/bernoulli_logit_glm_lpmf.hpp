@@ -9,6 +9,7 @@
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/exp.hpp>
 #include <stan/math/prim/fun/isfinite.hpp>
+#include <stan/math/prim/fun/multiply.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
@@ -111,7 +112,7 @@ return_type_t<T_x, T_alpha, T_beta> bernoulli_logit_glm_lpmf(
         = forward_as<T_xbeta_tmp>((x_val * beta_val_vec)(0, 0));
     ytheta = signs * (ytheta_tmp + as_array_or_scalar(alpha_val_vec));
   } else {
-    ytheta = (x_val * beta_val_vec).array();
+    ytheta = multiply(x_val, beta_val_vec);
     ytheta = signs * (ytheta + as_array_or_scalar(alpha_val_vec));
   }
 
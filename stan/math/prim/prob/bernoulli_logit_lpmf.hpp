@@ -5,8 +5,8 @@
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
 #include <stan/math/prim/fun/as_value_array_or_scalar.hpp>
-#include <stan/math/prim/fun/exp.hpp>
-#include <stan/math/prim/fun/log1p.hpp>
+#include <stan/math/prim/fun/inv_logit.hpp>
+#include <stan/math/prim/fun/log1p_exp.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
@@ -36,7 +36,6 @@ template <bool propto, typename T_n, typename T_prob,
 return_type_t<T_prob> bernoulli_logit_lpmf(const T_n& n, const T_prob& theta) {
   using T_partials_return = partials_return_t<T_n, T_prob>;
   using T_partials_array = Eigen::Array<T_partials_return, Eigen::Dynamic, 1>;
-  using std::exp;
   using T_n_ref = ref_type_if_t<!is_constant<T_n>::value, T_n>;
   using T_theta_ref = ref_type_if_t<!is_constant<T_prob>::value, T_prob>;
   static const char* function = "bernoulli_logit_lpmf";
@@ -69,21 +68,13 @@ return_type_t<T_prob> bernoulli_logit_lpmf(const T_n& n, const T_prob& theta) {
         = forward_as<T_partials_return>(signs * theta_val);
     ntheta = T_partials_array::Constant(1, 1, ntheta_s);
   }
-  T_partials_array exp_m_ntheta = exp(-ntheta);
-  static const double cutoff = 20.0;
-  T_partials_return logp = sum(
-      (ntheta > cutoff)
-          .select(-exp_m_ntheta,
-                  (ntheta < -cutoff).select(ntheta, -log1p(exp_m_ntheta))));
+  // log1p_exp and inv_logit of double arrays are SIMD kernels, so
+  // unlike a select between cutoffs these loops vectorize
+  T_partials_return logp = -sum(log1p_exp(-ntheta));
 
   auto ops_partials = make_partials_propagator(theta_ref);
   if (!is_constant_all<T_prob>::value) {
-    edge<0>(ops_partials).partials_
-        = (ntheta > cutoff)
-              .select(-exp_m_ntheta,
-                      (ntheta >= -cutoff)
-                          .select(signs * exp_m_ntheta / (exp_m_ntheta + 1),
-                                  signs));
+    edge<0>(ops_partials).partials_ = signs * inv_logit(-ntheta);
   }
   return ops_partials.build(logp);
 }
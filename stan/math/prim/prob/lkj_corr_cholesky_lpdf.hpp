@@ -5,8 +5,10 @@
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/log.hpp>
 #include <stan/math/prim/fun/make_nu.hpp>
-#include <stan/math/prim/fun/multiply.hpp>
+#include <stan/math/prim/fun/sum.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
+#include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/functor/partials_propagator.hpp>
 #include <stan/math/prim/prob/lkj_corr_log.hpp>
 
 namespace stan {
@@ -17,11 +19,13 @@ namespace math {
 template <bool propto, typename T_covar, typename T_shape>
 return_type_t<T_covar, T_shape> lkj_corr_cholesky_lpdf(const T_covar& L,
                                                        const T_shape& eta) {
+  using T_partials_return = partials_return_t<T_covar, T_shape>;
   using lp_ret = return_type_t<T_covar, T_shape>;
   static const char* function = "lkj_corr_cholesky_lpdf";
   const auto& L_ref = to_ref(L);
+  const auto& L_val = to_ref(value_of(L_ref));
   check_positive(function, "Shape parameter", eta);
-  check_lower_triangular(function, "Random variable", L_ref);
+  check_lower_triangular(function, "Random variable", L_val);
 
   const unsigned int K = L.rows();
   if (K == 0) {
@@ -34,19 +38,29 @@ return_type_t<T_covar, T_shape> lkj_corr_cholesky_lpdf(const T_covar& L,
     lp += do_lkj_constant(eta, K);
   }
   if (include_summand<propto, T_covar, T_shape>::value) {
+    // the log density is linear in the logs of the diagonal of L, so its
+    // partials are computed directly instead of creating a vari per
+    // element of L
     const int Km1 = K - 1;
-    Eigen::Matrix<value_type_t<T_covar>, Eigen::Dynamic, 1> log_diagonals
-        = log(L_ref.diagonal().tail(Km1).array());
-    Eigen::Matrix<lp_ret, Eigen::Dynamic, 1> values(Km1);
+    const T_partials_return eta_val = value_of(eta);
+    Eigen::Array<T_partials_return, Eigen::Dynamic, 1> diagonals
+        = L_val.diagonal().tail(Km1).array();
+    Eigen::Array<T_partials_return, Eigen::Dynamic, 1> log_diagonals
+        = log(diagonals);
+    Eigen::Array<T_partials_return, Eigen::Dynamic, 1> coefficients(Km1);
     for (int k = 0; k < Km1; k++) {
-      values(k) = (Km1 - k - 1) * log_diagonals(k);
+      coefficients(k) = (Km1 - k - 1) + 2.0 * eta_val - 2.0;
     }
-    if (eta == 1.0 && is_constant_all<scalar_type<T_shape>>::value) {
-      lp += sum(values);
-      return (lp);
+    auto ops_partials = make_partials_propagator(L_ref, eta);
+    if (!is_constant_all<T_covar>::value) {
+      // the partials start at zero, only the diagonal is nonzero
+      partials<0>(ops_partials).diagonal().tail(Km1)
+          = (coefficients / diagonals).matrix();
     }
-    values += multiply(2.0 * eta - 2.0, log_diagonals);
-    lp += sum(values);
+    if (!is_constant_all<T_shape>::value) {
+      partials<1>(ops_partials) = 2.0 * sum(log_diagonals);
+    }
+    lp += ops_partials.build(sum(coefficients * log_diagonals));
   }
 
   return lp;
@@ -8,6 +8,8 @@
 #include <stan/math/prim/fun/log.hpp>
 #include <stan/math/prim/fun/sum.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
+#include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/functor/partials_propagator.hpp>
 
 namespace stan {
 namespace math {
@@ -47,12 +49,16 @@ return_type_t<double, T_shape> do_lkj_constant(const T_shape& eta,
 //                  eta > 0; eta == 1 <-> uniform]
 template <bool propto, typename T_y, typename T_shape>
 return_type_t<T_y, T_shape> lkj_corr_lpdf(const T_y& y, const T_shape& eta) {
+  using T_partials_return = partials_return_t<T_y, T_shape>;
+  using T_partials_matrix
+      = Eigen::Matrix<T_partials_return, Eigen::Dynamic, Eigen::Dynamic>;
   static const char* function = "lkj_corr_lpdf";
 
   return_type_t<T_y, T_shape> lp(0.0);
   const auto& y_ref = to_ref(y);
+  const auto& y_val = to_ref(value_of(y_ref));
   check_positive(function, "Shape parameter", eta);
-  check_corr_matrix(function, "Correlation matrix", y_ref);
+  check_corr_matrix(function, "Correlation matrix", y_val);
 
   const unsigned int K = y.rows();
   if (K == 0) {
@@ -71,8 +77,26 @@ return_type_t<T_y, T_shape> lkj_corr_lpdf(const T_y& y, const T_shape& eta) {
     return lp;
   }
 
-  value_type_t<T_y> sum_values = sum(log(y_ref.ldlt().vectorD()));
-  lp += (eta - 1.0) * sum_values;
+  // the log determinant is computed from the lower triangle of y, so
+  // its partials are twice the inverse of y below the diagonal, the
+  // inverse on the diagonal and zero above it
+  Eigen::LDLT<T_partials_matrix> ldlt_y = T_partials_matrix(y_val).ldlt();
+  const T_partials_return log_det_y = sum(log(ldlt_y.vectorD()));
+  const T_partials_return eta_val = value_of(eta);
+  auto ops_partials = make_partials_propagator(y_ref, eta);
+  if (!is_constant_all<T_y>::value) {
+    T_partials_matrix inv_y
+        = ldlt_y.solve(T_partials_matrix::Identity(K, K));
+    T_partials_matrix d_y = T_partials_matrix::Zero(K, K);
+    d_y.template triangularView<Eigen::StrictlyLower>()
+        = 2.0 * (eta_val - 1.0) * inv_y;
+    d_y.diagonal() = (eta_val - 1.0) * inv_y.diagonal();
+    partials<0>(ops_partials) = d_y;
+  }
+  if (!is_constant_all<T_shape>::value) {
+    partials<1>(ops_partials) = log_det_y;
+  }
+  lp += ops_partials.build((eta_val - 1.0) * log_det_y);
   return lp;
 }
 
@@ -3,6 +3,10 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/diag_post_multiply.hpp>
+#include <stan/math/prim/fun/diag_pre_multiply.hpp>
+#include <stan/math/prim/fun/inv.hpp>
+#include <stan/math/prim/fun/sqrt.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/prob/lognormal_lpdf.hpp>
 #include <stan/math/prim/prob/lkj_corr_lpdf.hpp>
@@ -16,8 +20,8 @@ namespace math {
 // LKJ_cov(y|mu, sigma, eta) [ y covariance matrix (not correlation matrix)
 //                         mu vector, sigma > 0 vector, eta > 0 ]
 template <bool propto, typename T_y, typename T_loc, typename T_scale,
-          typename T_shape, require_eigen_matrix_dynamic_t<T_y>* = nullptr,
-          require_all_eigen_col_vector_t<T_loc, T_scale>* = nullptr>
+          typename T_shape, require_matrix_t<T_y>* = nullptr,
+          require_all_col_vector_t<T_loc, T_scale>* = nullptr>
 return_type_t<T_y, T_loc, T_scale, T_shape> lkj_cov_lpdf(const T_y& y,
                                                          const T_loc& mu,
                                                          const T_scale& sigma,
@@ -38,20 +42,18 @@ return_type_t<T_y, T_loc, T_scale, T_shape> lkj_cov_lpdf(const T_y& y,
 
   return_type_t<T_y, T_loc, T_scale, T_shape> lp(0.0);
 
-  const unsigned int K = y.rows();
-  const Eigen::Array<value_type_t<T_y>, Eigen::Dynamic, 1> sds
-      = y_ref.diagonal().array().sqrt();
-  for (unsigned int k = 0; k < K; k++) {
-    lp += lognormal_lpdf<propto>(sds(k), mu_ref(k), sigma_ref(k));
-  }
+  // the standard deviations and the rescaling are whole matrix
+  // operations, such that a var_value matrix y needs no vari per element
+  const auto& sds = to_ref(sqrt(y_ref.diagonal()));
+  lp += lognormal_lpdf<propto>(sds, mu_ref, sigma_ref);
   if (stan::is_constant_all<T_shape>::value && eta == 1.0) {
     // no need to rescale y into a correlation matrix
     lp += lkj_corr_lpdf<propto>(y_ref, eta);
     return lp;
   }
-  Eigen::DiagonalMatrix<value_type_t<T_y>, Eigen::Dynamic> D(K);
-  D.diagonal() = sds.inverse();
-  lp += lkj_corr_lpdf<propto>(D * y_ref * D, eta);
+  const auto& inv_sds = to_ref(inv(sds));
+  lp += lkj_corr_lpdf<propto>(
+      diag_pre_multiply(inv_sds, diag_post_multiply(y_ref, inv_sds)), eta);
   return lp;
 }
 
@@ -61,7 +63,7 @@ return_type_t<T_y, T_loc, T_scale, T_shape> lkj_cov_lpdf(const T_y& y,
 // LKJ_Cov(y|mu, sigma, eta) [ y covariance matrix (not correlation matrix)
 //                         mu scalar, sigma > 0 scalar, eta > 0 ]
 template <bool propto, typename T_y, typename T_loc, typename T_scale,
-          typename T_shape, require_eigen_matrix_dynamic_t<T_y>* = nullptr,
+          typename T_shape, require_matrix_t<T_y>* = nullptr,
           require_all_stan_scalar_t<T_loc, T_scale>* = nullptr>
 return_type_t<T_y, T_loc, T_scale, T_shape> lkj_cov_lpdf(const T_y& y,
                                                          const T_loc& mu,
@@ -76,20 +78,16 @@ return_type_t<T_y, T_loc, T_scale, T_shape> lkj_cov_lpdf(const T_y& y,
 
   return_type_t<T_y, T_loc, T_scale, T_shape> lp(0.0);
 
-  const unsigned int K = y.rows();
-  const Eigen::Array<value_type_t<T_y>, Eigen::Dynamic, 1> sds
-      = y_ref.diagonal().array().sqrt();
-  for (unsigned int k = 0; k < K; k++) {
-    lp += lognormal_lpdf<propto>(sds(k), mu, sigma);
-  }
+  const auto& sds = to_ref(sqrt(y_ref.diagonal()));
+  lp += lognormal_lpdf<propto>(sds, mu, sigma);
   if (stan::is_constant_all<T_shape>::value && eta == 1.0) {
     // no need to rescale y into a correlation matrix
     lp += lkj_corr_lpdf<propto>(y_ref, eta);
     return lp;
   }
-  Eigen::DiagonalMatrix<value_type_t<T_y>, Eigen::Dynamic> D(K);
-  D.diagonal() = sds.inverse();
-  lp += lkj_corr_lpdf<propto>(D * y_ref * D, eta);
+  const auto& inv_sds = to_ref(inv(sds));
+  lp += lkj_corr_lpdf<propto>(
+      diag_pre_multiply(inv_sds, diag_post_multiply(y_ref, inv_sds)), eta);
   return lp;
 }
 
@@ -4,11 +4,13 @@
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/constants.hpp>
-#include <stan/math/prim/fun/dot_self.hpp>
+#include <stan/math/prim/fun/columns_dot_self.hpp>
 #include <stan/math/prim/fun/log.hpp>
-#include <stan/math/prim/fun/mdivide_left_tri_low.hpp>
+#include <stan/math/prim/fun/mdivide_left_tri.hpp>
+#include <stan/math/prim/fun/multiply.hpp>
 #include <stan/math/prim/fun/sum.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
+#include <stan/math/prim/fun/transpose.hpp>
 
 namespace stan {
 namespace math {
@@ -36,8 +38,8 @@ namespace math {
  * or not semi-positive definite.
  */
 template <bool propto, typename T_y, typename T_covar, typename T_w,
-          require_all_eigen_matrix_dynamic_t<T_y, T_covar>* = nullptr,
-          require_eigen_col_vector_t<T_w>* = nullptr>
+          require_all_matrix_t<T_y, T_covar>* = nullptr,
+          require_col_vector_t<T_w>* = nullptr>
 return_type_t<T_y, T_covar, T_w> multi_gp_cholesky_lpdf(const T_y& y,
                                                         const T_covar& L,
                                                         const T_w& w) {
@@ -71,13 +73,11 @@ return_type_t<T_y, T_covar, T_w> multi_gp_cholesky_lpdf(const T_y& y,
   }
 
   if (include_summand<propto, T_y, T_w, T_covar>::value) {
-    T_lp sum_lp_vec(0);
-    for (int i = 0; i < y.rows(); i++) {
-      sum_lp_vec
-          += w_ref.coeff(i)
-             * dot_self(mdivide_left_tri_low(L_ref, y_ref.row(i).transpose()));
-    }
-    lp -= 0.5 * sum_lp_vec;
+    // one triangular solve for all the rows of y
+    lp -= 0.5
+          * multiply(columns_dot_self(mdivide_left_tri<Eigen::Lower>(
+                         L_ref, transpose(y_ref))),
+                     w_ref);
   }
 
   return lp;
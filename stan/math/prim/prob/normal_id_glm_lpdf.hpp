@@ -8,6 +8,7 @@
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/isfinite.hpp>
 #include <stan/math/prim/fun/log.hpp>
+#include <stan/math/prim/fun/multiply.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/sum.hpp>
@@ -127,7 +128,7 @@ return_type_t<T_y, T_x, T_alpha, T_beta, T_scale> normal_id_glm_lpdf(
                 - as_array_or_scalar(alpha_val_vec))
                * inv_sigma;
   } else {
-    y_scaled = x_val * beta_val_vec;
+    y_scaled = multiply(x_val, beta_val_vec);
     y_scaled = (as_array_or_scalar(y_val_vec) - y_scaled
                 - as_array_or_scalar(alpha_val_vec))
                * inv_sigma;
@@ -186,8 +186,7 @@ return_type_t<T_x, T_beta, T_cuts> ordered_logistic_glm_lpmf(
       if (!is_constant_all<T_beta>::value) {
         if (T_x_rows == 1) {
           edge<1>(ops_partials).partials_
-              = (location_derivative * x_val.replicate(N_instances, 1))
-                    .transpose();
+              = (location_derivative.sum() * x_val).transpose();
         } else {
           edge<1>(ops_partials).partials_
               = (location_derivative * x_val).transpose();
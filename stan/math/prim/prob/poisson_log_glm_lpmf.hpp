@@ -9,6 +9,7 @@
 #include <stan/math/prim/fun/exp.hpp>
 #include <stan/math/prim/fun/isfinite.hpp>
 #include <stan/math/prim/fun/lgamma.hpp>
+#include <stan/math/prim/fun/multiply.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
@@ -110,7 +111,7 @@ return_type_t<T_x, T_alpha, T_beta> poisson_log_glm_lpmf(const T_y& y,
         = forward_as<T_xbeta_tmp>((x_val * beta_val_vec).coeff(0, 0));
     theta = theta_tmp + as_array_or_scalar(alpha_val_vec);
   } else {
-    theta = x_val * beta_val_vec;
+    theta = multiply(x_val, beta_val_vec);
     theta += as_array_or_scalar(alpha_val_vec);
   }
 
@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_AUTODIFFSTACKSTORAGE_HPP
 
 #include <stan/math/memory/stack_alloc.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace stan {
@@ -98,6 +99,12 @@ struct AutodiffStackSingleton {
     }
   }
 
+  struct tape_size {
+    size_t arena_bytes_;
+    size_t var_stack_;
+    size_t var_nochain_stack_;
+  };
+
   struct AutodiffStackStorage {
     AutodiffStackStorage &operator=(const AutodiffStackStorage &) = delete;
 
@@ -110,6 +117,75 @@ struct AutodiffStackSingleton {
     std::vector<size_t> nested_var_stack_sizes_;
     std::vector<size_t> nested_var_nochain_stack_sizes_;
     std::vector<size_t> nested_var_alloc_stack_starts_;
+
+    // open segment of recorded scalar operations, reset whenever the
+    // stack is recovered or a nested region starts
+    ChainableT *scalar_op_segment_ = nullptr;
+
+    // sizes of the most recently recovered tapes, a ring buffer
+    // holding at most tape_size_window_ entries; a window of zero
+    // disables adaptive sizing
+    size_t tape_size_window_ = 8;
+    std::vector<tape_size> recent_tape_sizes_;
+    size_t next_tape_size_ = 0;
+
+    /**
+     * Record the size of the tape which is about to be recovered.  The
+     * arena size is its peak usage, which includes nested regions
+     * that have already been recovered.
+     */
+    inline void record_tape_size() {
+      if (tape_size_window_ == 0) {
+        memalloc_.reset_peak_bytes_used();
+        return;
+      }
+      tape_size size{memalloc_.peak_bytes_used(), var_stack_.size(),
+                     var_nochain_stack_.size()};
+      if (recent_tape_sizes_.size() < tape_size_window_) {
+        recent_tape_sizes_.push_back(size);
+      } else {
+        recent_tape_sizes_[next_tape_size_ % recent_tape_sizes_.size()]
+            = size;
+      }
+      ++next_tape_size_;
+    }
+
+    /**
+     * Size the arena and the stacks for the largest of the recently
+     * recorded tapes.  If the arena needed more than one block for
+     * one of them it is coalesced into a single contiguous block,
+     * and the stacks are reserved, so that the next tape of that size
+     * needs no heap allocations.
+     *
+     * The peak arena usage is reset whether or not any tape sizes
+     * were recorded, so that it always refers to the next tape.
+     *
+     * Must only be called once the whole tape has been recovered.
+     */
+    inline void fit_to_recent_tapes() {
+      if (recent_tape_sizes_.empty()) {
+        memalloc_.reset_peak_bytes_used();
+        return;
+      }
+      tape_size max_size{0, 0, 0};
+      for (const auto &size : recent_tape_sizes_) {
+        max_size.arena_bytes_ = std::max(max_size.arena_bytes_,
+                                         size.arena_bytes_);
+        max_size.var_stack_ = std::max(max_size.var_stack_,
+                                       size.var_stack_);
+        max_size.var_nochain_stack_ = std::max(max_size.var_nochain_stack_,
+                                               size.var_nochain_stack_);
+      }
+      if (memalloc_.num_blocks() > 1) {
+        // the slack keeps a tape of exactly the peak size in the block
+        memalloc_.coalesce(std::max(
+            max_size.arena_bytes_ + max_size.arena_bytes_ / 16 + 64,
+            internal::DEFAULT_INITIAL_NBYTES));
+      }
+      memalloc_.reset_peak_bytes_used();
+      var_stack_.reserve(max_size.var_stack_);
+      var_nochain_stack_.reserve(max_size.var_nochain_stack_);
+    }
   };
 
   explicit AutodiffStackSingleton(AutodiffStackSingleton_t const &) = delete;
@@ -5,6 +5,7 @@
 #include <stan/math/rev/core/chainablestack.hpp>
 #include <stan/math/rev/core/empty_nested.hpp>
 #include <stan/math/rev/core/nested_size.hpp>
+#include <stan/math/rev/core/tape_histogram.hpp>
 #include <stan/math/rev/core/vari.hpp>
 #include <vector>
 
@@ -22,12 +23,23 @@ namespace math {
  *
  * <p>This function does not recover any memory from the computation.
  *
+ * <p>If <code>STAN_TAPE_HISTOGRAM</code> is defined every
+ * <code>chain()</code> call is timed and added to the
+ * <code>tape_histogram()</code>.  Define it for all or none of the
+ * translation units of a program; each of them compiles its own
+ * <code>grad()</code>, so in a mixed program only the reverse passes
+ * started from the units with the macro are recorded.
+ *
  */
 static void grad() {
   size_t end = ChainableStack::instance_->var_stack_.size();
   size_t beginning = empty_nested() ? 0 : end - nested_size();
   for (size_t i = end; i-- > beginning;) {
+#ifdef STAN_TAPE_HISTOGRAM
+    internal::timed_chain(ChainableStack::instance_->var_stack_[i]);
+#else
     ChainableStack::instance_->var_stack_[i]->chain();
+#endif
   }
 }
 
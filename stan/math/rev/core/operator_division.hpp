@@ -12,6 +12,7 @@
 #include <stan/math/rev/core/operator_addition.hpp>
 #include <stan/math/rev/core/operator_multiplication.hpp>
 #include <stan/math/rev/core/operator_subtraction.hpp>
+#include <stan/math/rev/core/scalar_op_tape.hpp>
 #include <stan/math/rev/fun/to_arena.hpp>
 #include <stan/math/rev/fun/value_of.hpp>
 #include <complex>
@@ -59,12 +60,18 @@ namespace math {
  * second.
  */
 inline var operator/(const var& dividend, const var& divisor) {
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::divide_vv,
+                                   dividend.val() / divisor.val(),
+                                   dividend.vi_, divisor.vi_)};
+#else
   return make_callback_var(
       dividend.val() / divisor.val(), [dividend, divisor](auto&& vi) {
         dividend.adj() += vi.adj() / divisor.val();
         divisor.adj()
             -= vi.adj() * dividend.val() / (divisor.val() * divisor.val());
       });
+#endif
 }
 
 /**
@@ -85,9 +92,15 @@ inline var operator/(const var& dividend, Arith divisor) {
   if (divisor == 1.0) {
     return dividend;
   }
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::divide_vd,
+                                   dividend.val() / divisor, dividend.vi_,
+                                   static_cast<double>(divisor))};
+#else
   return make_callback_var(
       dividend.val() / divisor,
       [dividend, divisor](auto&& vi) { dividend.adj() += vi.adj() / divisor; });
+#endif
 }
 
 /**
@@ -104,10 +117,16 @@ inline var operator/(const var& dividend, Arith divisor) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline var operator/(Arith dividend, const var& divisor) {
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::divide_dv,
+                                   dividend / divisor.val(), divisor.vi_,
+                                   static_cast<double>(dividend))};
+#else
   return make_callback_var(
       dividend / divisor.val(), [dividend, divisor](auto&& vi) {
         divisor.adj() -= vi.adj() * dividend / (divisor.val() * divisor.val());
       });
+#endif
 }
 
 /**
@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_EQUAL_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/scalar_op_tape.hpp>
 #include <stan/math/prim/meta.hpp>
 
 namespace stan {
@@ -25,7 +26,8 @@ namespace math {
  * second's.
  */
 inline bool operator==(const var& a, const var& b) {
-  return a.val() == b.val();
+  return internal::record_branch(internal::scalar_cmp::eq, a.vi_, b.vi_,
+                                 a.val() == b.val());
 }
 
 /**
@@ -40,7 +42,8 @@ inline bool operator==(const var& a, const var& b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator==(const var& a, Arith b) {
-  return a.val() == b;
+  return internal::record_branch(internal::scalar_cmp::eq, a.vi_,
+                                 static_cast<double>(b), a.val() == b);
 }
 
 /**
@@ -54,7 +57,8 @@ inline bool operator==(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator==(Arith a, const var& b) {
-  return a == b.val();
+  return internal::record_branch(internal::scalar_cmp::eq,
+                                 static_cast<double>(a), b.vi_, a == b.val());
 }
 
 /**
@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/scalar_op_tape.hpp>
 #include <stan/math/prim/meta.hpp>
 
 namespace stan {
@@ -23,7 +24,10 @@ namespace math {
  * @param b Second variable.
  * @return True if first variable's value is greater than second's.
  */
-inline bool operator>(const var& a, const var& b) { return a.val() > b.val(); }
+inline bool operator>(const var& a, const var& b) {
+  return internal::record_branch(internal::scalar_cmp::gt, a.vi_, b.vi_,
+                                 a.val() > b.val());
+}
 
 /**
  * Greater than operator comparing variable's value and double
@@ -36,7 +40,8 @@ inline bool operator>(const var& a, const var& b) { return a.val() > b.val(); }
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator>(const var& a, Arith b) {
-  return a.val() > b;
+  return internal::record_branch(internal::scalar_cmp::gt, a.vi_,
+                                 static_cast<double>(b), a.val() > b);
 }
 
 /**
@@ -50,7 +55,8 @@ inline bool operator>(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator>(Arith a, const var& b) {
-  return a > b.val();
+  return internal::record_branch(internal::scalar_cmp::gt,
+                                 static_cast<double>(a), b.vi_, a > b.val());
 }
 
 }  // namespace math
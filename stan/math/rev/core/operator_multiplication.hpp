@@ -9,6 +9,7 @@
 #include <stan/math/rev/core/operator_minus_equal.hpp>
 #include <stan/math/rev/core/vv_vari.hpp>
 #include <stan/math/rev/core/vd_vari.hpp>
+#include <stan/math/rev/core/scalar_op_tape.hpp>
 #include <stan/math/prim/core/operator_multiplication.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_any_nan.hpp>
@@ -74,7 +75,12 @@ class multiply_vd_vari final : public op_vd_vari {
  * @return Variable result of multiplying operands.
  */
 inline var operator*(const var& a, const var& b) {
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::multiply_vv,
+                                   a.vi_->val_ * b.vi_->val_, a.vi_, b.vi_)};
+#else
   return {new internal::multiply_vv_vari(a.vi_, b.vi_)};
+#endif
 }
 
 /**
@@ -94,7 +100,13 @@ inline var operator*(const var& a, Arith b) {
   if (b == 1.0) {
     return a;
   }
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::multiply_vd,
+                                   a.vi_->val_ * b, a.vi_,
+                                   static_cast<double>(b))};
+#else
   return {new internal::multiply_vd_vari(a.vi_, b)};
+#endif
 }
 
 /**
@@ -114,7 +126,13 @@ inline var operator*(Arith a, const var& b) {
   if (a == 1.0) {
     return b;
   }
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::multiply_vd,
+                                   b.vi_->val_ * a, b.vi_,
+                                   static_cast<double>(a))};
+#else
   return {new internal::multiply_vd_vari(b.vi_, a)};  // by symmetry
+#endif
 }
 
 /**
@@ -4,6 +4,7 @@
 #include <stan/math/rev/core/std_complex.hpp>
 #include <stan/math/rev/core/operator_equal.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/scalar_op_tape.hpp>
 #include <stan/math/prim/meta.hpp>
 #include <complex>
 
@@ -28,7 +29,8 @@ namespace math {
  * second's.
  */
 inline bool operator!=(const var& a, const var& b) {
-  return a.val() != b.val();
+  return internal::record_branch(internal::scalar_cmp::ne, a.vi_, b.vi_,
+                                 a.val() != b.val());
 }
 
 /**
@@ -43,7 +45,8 @@ inline bool operator!=(const var& a, const var& b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator!=(const var& a, Arith b) {
-  return a.val() != b;
+  return internal::record_branch(internal::scalar_cmp::ne, a.vi_,
+                                 static_cast<double>(b), a.val() != b);
 }
 
 /**
@@ -58,7 +61,8 @@ inline bool operator!=(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator!=(Arith a, const var& b) {
-  return a != b.val();
+  return internal::record_branch(internal::scalar_cmp::ne,
+                                 static_cast<double>(a), b.vi_, a != b.val());
 }
 
 /**
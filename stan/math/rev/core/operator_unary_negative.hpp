@@ -4,6 +4,7 @@
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
+#include <stan/math/rev/core/scalar_op_tape.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_nan.hpp>
 
@@ -35,8 +36,13 @@ namespace math {
  * @return Negation of variable.
  */
 inline var operator-(const var& a) {
+#ifdef STAN_SCALAR_OP_TAPE
+  return {
+      internal::push_scalar_op(internal::scalar_op::negate_v, -a.val(), a.vi_)};
+#else
   return make_callback_var(
       -a.val(), [a](const auto& vi) mutable { a.adj() -= vi.adj(); });
+#endif
 }
 
 /**
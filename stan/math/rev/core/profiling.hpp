@@ -7,6 +7,7 @@
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/fun/value_of.hpp>
 #include <stan/math/prim/err.hpp>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <thread>
@@ -16,6 +17,14 @@ namespace math {
 
 /**
  * Class used for storing profiling information.
+ *
+ * Besides times and the number of vars created, the forward passes of
+ * reverse mode profiles record the memory used by the autodiff stack:
+ * the arena bytes used, the peak arena usage of a single pass, the
+ * number of arena blocks, the number of <code>chainable_alloc</code>
+ * objects and the number of heap allocations made for the arena blocks
+ * and <code>chainable_alloc</code> objects.  Heap allocations made by
+ * other code, such as Eigen temporaries, are not counted.
  */
 class profile_info {
  private:
@@ -28,10 +37,19 @@ class profile_info {
   size_t n_rev_passes_;
   size_t chain_stack_size_sum_;
   size_t nochain_stack_size_sum_;
+  size_t alloc_stack_size_sum_;
+  size_t arena_bytes_sum_;
+  size_t arena_peak_bytes_;
+  size_t arena_blocks_;
+  size_t arena_block_allocations_sum_;
   std::chrono::time_point<std::chrono::steady_clock> fwd_pass_tp_;
   std::chrono::time_point<std::chrono::steady_clock> rev_pass_tp_;
   size_t start_chain_stack_size_;
   size_t start_nochain_stack_size_;
+  size_t start_alloc_stack_size_;
+  size_t start_arena_bytes_;
+  size_t start_arena_peak_bytes_;
+  size_t start_arena_block_allocations_;
 
  public:
   profile_info()
@@ -43,10 +61,19 @@ class profile_info {
         n_rev_passes_(0),
         chain_stack_size_sum_(0),
         nochain_stack_size_sum_(0),
+        alloc_stack_size_sum_(0),
+        arena_bytes_sum_(0),
+        arena_peak_bytes_(0),
+        arena_blocks_(0),
+        arena_block_allocations_sum_(0),
         fwd_pass_tp_(std::chrono::steady_clock::now()),
         rev_pass_tp_(std::chrono::steady_clock::now()),
         start_chain_stack_size_(0),
-        start_nochain_stack_size_(0) {}
+        start_nochain_stack_size_(0),
+        start_alloc_stack_size_(0),
+        start_arena_bytes_(0),
+        start_arena_peak_bytes_(0),
+        start_arena_block_allocations_(0) {}
 
   bool is_active() const noexcept { return active_; }
 
@@ -56,6 +83,12 @@ class profile_info {
       start_chain_stack_size_ = ChainableStack::instance_->var_stack_.size();
       start_nochain_stack_size_
           = ChainableStack::instance_->var_nochain_stack_.size();
+      const auto& memalloc = ChainableStack::instance_->memalloc_;
+      start_alloc_stack_size_
+          = ChainableStack::instance_->var_alloc_stack_.size();
+      start_arena_bytes_ = memalloc.bytes_used();
+      start_arena_peak_bytes_ = memalloc.peak_bytes_used();
+      start_arena_block_allocations_ = memalloc.num_block_allocations();
     }
     fwd_pass_tp_ = std::chrono::steady_clock::now();
     active_ = true;
@@ -70,6 +103,22 @@ class profile_info {
       nochain_stack_size_sum_
           += (ChainableStack::instance_->var_nochain_stack_.size()
               - start_nochain_stack_size_);
+      const auto& memalloc = ChainableStack::instance_->memalloc_;
+      alloc_stack_size_sum_
+          += (ChainableStack::instance_->var_alloc_stack_.size()
+              - start_alloc_stack_size_);
+      const size_t arena_bytes = memalloc.bytes_used();
+      arena_bytes_sum_ += arena_bytes - start_arena_bytes_;
+      // the peak includes nested regions recovered during the pass, but
+      // only counts for this pass if the pass raised it
+      const size_t peak_bytes = memalloc.peak_bytes_used();
+      const size_t pass_peak_bytes
+          = (peak_bytes > start_arena_peak_bytes_ ? peak_bytes : arena_bytes)
+            - start_arena_bytes_;
+      arena_peak_bytes_ = std::max(arena_peak_bytes_, pass_peak_bytes);
+      arena_blocks_ = std::max(arena_blocks_, memalloc.num_blocks());
+      arena_block_allocations_sum_ += memalloc.num_block_allocations()
+                                      - start_arena_block_allocations_;
     } else {
       n_fwd_no_AD_passes_++;
     }
@@ -96,6 +145,39 @@ class profile_info {
     return nochain_stack_size_sum_;
   };
 
+  /**
+   * Return the number of <code>chainable_alloc</code> objects created
+   * in all forward passes.
+   */
+  size_t get_alloc_stack_used() const noexcept {
+    return alloc_stack_size_sum_;
+  }
+
+  /**
+   * Return the number of arena bytes used in all forward passes.
+   */
+  size_t get_arena_bytes_used() const noexcept { return arena_bytes_sum_; }
+
+  /**
+   * Return the largest number of arena bytes in use at once during a
+   * single forward pass, including nested autodiff.
+   */
+  size_t get_arena_peak_bytes() const noexcept { return arena_peak_bytes_; }
+
+  /**
+   * Return the largest number of blocks held by the arena at the end of
+   * a forward pass.
+   */
+  size_t get_arena_blocks() const noexcept { return arena_blocks_; }
+
+  /**
+   * Return the number of heap allocations made in all forward passes
+   * for arena blocks and <code>chainable_alloc</code> objects.
+   */
+  size_t get_num_heap_allocations() const noexcept {
+    return arena_block_allocations_sum_ + alloc_stack_size_sum_;
+  }
+
   size_t get_num_no_AD_fwd_passes() const noexcept {
     return n_fwd_no_AD_passes_;
   }
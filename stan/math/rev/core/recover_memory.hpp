@@ -12,6 +12,10 @@ namespace math {
 /**
  * Recover memory used for all variables for reuse.
  *
+ * The arena and the stacks are then sized for the largest of the
+ * recently recovered tapes, so that repeated gradient evaluations of
+ * about the same size do not allocate.
+ *
  * @throw std::logic_error if <code>empty_nested()</code> returns
  * <code>false</code>
  */
@@ -21,6 +25,7 @@ static inline void recover_memory() {
         "empty_nested() must be true"
         " before calling recover_memory()");
   }
+  ChainableStack::instance_->record_tape_size();
   ChainableStack::instance_->var_stack_.clear();
   ChainableStack::instance_->var_nochain_stack_.clear();
   for (auto &x : ChainableStack::instance_->var_alloc_stack_) {
@@ -28,6 +33,8 @@ static inline void recover_memory() {
   }
   ChainableStack::instance_->var_alloc_stack_.clear();
   ChainableStack::instance_->memalloc_.recover_all();
+  ChainableStack::instance_->scalar_op_segment_ = nullptr;
+  ChainableStack::instance_->fit_to_recent_tapes();
 }
 
 }  // namespace math
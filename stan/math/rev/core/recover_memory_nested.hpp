@@ -27,6 +27,20 @@ static inline void recover_memory_nested() {
         " before calling recover_memory_nested()");
   }
 
+  // recovering a nested region started on an empty tape recovers the
+  // whole tape
+  const bool whole_tape
+      = ChainableStack::instance_->nested_var_stack_sizes_.size() == 1
+        && ChainableStack::instance_->nested_var_stack_sizes_.back() == 0
+        && ChainableStack::instance_->nested_var_nochain_stack_sizes_.back()
+               == 0
+        && ChainableStack::instance_->nested_var_alloc_stack_starts_.back()
+               == 0
+        && ChainableStack::instance_->memalloc_.nested_starts_empty();
+  if (whole_tape) {
+    ChainableStack::instance_->record_tape_size();
+  }
+
   ChainableStack::instance_->var_stack_.resize(
       ChainableStack::instance_->nested_var_stack_sizes_.back());
   ChainableStack::instance_->nested_var_stack_sizes_.pop_back();
@@ -45,6 +59,10 @@ static inline void recover_memory_nested() {
   ChainableStack::instance_->nested_var_alloc_stack_starts_.pop_back();
 
   ChainableStack::instance_->memalloc_.recover_nested();
+  ChainableStack::instance_->scalar_op_segment_ = nullptr;
+  if (whole_tape) {
+    ChainableStack::instance_->fit_to_recent_tapes();
+  }
 }
 
 }  // namespace math
@@ -0,0 +1,379 @@
+#ifndef STAN_MATH_REV_CORE_SCALAR_OP_TAPE_HPP
+#define STAN_MATH_REV_CORE_SCALAR_OP_TAPE_HPP
+
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Opcodes of the scalar operations which can be recorded on a
+ * <code>scalar_op_segment</code>.  The suffix gives the operand types,
+ * <code>v</code> for a variable and <code>d</code> for a double.
+ */
+enum class scalar_op : unsigned char {
+  add_vv,
+  add_vd,
+  subtract_vv,
+  subtract_vd,
+  subtract_dv,
+  multiply_vv,
+  multiply_vd,
+  divide_vv,
+  divide_vd,
+  divide_dv,
+  negate_v,
+  exp_v,
+  log_v,
+  sqrt_v,
+  square_v
+};
+
+/**
+ * Return true if the second operand of the operation is a variable.
+ *
+ * @param op opcode
+ * @return true for operations of two variables
+ */
+inline bool is_binary_vv(scalar_op op) {
+  return op == scalar_op::add_vv || op == scalar_op::subtract_vv
+         || op == scalar_op::multiply_vv || op == scalar_op::divide_vv;
+}
+
+/**
+ * Return the value of a scalar operation.  For <code>subtract_dv</code>
+ * and <code>divide_dv</code> the constant is the first operand of the
+ * operation and is passed as <code>b</code>.
+ *
+ * @param op opcode
+ * @param a value of the variable operand
+ * @param b value of the second operand
+ * @return value of the operation
+ */
+inline double scalar_op_value(scalar_op op, double a, double b) {
+  switch (op) {
+    case scalar_op::add_vv:
+    case scalar_op::add_vd:
+      return a + b;
+    case scalar_op::subtract_vv:
+    case scalar_op::subtract_vd:
+      return a - b;
+    case scalar_op::subtract_dv:
+      return b - a;
+    case scalar_op::multiply_vv:
+    case scalar_op::multiply_vd:
+      return a * b;
+    case scalar_op::divide_vv:
+    case scalar_op::divide_vd:
+      return a / b;
+    case scalar_op::divide_dv:
+      return b / a;
+    case scalar_op::negate_v:
+      return -a;
+    case scalar_op::exp_v:
+      return std::exp(a);
+    case scalar_op::log_v:
+      return std::log(a);
+    case scalar_op::sqrt_v:
+      return std::sqrt(a);
+    case scalar_op::square_v:
+      return a * a;
+  }
+  return 0;
+}
+
+/**
+ * Second operand of a recorded scalar operation, either a variable or
+ * a constant, as determined by the opcode.
+ */
+union scalar_op_operand {
+  vari* vi_;
+  double d_;
+};
+
+/**
+ * A run of scalar operations recorded as a structure of arrays and
+ * placed on the autodiff stack as a single node.
+ *
+ * Each recorded operation has an opcode, its result, its variable
+ * operand and a second operand which is a variable or a constant.
+ * The results are plain <code>vari</code> constructed in the segment's
+ * result array and kept off the chain stack; instead the segment's
+ * <code>chain()</code> method runs the chain rule for all of its
+ * operations in one switch-dispatched loop, replacing one virtual
+ * call per operation by one per segment.
+ *
+ * Segments interleave with arbitrary other <code>vari</code> on the
+ * stack.  Operations are only appended to a segment while it is the
+ * last node on the stack, so the reverse sweep order is the same as
+ * if every operation had its own node.
+ *
+ * When <code>STAN_SCALAR_OP_TAPE</code> is defined the scalar
+ * arithmetic operators and <code>exp</code>, <code>log</code>,
+ * <code>sqrt</code> and <code>square</code> of <code>var</code> record
+ * themselves on segments.  As the macro changes the bodies of these
+ * inline functions and adds a non-template overload of <code>log()</code>,
+ * it has to be defined for all or none of the translation units of a
+ * program.
+ */
+class scalar_op_segment final : public vari_base {
+ public:
+  static constexpr size_t capacity = 128;
+
+  scalar_op* ops_;
+  vari* res_;
+  vari** a_;
+  scalar_op_operand* b_;
+  size_t size_;
+
+  scalar_op_segment()
+      : ops_(ChainableStack::instance_->memalloc_.alloc_array<scalar_op>(
+            capacity)),
+        res_(ChainableStack::instance_->memalloc_.alloc_array<vari>(capacity)),
+        a_(ChainableStack::instance_->memalloc_.alloc_array<vari*>(capacity)),
+        b_(ChainableStack::instance_->memalloc_
+               .alloc_array<scalar_op_operand>(capacity)),
+        size_(0) {
+    ChainableStack::instance_->var_stack_.push_back(this);
+  }
+
+  inline bool full() const { return size_ == capacity; }
+
+  inline vari* push(scalar_op op, double val, vari* a, scalar_op_operand b) {
+    ops_[size_] = op;
+    a_[size_] = a;
+    b_[size_] = b;
+    return ::new (&res_[size_++]) vari(val, false);
+  }
+
+  inline void chain() final {
+    for (size_t i = size_; i-- > 0;) {
+      const double adj = res_[i].adj_;
+      vari* a = a_[i];
+      switch (ops_[i]) {
+        case scalar_op::add_vv:
+          a->adj_ += adj;
+          b_[i].vi_->adj_ += adj;
+          break;
+        case scalar_op::add_vd:
+          a->adj_ += adj;
+          break;
+        case scalar_op::subtract_vv:
+          a->adj_ += adj;
+          b_[i].vi_->adj_ -= adj;
+          break;
+        case scalar_op::subtract_vd:
+          a->adj_ += adj;
+          break;
+        case scalar_op::subtract_dv:
+          a->adj_ -= adj;
+          break;
+        case scalar_op::multiply_vv:
+          a->adj_ += b_[i].vi_->val_ * adj;
+          b_[i].vi_->adj_ += a->val_ * adj;
+          break;
+        case scalar_op::multiply_vd:
+          a->adj_ += adj * b_[i].d_;
+          break;
+        case scalar_op::divide_vv: {
+          vari* b = b_[i].vi_;
+          a->adj_ += adj / b->val_;
+          b->adj_ -= adj * a->val_ / (b->val_ * b->val_);
+          break;
+        }
+        case scalar_op::divide_vd:
+          a->adj_ += adj / b_[i].d_;
+          break;
+        case scalar_op::divide_dv:
+          a->adj_ -= adj * b_[i].d_ / (a->val_ * a->val_);
+          break;
+        case scalar_op::negate_v:
+          a->adj_ -= adj;
+          break;
+        case scalar_op::exp_v:
+          a->adj_ += adj * res_[i].val_;
+          break;
+        case scalar_op::log_v:
+          a->adj_ += adj / a->val_;
+          break;
+        case scalar_op::sqrt_v:
+          a->adj_ += adj / (2.0 * res_[i].val_);
+          break;
+        case scalar_op::square_v:
+          a->adj_ += adj * 2.0 * a->val_;
+          break;
+      }
+    }
+  }
+
+  inline void set_zero_adjoint() final {}
+};
+
+/**
+ * Record a scalar operation on the current segment of the autodiff
+ * stack, starting a new segment if the last node on the stack is not
+ * an open segment of the current nesting level.
+ *
+ * @param op opcode
+ * @param val value of the result
+ * @param a variable operand; for <code>subtract_dv</code> and
+ * <code>divide_dv</code> this is the second operand
+ * @param b second operand; for <code>subtract_dv</code> and
+ * <code>divide_dv</code> this is the constant first operand
+ * @return result of the operation
+ */
+inline vari* push_scalar_op(scalar_op op, double val, vari* a,
+                            scalar_op_operand b) {
+  auto* stack = ChainableStack::instance_;
+  scalar_op_segment* segment
+      = static_cast<scalar_op_segment*>(stack->scalar_op_segment_);
+  if (segment == nullptr || segment->full() || stack->var_stack_.empty()
+      || stack->var_stack_.back() != segment) {
+    segment = new scalar_op_segment();
+    stack->scalar_op_segment_ = segment;
+  }
+  return segment->push(op, val, a, b);
+}
+
+inline vari* push_scalar_op(scalar_op op, double val, vari* a, vari* b) {
+  scalar_op_operand operand;
+  operand.vi_ = b;
+  return push_scalar_op(op, val, a, operand);
+}
+
+inline vari* push_scalar_op(scalar_op op, double val, vari* a, double b) {
+  scalar_op_operand operand;
+  operand.d_ = b;
+  return push_scalar_op(op, val, a, operand);
+}
+
+inline vari* push_scalar_op(scalar_op op, double val, vari* a) {
+  return push_scalar_op(op, val, a, 0.0);
+}
+
+/**
+ * Comparisons of variables whose outcome can be recorded, so that a
+ * recorded tape can detect when it would take a different branch.
+ */
+enum class scalar_cmp : unsigned char { lt, le, gt, ge, eq, ne };
+
+/**
+ * A recorded comparison.  Each operand is a variable, or a constant
+ * if its <code>vari</code> pointer is null.
+ */
+struct scalar_cmp_record {
+  scalar_cmp cmp_;
+  vari* a_;
+  vari* b_;
+  double a_d_;
+  double b_d_;
+  bool result_;
+};
+
+/**
+ * Return the outcome of a comparison of two values.
+ *
+ * @param cmp comparison
+ * @param a first value
+ * @param b second value
+ * @return outcome of comparison
+ */
+inline bool scalar_cmp_value(scalar_cmp cmp, double a, double b) {
+  switch (cmp) {
+    case scalar_cmp::lt:
+      return a < b;
+    case scalar_cmp::le:
+      return a <= b;
+    case scalar_cmp::gt:
+      return a > b;
+    case scalar_cmp::ge:
+      return a >= b;
+    case scalar_cmp::eq:
+      return a == b;
+    case scalar_cmp::ne:
+      return a != b;
+  }
+  return false;
+}
+
+/**
+ * Return a reference to the log of comparisons of the current thread,
+ * which is null unless a tape is being recorded.
+ */
+inline std::vector<scalar_cmp_record>*& scalar_cmp_log() {
+  static STAN_THREADS_DEF std::vector<scalar_cmp_record>* log = nullptr;
+  return log;
+}
+
+/**
+ * Return a reference to the flag of the current thread which is set
+ * when the tape being recorded can not be replayed.
+ */
+inline bool& scalar_cmp_unreplayable() {
+  static STAN_THREADS_DEF bool unreplayable = false;
+  return unreplayable;
+}
+
+/**
+ * Mark the tape being recorded, if any, as not replayable.  Called by
+ * operations which create a constant from the value of a variable,
+ * such as <code>floor()</code>, since no recorded comparison can check
+ * that the constant still holds.  Compiled in only when
+ * <code>STAN_SCALAR_OP_TAPE</code> is defined.
+ */
+inline void record_unreplayable() {
+#ifdef STAN_SCALAR_OP_TAPE
+  if (unlikely(scalar_cmp_log() != nullptr)) {
+    scalar_cmp_unreplayable() = true;
+  }
+#endif
+}
+
+/**
+ * Return the outcome of a comparison of variables, logging it if a
+ * tape is being recorded.  Logging is compiled in only when
+ * <code>STAN_SCALAR_OP_TAPE</code> is defined.
+ *
+ * @param cmp comparison
+ * @param a first operand
+ * @param b second operand
+ * @param result outcome of the comparison
+ * @return <code>result</code>
+ */
+inline bool record_branch(scalar_cmp cmp, vari* a, vari* b, bool result) {
+#ifdef STAN_SCALAR_OP_TAPE
+  if (unlikely(scalar_cmp_log() != nullptr)) {
+    scalar_cmp_log()->push_back({cmp, a, b, 0.0, 0.0, result});
+  }
+#endif
+  return result;
+}
+
+inline bool record_branch(scalar_cmp cmp, vari* a, double b, bool result) {
+#ifdef STAN_SCALAR_OP_TAPE
+  if (unlikely(scalar_cmp_log() != nullptr)) {
+    scalar_cmp_log()->push_back({cmp, a, nullptr, 0.0, b, result});
+  }
+#endif
+  return result;
+}
+
+inline bool record_branch(scalar_cmp cmp, double a, vari* b, bool result) {
+#ifdef STAN_SCALAR_OP_TAPE
+  if (unlikely(scalar_cmp_log() != nullptr)) {
+    scalar_cmp_log()->push_back({cmp, nullptr, b, a, 0.0, result});
+  }
+#endif
+  return result;
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
@@ -21,6 +21,7 @@ static inline void start_nested() {
   ChainableStack::instance_->nested_var_alloc_stack_starts_.push_back(
       ChainableStack::instance_->var_alloc_stack_.size());
   ChainableStack::instance_->memalloc_.start_nested();
+  ChainableStack::instance_->scalar_op_segment_ = nullptr;
 }
 
 }  // namespace math
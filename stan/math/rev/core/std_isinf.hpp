@@ -1,7 +1,9 @@
 #ifndef STAN_MATH_REV_CORE_STD_ISINF_HPP
 #define STAN_MATH_REV_CORE_STD_ISINF_HPP
 
+#include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_inf.hpp>
+#include <stan/math/rev/core/scalar_op_tape.hpp>
 #include <stan/math/rev/core/var.hpp>
 
 namespace std {
@@ -14,7 +16,14 @@ namespace std {
  * @return 1 if argument is infinite and 0 otherwise.
  */
 inline bool isinf(const stan::math::var& a) {
-  return stan::math::is_inf(a.val());
+  using stan::math::internal::record_branch;
+  using stan::math::internal::scalar_cmp;
+  const bool pos = record_branch(scalar_cmp::eq, a.vi_, stan::math::INFTY,
+                                 a.val() == stan::math::INFTY);
+  const bool neg
+      = record_branch(scalar_cmp::eq, a.vi_, stan::math::NEGATIVE_INFTY,
+                      a.val() == stan::math::NEGATIVE_INFTY);
+  return pos || neg;
 }
 
 }  // namespace std
@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_STD_ISNAN_HPP
 #define STAN_MATH_REV_CORE_STD_ISNAN_HPP
 
+#include <stan/math/rev/core/scalar_op_tape.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <cmath>
 
@@ -15,7 +16,10 @@ namespace std {
  * @param a Variable to test.
  * @return <code>true</code> if value is not a number.
  */
-inline bool isnan(const stan::math::var& a) { return isnan(a.val()); }
+inline bool isnan(const stan::math::var& a) {
+  return stan::math::internal::record_branch(
+      stan::math::internal::scalar_cmp::ne, a.vi_, a.vi_, isnan(a.val()));
+}
 
 }  // namespace std
 #endif
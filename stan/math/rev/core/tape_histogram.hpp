@@ -0,0 +1,116 @@
+#ifndef STAN_MATH_REV_CORE_TAPE_HISTOGRAM_HPP
+#define STAN_MATH_REV_CORE_TAPE_HISTOGRAM_HPP
+
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <boost/core/demangle.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Number of <code>chain()</code> calls made for one type of vari by
+ * <code>grad()</code> and their total run time in seconds.
+ */
+struct chain_stats {
+  size_t count_{0};
+  double time_{0.0};
+};
+
+using tape_histogram_map = std::unordered_map<std::type_index, chain_stats>;
+
+/**
+ * Return the histogram of <code>chain()</code> calls by vari type
+ * recorded by <code>grad()</code> on the current thread.
+ *
+ * The histogram is only recorded if <code>STAN_TAPE_HISTOGRAM</code>
+ * is defined, as timing every <code>chain()</code> call slows down the
+ * reverse pass considerably.  Otherwise it stays empty.
+ *
+ * @return histogram of the current thread
+ */
+inline tape_histogram_map& tape_histogram() {
+  static thread_local tape_histogram_map histogram;
+  return histogram;
+}
+
+/**
+ * Clear the histogram of <code>chain()</code> calls of the current
+ * thread.
+ */
+inline void reset_tape_histogram() { tape_histogram().clear(); }
+
+namespace internal {
+
+/**
+ * Call <code>chain()</code> on the specified vari and add the call and
+ * its run time to the histogram of the current thread.
+ *
+ * @param vi vari to chain
+ */
+inline void timed_chain(vari_base* vi) {
+  const auto start = std::chrono::steady_clock::now();
+  vi->chain();
+  const auto end = std::chrono::steady_clock::now();
+  chain_stats& stats = tape_histogram()[std::type_index(typeid(*vi))];
+  ++stats.count_;
+  stats.time_ += std::chrono::duration<double>(end - start).count();
+}
+
+}  // namespace internal
+
+/**
+ * Prints the histogram of <code>chain()</code> calls of the current
+ * thread, one line per vari type with the number of calls, their total
+ * time in milliseconds and its share of the total, sorted by
+ * decreasing time.
+ *
+ * Nothing is recorded unless <code>STAN_TAPE_HISTOGRAM</code> is
+ * defined.
+ *
+ * @param o ostream to modify
+ */
+inline void print_tape_histogram(std::ostream& o) {
+  std::vector<std::pair<std::string, chain_stats>> rows;
+  double total_time = 0.0;
+  size_t total_count = 0;
+  for (const auto& entry : tape_histogram()) {
+    rows.emplace_back(boost::core::demangle(entry.first.name()),
+                      entry.second);
+    total_time += entry.second.time_;
+    total_count += entry.second.count_;
+  }
+  std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+    return a.second.time_ > b.second.time_;
+  });
+  const std::ios_base::fmtflags flags = o.flags();
+  const std::streamsize precision = o.precision();
+  o << std::fixed << std::setprecision(3);
+  o << "TAPE HISTOGRAM, types=" << rows.size() << ", chain calls="
+    << total_count << ", chain time=" << 1e3 * total_time << "ms"
+    << std::endl;
+  for (const auto& row : rows) {
+    const double share
+        = total_time > 0 ? 100.0 * row.second.time_ / total_time : 0.0;
+    o << std::setw(12) << row.second.count_ << std::setw(12)
+      << 1e3 * row.second.time_ << "ms" << std::setw(8)
+      << std::setprecision(1) << share << "%" << std::setprecision(3)
+      << "  " << row.first << std::endl;
+  }
+  o.flags(flags);
+  o.precision(precision);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,260 @@
+#ifndef STAN_MATH_REV_CORE_TAPE_SEGMENTS_HPP
+#define STAN_MATH_REV_CORE_TAPE_SEGMENTS_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/count_vars.hpp>
+#include <stan/math/rev/core/deep_copy_vars.hpp>
+#include <stan/math/rev/core/save_varis.hpp>
+#include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Node which takes the place of a set of independent tape segments
+ * on the autodiff stack and runs their reverse sweeps concurrently.
+ *
+ * The varis of segment <code>s</code> are
+ * <code>varis_[starts_[s]]</code> to
+ * <code>varis_[starts_[s + 1] - 1]</code> in the order in which they
+ * were created.  Once all segments are chained the adjoints of the
+ * segment-local copies of shared variables are added to the variables
+ * they were copied from.
+ */
+class tape_segments_vari final : public vari_base {
+ public:
+  size_t num_segments_;
+  size_t* starts_;
+  vari_base** varis_;
+  size_t num_locals_;
+  vari** locals_;
+  vari** parents_;
+
+  tape_segments_vari(size_t num_segments, size_t* starts, vari_base** varis,
+                     size_t num_locals, vari** locals, vari** parents)
+      : num_segments_(num_segments),
+        starts_(starts),
+        varis_(varis),
+        num_locals_(num_locals),
+        locals_(locals),
+        parents_(parents) {
+    ChainableStack::instance_->var_stack_.push_back(this);
+  }
+
+  inline void chain() final {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_segments_, 1),
+                      [this](const tbb::blocked_range<size_t>& r) {
+                        for (size_t s = r.begin(); s != r.end(); ++s) {
+                          for (size_t i = starts_[s + 1]; i-- > starts_[s];) {
+                            varis_[i]->chain();
+                          }
+                        }
+                      });
+    for (size_t i = 0; i < num_locals_; ++i) {
+      parents_[i]->adj_ += locals_[i]->adj_;
+    }
+  }
+
+  inline void set_zero_adjoint() final {
+    for (size_t i = 0; i < starts_[num_segments_]; ++i) {
+      varis_[i]->set_zero_adjoint();
+    }
+  }
+};
+
+}  // namespace internal
+
+/**
+ * Records independent segments of the autodiff tape whose reverse
+ * sweeps run concurrently on the TBB thread pool.
+ *
+ * Many log densities are sums of terms which share only a few
+ * parameters, such as the likelihood contributions of the groups of
+ * a hierarchical model.  The subgraph of each term is recorded as a
+ * segment between calls to <code>begin()</code> and
+ * <code>end()</code>.  Variables created before the segment which are
+ * used in it must be copied into it with <code>local()</code>, so that
+ * no two segments write to the same adjoint.  After the last segment
+ * <code>join()</code> moves the varis of all segments off the stack
+ * and replaces them by a single node, whose <code>chain()</code>
+ * method chains the segments in parallel and then adds the adjoints of
+ * the local copies to the shared variables.  For example
+ *
+ *     tape_segments segments;
+ *     std::vector<var> terms(G);
+ *     for (int g = 0; g < G; ++g) {
+ *       segments.begin();
+ *       var mu_g = segments.local(mu);
+ *       terms[g] = normal_lpdf(y[g], mu_g, sigma[g]);
+ *       segments.end();
+ *     }
+ *     segments.join();
+ *     var lp = sum(terms);
+ *
+ * A segment may create and use any variables of its own, but the
+ * <code>chain()</code> methods of its varis must not use the autodiff
+ * stack, as they may run on another thread.  The results of the
+ * segments must only be used after <code>join()</code>.  Until
+ * <code>join()</code> is called the segments are ordinary parts of the
+ * tape, but the adjoints of local copies are only propagated by the
+ * node it creates.
+ */
+class tape_segments {
+  size_t nesting_;
+  bool open_{false};
+  bool joined_{false};
+  std::vector<std::pair<size_t, size_t>> ranges_;
+  std::vector<vari*> locals_;
+  std::vector<vari*> parents_;
+
+  inline void check_nesting(const char* function) const {
+    if (ChainableStack::instance_->nested_var_stack_sizes_.size()
+        != nesting_) {
+      throw std::logic_error(std::string(function)
+                             + ": tape segments must be recorded and joined"
+                               " at the nesting level they were created at");
+    }
+  }
+
+ public:
+  tape_segments()
+      : nesting_(ChainableStack::instance_->nested_var_stack_sizes_.size()) {}
+
+  // Prevent undesirable operations
+  tape_segments(const tape_segments&) = delete;
+  tape_segments& operator=(const tape_segments&) = delete;
+  void* operator new(std::size_t) = delete;
+
+  /**
+   * Start a new segment at the end of the tape.
+   *
+   * @throw std::logic_error if a segment is open or the segments have
+   * been joined
+   */
+  inline void begin() {
+    check_nesting("tape_segments::begin");
+    if (open_ || joined_) {
+      throw std::logic_error(
+          "tape_segments::begin: a segment is open or the segments have"
+          " been joined");
+    }
+    auto* stack = ChainableStack::instance_;
+    stack->scalar_op_segment_ = nullptr;
+    ranges_.emplace_back(stack->var_stack_.size(), 0);
+    open_ = true;
+  }
+
+  /**
+   * End the open segment.
+   *
+   * @throw std::logic_error if no segment is open
+   */
+  inline void end() {
+    check_nesting("tape_segments::end");
+    if (!open_) {
+      throw std::logic_error("tape_segments::end: no segment is open");
+    }
+    auto* stack = ChainableStack::instance_;
+    stack->scalar_op_segment_ = nullptr;
+    ranges_.back().second = stack->var_stack_.size();
+    open_ = false;
+  }
+
+  /**
+   * Return a copy of the specified variables which is local to the open
+   * segment.  The adjoints of the copy are added to those of the
+   * variables when the segments are chained.
+   *
+   * @tparam T type of variables, a <code>var</code> or a standard or
+   * Eigen container of them
+   * @param x variables created outside of the segment
+   * @return copy of the variables
+   * @throw std::logic_error if no segment is open
+   */
+  template <typename T>
+  inline auto local(const T& x) {
+    if (!open_) {
+      throw std::logic_error("tape_segments::local: no segment is open");
+    }
+    auto copy = deep_copy_vars(x);
+    const size_t n = count_vars(x);
+    const size_t offset = locals_.size();
+    parents_.resize(offset + n);
+    locals_.resize(offset + n);
+    save_varis(parents_.data() + offset, x);
+    save_varis(locals_.data() + offset, copy);
+    return copy;
+  }
+
+  /**
+   * Replace the segments on the tape by a single node which chains
+   * them concurrently.  Must be called right after the last segment
+   * ends, before any of its results are used.
+   *
+   * @throw std::logic_error if a segment is open, if the tape has grown
+   * since the last segment ended or if the segments have been joined
+   */
+  inline void join() {
+    check_nesting("tape_segments::join");
+    auto* stack = ChainableStack::instance_;
+    auto& var_stack = stack->var_stack_;
+    if (open_ || joined_
+        || (!ranges_.empty() && ranges_.back().second != var_stack.size())) {
+      throw std::logic_error(
+          "tape_segments::join: must be called once, right after the last"
+          " segment ends");
+    }
+    joined_ = true;
+    if (ranges_.empty()) {
+      return;
+    }
+    auto& memalloc = stack->memalloc_;
+    const size_t num_segments = ranges_.size();
+    size_t* starts = memalloc.alloc_array<size_t>(num_segments + 1);
+    starts[0] = 0;
+    for (size_t s = 0; s < num_segments; ++s) {
+      starts[s + 1] = starts[s] + (ranges_[s].second - ranges_[s].first);
+    }
+    vari_base** varis = memalloc.alloc_array<vari_base*>(starts[num_segments]);
+    // move the segments off the stack, keeping what lies between them
+    const size_t first = ranges_.front().first;
+    size_t kept = first;
+    for (size_t s = 0; s < num_segments; ++s) {
+      std::copy(var_stack.begin() + ranges_[s].first,
+                var_stack.begin() + ranges_[s].second, varis + starts[s]);
+      const size_t gap_end = s + 1 < num_segments ? ranges_[s + 1].first
+                                                  : var_stack.size();
+      for (size_t i = ranges_[s].second; i < gap_end; ++i) {
+        var_stack[kept++] = var_stack[i];
+      }
+    }
+    var_stack.resize(kept);
+    const size_t num_locals = locals_.size();
+    vari** locals = memalloc.alloc_array<vari*>(num_locals);
+    vari** parents = memalloc.alloc_array<vari*>(num_locals);
+    std::copy(locals_.begin(), locals_.end(), locals);
+    std::copy(parents_.begin(), parents_.end(), parents);
+    new internal::tape_segments_vari(num_segments, starts, varis, num_locals,
+                                     locals, parents);
+    stack->scalar_op_segment_ = nullptr;
+  }
+
+  /**
+   * Return the number of segments recorded.
+   */
+  inline size_t size() const { return ranges_.size(); }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -44,7 +44,11 @@ namespace math {
  * @param a Input variable.
  * @return Ceiling of the variable.
  */
-inline var ceil(const var& a) { return var(std::ceil(a.val())); }
+inline var ceil(const var& a) {
+  // the result is a constant which replaying a tape would not update
+  internal::record_unreplayable();
+  return var(std::ceil(a.val()));
+}
 
 template <typename T, require_matrix_t<T>* = nullptr>
 inline auto ceil(const var_value<T>& a) {
@@ -40,9 +40,14 @@ namespace math {
  * @return Exponentiated variable.
  */
 inline var exp(const var& a) {
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::exp_v,
+                                   std::exp(a.val()), a.vi_)};
+#else
   return make_callback_var(std::exp(a.val()), [a](auto& vi) mutable {
     a.adj() += vi.adj() * vi.val();
   });
+#endif
 }
 
 /**
@@ -89,9 +89,9 @@ class fdim_dv_vari : public op_dv_vari {
  * variable.
  */
 inline var fdim(const var& a, const var& b) {
-  // reversed test to get NaN vals automatically in second case
-  return (a.vi_->val_ <= b.vi_->val_)
-             ? var(new vari(0.0))
+  // reversed test to get NaN vals automatically in second case, on
+  // vars such that a recorded tape sees the branch
+  return (a <= b) ? var(new vari(0.0))
              : var(new internal::fdim_vv_vari(a.vi_, b.vi_));
 }
 
@@ -108,9 +108,10 @@ inline var fdim(const var& a, const var& b) {
  * arguments.
  */
 inline var fdim(double a, const var& b) {
-  // reversed test to get NaN vals automatically in second case
-  return a <= b.vi_->val_ ? var(new vari(0.0))
-                          : var(new internal::fdim_dv_vari(a, b.vi_));
+  // reversed test to get NaN vals automatically in second case, on
+  // vars such that a recorded tape sees the branch
+  return a <= b ? var(new vari(0.0))
+                : var(new internal::fdim_dv_vari(a, b.vi_));
 }
 
 /**
@@ -125,9 +126,10 @@ inline var fdim(double a, const var& b) {
  * @return The positive difference between the first and second arguments.
  */
 inline var fdim(const var& a, double b) {
-  // reversed test to get NaN vals automatically in second case
-  return a.vi_->val_ <= b ? var(new vari(0.0))
-                          : var(new internal::fdim_vd_vari(a.vi_, b));
+  // reversed test to get NaN vals automatically in second case, on
+  // vars such that a recorded tape sees the branch
+  return a <= b ? var(new vari(0.0))
+                : var(new internal::fdim_vd_vari(a.vi_, b));
 }
 
 }  // namespace math
@@ -3,6 +3,7 @@
 
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/core.hpp>
+#include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_inf.hpp>
 
 namespace stan {
@@ -11,13 +12,21 @@ namespace math {
 /**
  * Returns 1 if the input's value is infinite and 0 otherwise.
  *
- * Delegates to <code>is_inf</code>.
+ * Delegates to <code>is_inf</code>, recording the comparisons with
+ * both infinities for a tape being recorded.
  *
  * @param v Value to test.
  *
  * @return <code>1</code> if the value is infinite and <code>0</code> otherwise.
  */
-inline int is_inf(const var& v) { return is_inf(v.val()); }
+inline int is_inf(const var& v) {
+  const bool pos = internal::record_branch(internal::scalar_cmp::eq, v.vi_,
+                                           INFTY, v.val() == INFTY);
+  const bool neg
+      = internal::record_branch(internal::scalar_cmp::eq, v.vi_,
+                                NEGATIVE_INFTY, v.val() == NEGATIVE_INFTY);
+  return pos || neg;
+}
 
 }  // namespace math
 }  // namespace stan
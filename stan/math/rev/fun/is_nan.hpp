@@ -11,13 +11,17 @@ namespace math {
 /**
  * Returns 1 if the input's value is NaN and 0 otherwise.
  *
- * Delegates to <code>is_nan(double)</code>.
+ * Delegates to <code>is_nan(double)</code>, recording the comparison
+ * for a tape being recorded as <code>v != v</code>.
  *
  * @tparam T type of input
  * @param v value to test
  * @return <code>1</code> if the value is NaN and <code>0</code> otherwise.
  */
-inline bool is_nan(const var& v) { return is_nan(v.val()); }
+inline bool is_nan(const var& v) {
+  return internal::record_branch(internal::scalar_cmp::ne, v.vi_, v.vi_,
+                                 is_nan(v.val()));
+}
 
 }  // namespace math
 }  // namespace stan
@@ -18,6 +18,20 @@
 namespace stan {
 namespace math {
 
+#ifdef STAN_SCALAR_OP_TAPE
+/**
+ * Return the natural log of the specified variable, recorded on the
+ * scalar operation tape.
+ *
+ * @param a Variable whose log is taken.
+ * @return Natural log of variable.
+ */
+inline var log(const var& a) {
+  return {internal::push_scalar_op(internal::scalar_op::log_v,
+                                   std::log(a.val()), a.vi_)};
+}
+#endif
+
 /**
  * Return the natural log of the specified variable (cmath).
  *
@@ -40,7 +40,11 @@ namespace math {
  * @param a Specified variable.
  * @return Rounded variable.
  */
-inline var round(const var& a) { return var(round(a.val())); }
+inline var round(const var& a) {
+  // the result is a constant which replaying a tape would not update
+  internal::record_unreplayable();
+  return var(round(a.val()));
+}
 
 }  // namespace math
 }  // namespace stan
@@ -42,9 +42,14 @@ namespace math {
  * @return Square root of variable.
  */
 inline var sqrt(const var& a) {
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::sqrt_v,
+                                   std::sqrt(a.val()), a.vi_)};
+#else
   return make_callback_var(std::sqrt(a.val()), [a](auto& vi) mutable {
     a.adj() += vi.adj() / (2.0 * vi.val());
   });
+#endif
 }
 
 /**
@@ -33,9 +33,14 @@ namespace math {
  * @return Square of variable.
  */
 inline var square(const var& x) {
+#ifdef STAN_SCALAR_OP_TAPE
+  return {internal::push_scalar_op(internal::scalar_op::square_v,
+                                   square(x.val()), x.vi_)};
+#else
   return make_callback_var(square(x.val()), [x](auto& vi) mutable {
     x.adj() += vi.adj() * 2.0 * x.val();
   });
+#endif
 }
 
 /**
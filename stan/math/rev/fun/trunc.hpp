@@ -40,7 +40,11 @@ namespace math {
  * @param a Specified variable.
  * @return Truncation of the variable.
  */
-inline var trunc(const var& a) { return var(trunc(a.val())); }
+inline var trunc(const var& a) {
+  // the result is a constant which replaying a tape would not update
+  internal::record_unreplayable();
+  return var(trunc(a.val()));
+}
 
 }  // namespace math
 }  // namespace stan
@@ -8,15 +8,19 @@
 #include <stan/math/rev/functor/apply_scalar_unary.hpp>
 #include <stan/math/rev/functor/apply_scalar_binary.hpp>
 #include <stan/math/rev/functor/apply_vector_unary.hpp>
+#include <stan/math/rev/functor/checkpoint.hpp>
 #include <stan/math/rev/functor/coupled_ode_system.hpp>
 #include <stan/math/rev/functor/cvodes_integrator.hpp>
 #include <stan/math/rev/functor/cvodes_utils.hpp>
+#include <stan/math/rev/functor/fused_elementwise.hpp>
 #include <stan/math/rev/functor/gradient.hpp>
+#include <stan/math/rev/functor/gradient_batch.hpp>
 #include <stan/math/rev/functor/integrate_1d.hpp>
 #include <stan/math/rev/functor/dae.hpp>
 #include <stan/math/rev/functor/integrate_ode_adams.hpp>
 #include <stan/math/rev/functor/integrate_ode_bdf.hpp>
 #include <stan/math/rev/functor/ode_adams.hpp>
+#include <stan/math/rev/functor/ode_batch.hpp>
 #include <stan/math/rev/functor/ode_bdf.hpp>
 #include <stan/math/rev/functor/ode_adjoint.hpp>
 #include <stan/math/rev/functor/ode_store_sensitivities.hpp>
@@ -25,9 +29,11 @@
 #include <stan/math/rev/functor/kinsol_solve.hpp>
 #include <stan/math/rev/functor/map_rect_concurrent.hpp>
 #include <stan/math/rev/functor/map_rect_reduce.hpp>
+#include <stan/math/rev/functor/nested_parallel_for.hpp>
 #include <stan/math/rev/functor/operands_and_partials.hpp>
 #include <stan/math/rev/functor/partials_propagator.hpp>
 #include <stan/math/rev/functor/reduce_sum.hpp>
+#include <stan/math/rev/functor/taped_gradient.hpp>
 #include <stan/math/rev/functor/finite_diff_hessian_auto.hpp>
 #include <stan/math/rev/functor/finite_diff_hessian_times_vector_auto.hpp>
 
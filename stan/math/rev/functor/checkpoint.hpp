@@ -0,0 +1,83 @@
+#ifndef STAN_MATH_REV_FUNCTOR_CHECKPOINT_HPP
+#define STAN_MATH_REV_FUNCTOR_CHECKPOINT_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <stan/math/prim/functor/checkpoint.hpp>
+#include <stan/math/prim/fun/eval.hpp>
+#include <stan/math/prim/fun/value_of.hpp>
+#include <tuple>
+#include <utility>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return the result of applying the specified function to the
+ * specified arguments without keeping the expression graph of the
+ * function on the autodiff stack.  The graph is recomputed when the
+ * reverse pass reaches the result.
+ *
+ * The forward pass evaluates the function on the values of the
+ * arguments, so that only the arguments and the result are stored on
+ * the arena.  When the reverse pass reaches the result the function is
+ * evaluated again on the arguments in a nested autodiff stack, the
+ * adjoints of the result are copied onto the recomputed result and the
+ * nested stack is swept, adding to the adjoints of the arguments.  The
+ * nested graph is freed before the reverse pass continues.
+ *
+ * This trades one extra evaluation of the function for memory.  For a
+ * recursion of <code>N</code> steps, such as a time series model,
+ * checkpointing blocks of about <code>sqrt(N)</code> steps keeps the
+ * arena at the states between blocks plus the graph of a single block,
+ * instead of the graph of all <code>N</code> steps.  Checkpoints may be
+ * nested, in which case the inner functions are recomputed once more
+ * for every level.
+ *
+ * The function must be deterministic and callable with both the
+ * arguments and their values.  It must return a <code>var</code> or an
+ * Eigen vector or matrix of <code>var</code> when called with the
+ * arguments, and must not use the result of other checkpoints or
+ * variables other than its arguments.  The function is copied and kept
+ * until the reverse pass, so anything it refers to must outlive the
+ * gradient calculation.
+ *
+ * @tparam F Type of function
+ * @tparam Args Types of arguments
+ * @param f Function to evaluate
+ * @param args Arguments to the function
+ * @return <code>f(args...)</code>
+ */
+template <typename F, typename... Args,
+          require_any_st_var<Args...>* = nullptr>
+inline auto checkpoint(const F& f, const Args&... args) {
+  // the function and the arguments are owned by a chainable object so
+  // that they are destroyed when the arena is recovered
+  auto arena_f_args = make_chainable_ptr(
+      std::make_pair(f, std::make_tuple(eval(args)...)));
+  const auto& f_ref = arena_f_args->first;
+  auto ret_val = math::apply(
+      [&f_ref](const auto&... args) {
+        return eval(f_ref(eval(value_of(args))...));
+      },
+      arena_f_args->second);
+  using ret_type = promote_scalar_t<var, decltype(ret_val)>;
+  arena_t<ret_type> ret = ret_val;
+
+  reverse_pass_callback([ret, arena_f_args]() mutable {
+    nested_rev_autodiff rev;
+    const auto& f_ref = arena_f_args->first;
+    auto ret_nrad = math::apply(
+        [&f_ref](const auto&... args) { return eval(f_ref(args...)); },
+        arena_f_args->second);
+    ret_nrad.adj() += ret.adj();
+    grad();
+  });
+
+  return ret_type(ret);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -6,16 +6,159 @@
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/core.hpp>
 #include <stan/math/rev/fun/value_of.hpp>
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/fwd/meta.hpp>
+#include <stan/math/fwd/fun/Eigen_NumTraits.hpp>
+#ifdef STAN_ODE_FORWARD_SENSITIVITIES
+#include <stan/math/fwd/fun.hpp>
+#endif
+#include <stan/math/prim/meta/void_t.hpp>
 #include <stan/math/prim/functor/apply.hpp>
 #include <stan/math/prim/functor/for_each.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stdexcept>
 #include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace stan {
 namespace math {
 
+namespace internal {
+
+/**
+ * The type returned by the ODE right hand side functor F when called
+ * with <code>fvar&lt;double&gt;</code> states and the specified
+ * argument types.
+ */
+template <typename F, typename... Args>
+using ode_fvar_rhs_t = decltype(std::declval<const F&>()(
+    std::declval<double>(),
+    std::declval<const Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1>&>(),
+    std::declval<std::ostream*>(), std::declval<const Args&>()...));
+
+/**
+ * Metaprogram to check whether the ODE right hand side functor F can be
+ * called with <code>fvar&lt;double&gt;</code> states and the argument
+ * types in the tuple ArgsTuple and then returns <code>fvar</code>s.  A
+ * right hand side which is only defined for double and var states is
+ * not, even though the states convert to its double overload.
+ */
+template <typename F, typename ArgsTuple, typename = void>
+struct is_ode_fvar_invocable : std::false_type {};
+
+template <typename F, typename... Args>
+struct is_ode_fvar_invocable<F, std::tuple<Args...>,
+                             void_t<ode_fvar_rhs_t<F, Args...>>>
+    : is_fvar<scalar_type_t<ode_fvar_rhs_t<F, Args...>>> {};
+
+/**
+ * Return a copy of an argument of an ODE right hand side in which
+ * every var is replaced by an <code>fvar&lt;double&gt;</code> with the
+ * value of the var and a zero tangent.  Arguments without vars are
+ * forwarded.
+ */
+template <typename Arith, require_st_arithmetic<Arith>* = nullptr>
+inline const Arith& ode_fvar_copy(const Arith& arg) {
+  return arg;
+}
+
+inline fvar<double> ode_fvar_copy(const var& arg) {
+  return fvar<double>(arg.val());
+}
+
+template <typename VarVec, require_std_vector_vt<is_var, VarVec>* = nullptr>
+inline std::vector<fvar<double>> ode_fvar_copy(const VarVec& arg) {
+  std::vector<fvar<double>> copy_vec(arg.size());
+  for (size_t i = 0; i < arg.size(); ++i) {
+    copy_vec[i] = arg[i].val();
+  }
+  return copy_vec;
+}
+
+template <typename EigT, require_eigen_vt<is_var, EigT>* = nullptr>
+inline auto ode_fvar_copy(const EigT& arg) {
+  using fvar_matrix = Eigen::Matrix<fvar<double>, EigT::RowsAtCompileTime,
+                                    EigT::ColsAtCompileTime>;
+  return fvar_matrix(arg.val().template cast<fvar<double>>());
+}
+
+template <typename VecContainer,
+          require_std_vector_st<is_var, VecContainer>* = nullptr,
+          require_std_vector_vt<is_container, VecContainer>* = nullptr>
+inline auto ode_fvar_copy(const VecContainer& arg) {
+  std::vector<decltype(ode_fvar_copy(arg[0]))> copy_vec;
+  copy_vec.reserve(arg.size());
+  for (size_t i = 0; i < arg.size(); ++i) {
+    copy_vec.push_back(ode_fvar_copy(arg[i]));
+  }
+  return copy_vec;
+}
+
+/**
+ * Set the tangents of the fvars in the specified arguments, in the
+ * order <code>accumulate_adjoints()</code> visits the vars they were
+ * copied from, to consecutive elements of the specified array, and
+ * return the position after the last element used.
+ */
+inline const double* ode_set_tangents(const double* tangents) {
+  return tangents;
+}
+
+template <typename Arith, require_st_arithmetic<Arith>* = nullptr,
+          typename... Pargs>
+inline const double* ode_set_tangents(const double* tangents, const Arith& x,
+                                      Pargs&&... args);
+
+template <typename... Pargs>
+inline const double* ode_set_tangents(const double* tangents,
+                                      fvar<double>& x, Pargs&&... args);
+
+template <typename EigT, require_eigen_vt<is_fvar, EigT>* = nullptr,
+          typename... Pargs>
+inline const double* ode_set_tangents(const double* tangents, EigT& x,
+                                      Pargs&&... args);
+
+template <typename Vec, require_std_vector_st<is_fvar, Vec>* = nullptr,
+          typename... Pargs>
+inline const double* ode_set_tangents(const double* tangents, Vec& x,
+                                      Pargs&&... args);
+
+template <typename Arith, require_st_arithmetic<Arith>*, typename... Pargs>
+inline const double* ode_set_tangents(const double* tangents, const Arith& x,
+                                      Pargs&&... args) {
+  return ode_set_tangents(tangents, std::forward<Pargs>(args)...);
+}
+
+template <typename... Pargs>
+inline const double* ode_set_tangents(const double* tangents,
+                                      fvar<double>& x, Pargs&&... args) {
+  x.d_ = *tangents;
+  return ode_set_tangents(tangents + 1, std::forward<Pargs>(args)...);
+}
+
+template <typename EigT, require_eigen_vt<is_fvar, EigT>*, typename... Pargs>
+inline const double* ode_set_tangents(const double* tangents, EigT& x,
+                                      Pargs&&... args) {
+  for (Eigen::Index i = 0; i < x.size(); ++i) {
+    x.coeffRef(i).d_ = tangents[i];
+  }
+  return ode_set_tangents(tangents + x.size(), std::forward<Pargs>(args)...);
+}
+
+template <typename Vec, require_std_vector_st<is_fvar, Vec>*, typename... Pargs>
+inline const double* ode_set_tangents(const double* tangents, Vec& x,
+                                      Pargs&&... args) {
+  for (auto&& x_i : x) {
+    tangents = ode_set_tangents(tangents, x_i);
+  }
+  return ode_set_tangents(tangents, std::forward<Pargs>(args)...);
+}
+
+}  // namespace internal
+
 /**
  * The <code>coupled_ode_system_impl</code> template specialization when
  * the state or parameters are autodiff types.
@@ -59,6 +202,28 @@ namespace math {
  * parameter vector part of the nochain autodiff tape and is therefore
  * set to zero separately.
  *
+ * <p>The right hand side of the sensitivities of the k-th variable is
+ * the product of the Jacobian of the base ODE RHS wrt to the states and
+ * the k-th column of the sensitivities, plus the derivative of the RHS
+ * wrt to the k-th variable if it is a parameter. With reverse mode this
+ * takes one reverse sweep of the nested autodiff per state and a
+ * product with the sensitivities.
+ *
+ * <p>If <code>STAN_ODE_FORWARD_SENSITIVITIES</code> is defined, the RHS
+ * can be called with <code>fvar&lt;double&gt;</code> states and
+ * arguments, and there are at most twice as many variables as states,
+ * the coupled system instead evaluates the RHS in forward mode once per
+ * variable, with the states and the parameters copied into
+ * <code>fvar&lt;double&gt;</code> and their tangents seeded with the
+ * sensitivities of that variable, so that the tangents of the RHS are
+ * its sensitivity RHS. A forward evaluation costs about as much as a
+ * reverse sweep and needs no product, so this is faster even for
+ * somewhat more variables than states. Forward mode is opt-in because
+ * it instantiates the body of the RHS with <code>fvar</code>, which
+ * fails to compile if the body calls functions without forward mode
+ * support. The macro changes the members of this class, so it must
+ * be set for all or none of the translation units of a program.
+ *
  * @tparam F base ode system functor. Must provide
  *   <code>
  *     template<typename T_y, typename... T_args>
@@ -67,14 +232,27 @@ namespace math {
  */
 template <typename F, typename T_y0, typename... Args>
 struct coupled_ode_system_impl<false, F, T_y0, Args...> {
+  using fvar_args_t = std::tuple<decltype(
+      internal::ode_fvar_copy(std::declval<const Args&>()))...>;
+#ifdef STAN_ODE_FORWARD_SENSITIVITIES
+  static constexpr bool forward_mode_enabled
+      = internal::is_ode_fvar_invocable<F, fvar_args_t>::value;
+#else
+  static constexpr bool forward_mode_enabled = false;
+#endif
+
   const F& f_;
   const Eigen::Matrix<T_y0, Eigen::Dynamic, 1>& y0_;
   std::tuple<decltype(deep_copy_vars(std::declval<const Args&>()))...>
       local_args_tuple_;
+  std::conditional_t<forward_mode_enabled, fvar_args_t, std::tuple<>>
+      fvar_args_tuple_;
   const size_t num_y0_vars_;
   const size_t num_args_vars;
   const size_t N_;
+  const bool use_forward_mode_;
   Eigen::VectorXd args_adjoints_;
+  Eigen::VectorXd args_tangents_;
   Eigen::VectorXd y_adjoints_;
   std::ostream* msgs_;
 
@@ -94,10 +272,16 @@ struct coupled_ode_system_impl<false, F, T_y0, Args...> {
       : f_(f),
         y0_(y0),
         local_args_tuple_(deep_copy_vars(args)...),
+        fvar_args_tuple_(make_fvar_args(
+            std::integral_constant<bool, forward_mode_enabled>(), args...)),
         num_y0_vars_(count_vars(y0_)),
         num_args_vars(count_vars(args...)),
         N_(y0.size()),
+        use_forward_mode_(forward_mode_enabled
+                          && num_y0_vars_ + num_args_vars > 0
+                          && num_y0_vars_ + num_args_vars <= 2 * N_),
         args_adjoints_(num_args_vars),
+        args_tangents_(Eigen::VectorXd::Zero(num_args_vars)),
         y_adjoints_(N_),
         msgs_(msgs) {}
 
@@ -115,10 +299,102 @@ struct coupled_ode_system_impl<false, F, T_y0, Args...> {
    */
   void operator()(const std::vector<double>& z, std::vector<double>& dz_dt,
                   double t) {
-    using std::vector;
-
     dz_dt.resize(size());
+    if (use_forward_mode_) {
+      forward_sensitivities(
+          z, dz_dt, t, std::integral_constant<bool, forward_mode_enabled>());
+    } else {
+      reverse_sensitivities(z, dz_dt, t);
+    }
+  }
 
+  /**
+   * Returns copies of the arguments for forward mode, or an empty tuple
+   * if forward mode is not enabled.
+   */
+  static fvar_args_t make_fvar_args(std::true_type, const Args&... args) {
+    return fvar_args_t(internal::ode_fvar_copy(args)...);
+  }
+
+  static std::tuple<> make_fvar_args(std::false_type, const Args&... args) {
+    return std::tuple<>();
+  }
+
+  /**
+   * Calculates the right hand side of the coupled ode system with one
+   * forward mode evaluation of the base ode system per variable.
+   *
+   * @param[in] z state of the coupled ode system
+   * @param[out] dz_dt a vector of size <code>size()</code> with the
+   *    derivatives of the coupled system with respect to time
+   * @param[in] t time
+   * @throw exception if the base ode function does not return the
+   *    expected number of derivatives, N.
+   */
+  void forward_sensitivities(const std::vector<double>& z,
+                             std::vector<double>& dz_dt, double t,
+                             std::true_type) {
+    Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> y_fvars(N_);
+    for (size_t j = 0; j < num_y0_vars_ + num_args_vars; ++j) {
+      for (size_t n = 0; n < N_; ++n) {
+        y_fvars.coeffRef(n) = fvar<double>(z[n], z[N_ + N_ * j + n]);
+      }
+
+      // The sensitivities with respect to the initial conditions have
+      // no direct dependence on the parameters
+      if (j >= num_y0_vars_) {
+        args_tangents_.coeffRef(j - num_y0_vars_) = 1.0;
+      }
+      math::apply(
+          [&](auto&&... args) {
+            internal::ode_set_tangents(args_tangents_.data(), args...);
+          },
+          fvar_args_tuple_);
+      if (j >= num_y0_vars_) {
+        args_tangents_.coeffRef(j - num_y0_vars_) = 0.0;
+      }
+
+      Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> f_y_t_fvars
+          = math::apply(
+              [&](auto&&... args) { return f_(t, y_fvars, msgs_, args...); },
+              fvar_args_tuple_);
+
+      check_size_match("coupled_ode_system", "dy_dt", f_y_t_fvars.size(),
+                       "states", N_);
+
+      for (size_t i = 0; i < N_; ++i) {
+        dz_dt[N_ + N_ * j + i] = f_y_t_fvars.coeff(i).d_;
+      }
+      if (j == 0) {
+        for (size_t i = 0; i < N_; ++i) {
+          dz_dt[i] = f_y_t_fvars.coeff(i).val_;
+        }
+      }
+    }
+  }
+
+  /**
+   * Never called, since forward mode is only used if it is enabled.
+   */
+  void forward_sensitivities(const std::vector<double>& z,
+                             std::vector<double>& dz_dt, double t,
+                             std::false_type) {
+    reverse_sensitivities(z, dz_dt, t);
+  }
+
+  /**
+   * Calculates the right hand side of the coupled ode system with one
+   * reverse sweep of nested autodiff per state of the base ode system.
+   *
+   * @param[in] z state of the coupled ode system
+   * @param[out] dz_dt a vector of size <code>size()</code> with the
+   *    derivatives of the coupled system with respect to time
+   * @param[in] t time
+   * @throw exception if the base ode function does not return the
+   *    expected number of derivatives, N.
+   */
+  void reverse_sensitivities(const std::vector<double>& z,
+                             std::vector<double>& dz_dt, double t) {
     // Run nested autodiff in this scope
     nested_rev_autodiff nested;
 
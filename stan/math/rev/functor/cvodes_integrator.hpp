@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_FUNCTOR_INTEGRATE_ODE_CVODES_HPP
 #define STAN_MATH_REV_FUNCTOR_INTEGRATE_ODE_CVODES_HPP
 
+#include <stan/math/fwd/core.hpp>
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/functor/cvodes_utils.hpp>
 #include <stan/math/rev/functor/coupled_ode_system.hpp>
@@ -11,18 +12,69 @@
 #include <sundials/sundials_context.h>
 #include <cvodes/cvodes.h>
 #include <nvector/nvector_serial.h>
+#include <sunmatrix/sunmatrix_band.h>
 #include <sunlinsol/sunlinsol_dense.h>
+#include <sunlinsol/sunlinsol_band.h>
+#include <sunlinsol/sunlinsol_spgmr.h>
 #include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
 #include <ostream>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace stan {
 namespace math {
+namespace internal {
+
+/**
+ * Returns the number of solves on the current thread which reused a
+ * cached CVODES workspace instead of creating one. It is only
+ * incremented if <code>STAN_CVODES_CACHE</code> is defined.
+ */
+inline std::size_t& cvodes_workspace_cache_hits() {
+  static thread_local std::size_t hits = 0;
+  return hits;
+}
+
+}  // namespace internal
 
 /**
  * Integrator interface for CVODES' ODE solvers (Adams & BDF
  * methods).
  *
+ * The Jacobian of the ODE RHS with respect to the states is dense
+ * unless upper and lower bandwidths are given, in which case it is
+ * stored as a band matrix and factorized with the banded direct
+ * solver of CVODES.  The banded Jacobian is computed in forward mode
+ * with one evaluation of the RHS for every group of
+ * <code>mupper + mlower + 1</code> columns, such that memory and time
+ * scale with the number of states times the bandwidth instead of the
+ * square of the number of states. A RHS which cannot be called with
+ * <code>fvar&lt;double&gt;</code> states gets the band from the full
+ * Jacobian in reverse mode instead.
+ *
+ * With a Krylov linear solver no Jacobian is formed at all. The Newton
+ * iterations are solved with the matrix-free GMRES solver of CVODES,
+ * which only needs products of the Jacobian with vectors, each of
+ * which is one evaluation of the RHS in forward mode. For a RHS which
+ * cannot be called with <code>fvar&lt;double&gt;</code> states CVODES
+ * approximates the products with difference quotients. An optional
+ * preconditioner approximately solves the Newton systems.
+ *
+ * The CVODES memory, linear solver and vectors of a solve are held in
+ * a workspace. If <code>STAN_CVODES_CACHE</code> is defined, the
+ * workspace is kept per thread after a successful solve and later
+ * solves of the same integrator type with the same number of states,
+ * number of sensitivities and linear solver reinitialize it with
+ * <code>CVodeReInit</code> and <code>CVodeSensReInit</code> instead of
+ * allocating and setting up CVODES from scratch. Translation units
+ * compiled with and without the macro define this class differently
+ * and must not be linked into one program.
+ *
  * @tparam Lmm ID of ODE solver (1: ADAMS, 2: BDF)
  * @tparam F Type of ODE right hand side
  * @tparam T_y0 Type of initial state
@@ -37,7 +89,6 @@ class cvodes_integrator {
   using T_y0_t0 = return_type_t<T_y0, T_t0>;
 
   const char* function_name_;
-  sundials::Context sundials_context_;
   const F& f_;
   const Eigen::Matrix<T_y0_t0, Eigen::Dynamic, 1> y0_;
   const T_t0 t0_;
@@ -45,11 +96,21 @@ class cvodes_integrator {
   std::tuple<const T_Args&...> args_tuple_;
   std::tuple<plain_type_t<decltype(value_of(std::declval<const T_Args&>()))>...>
       value_of_args_tuple_;
+  // whether the RHS can be called with fvar<double> states
+  using fvar_rhs_tag = std::integral_constant<
+      bool, internal::is_ode_fvar_invocable<
+                F, decltype(value_of_args_tuple_)>::value>;
   const size_t N_;
   std::ostream* msgs_;
   double relative_tolerance_;
   double absolute_tolerance_;
   long int max_num_steps_;  // NOLINT(runtime/int)
+  const int mupper_;
+  const int mlower_;
+  bool krylov_{false};
+  std::function<Eigen::VectorXd(double, const Eigen::VectorXd&,
+                                const Eigen::VectorXd&, double)>
+      preconditioner_;
 
   const size_t num_y0_vars_;
   const size_t num_args_vars_;
@@ -57,17 +118,83 @@ class cvodes_integrator {
   coupled_ode_system<F, T_y0_t0, T_Args...> coupled_ode_;
 
   std::vector<double> coupled_state_;
-  N_Vector nv_state_;
-  N_Vector* nv_state_sens_;
-  SUNMatrix A_;
-  SUNLinearSolver LS_;
+
+  /**
+   * CVODES memory together with its linear solver and the vectors
+   * through which CVODES accesses the coupled state of a solve. It
+   * only depends on the number of states, the number of sensitivities
+   * and the linear solver. For every solve the vectors are pointed at
+   * the coupled state of the integrator using it, which is also set as
+   * integrator_.
+   */
+  struct workspace {
+    sundials::Context sundials_context_;
+    void* cvodes_mem_;
+    const int num_sens_;
+    N_Vector nv_state_;
+    N_Vector* nv_state_sens_{nullptr};
+    SUNMatrix A_{nullptr};
+    SUNLinearSolver LS_{nullptr};
+    bool initialized_{false};
+    cvodes_integrator* integrator_{nullptr};
+
+    workspace(size_t N, size_t num_sens, int mupper, int mlower, bool krylov,
+              bool preconditioned)
+        : sundials_context_(),
+          cvodes_mem_(CVodeCreate(Lmm, sundials_context_)),
+          num_sens_(num_sens) {
+      if (cvodes_mem_ == nullptr) {
+        throw std::runtime_error("CVodeCreate failed to allocate memory");
+      }
+      nv_state_ = N_VNewEmpty_Serial(N, sundials_context_);
+      if (num_sens_ > 0) {
+        nv_state_sens_ = N_VCloneEmptyVectorArray(num_sens_, nv_state_);
+      }
+      if (krylov) {
+        LS_ = SUNLinSol_SPGMR(nv_state_,
+                              preconditioned ? SUN_PREC_LEFT : SUN_PREC_NONE,
+                              0, sundials_context_);
+      } else if (mupper < 0) {
+        A_ = SUNDenseMatrix(N, N, sundials_context_);
+        LS_ = SUNLinSol_Dense(nv_state_, A_, sundials_context_);
+      } else {
+        A_ = SUNBandMatrix(N, mupper, mlower, sundials_context_);
+        LS_ = SUNLinSol_Band(nv_state_, A_, sundials_context_);
+      }
+    }
+
+    workspace(const workspace&) = delete;
+    workspace& operator=(const workspace&) = delete;
+
+    ~workspace() {
+      CVodeFree(&cvodes_mem_);
+      SUNLinSolFree(LS_);
+      SUNMatDestroy(A_);
+      if (num_sens_ > 0) {
+        N_VDestroyVectorArray(nv_state_sens_, num_sens_);
+      }
+      N_VDestroy_Serial(nv_state_);
+    }
+  };
+
+  using workspace_key = std::tuple<size_t, size_t, int, int, bool, bool>;
+
+  /**
+   * Returns the integrator solving with the workspace passed to CVODES
+   * as user data. CVODES keeps copies of the user data pointer for the
+   * linear solver, which stay valid when a workspace is reused by
+   * another integrator.
+   */
+  static inline cvodes_integrator* cast_to_self(void* user_data) {
+    return static_cast<workspace*>(user_data)->integrator_;
+  }
 
   /**
    * Implements the function of type CVRhsFn which is the user-defined
    * ODE RHS passed to CVODES.
    */
   static int cv_rhs(realtype t, N_Vector y, N_Vector ydot, void* user_data) {
-    cvodes_integrator* integrator = static_cast<cvodes_integrator*>(user_data);
+    cvodes_integrator* integrator = cast_to_self(user_data);
     integrator->rhs(t, NV_DATA_S(y), NV_DATA_S(ydot));
     return 0;
   }
@@ -79,7 +206,7 @@ class cvodes_integrator {
   static int cv_rhs_sens(int Ns, realtype t, N_Vector y, N_Vector ydot,
                          N_Vector* yS, N_Vector* ySdot, void* user_data,
                          N_Vector tmp1, N_Vector tmp2) {
-    cvodes_integrator* integrator = static_cast<cvodes_integrator*>(user_data);
+    cvodes_integrator* integrator = cast_to_self(user_data);
     integrator->rhs_sens(t, NV_DATA_S(y), yS, ySdot);
     return 0;
   }
@@ -93,8 +220,54 @@ class cvodes_integrator {
   static int cv_jacobian_states(realtype t, N_Vector y, N_Vector fy,
                                 SUNMatrix J, void* user_data, N_Vector tmp1,
                                 N_Vector tmp2, N_Vector tmp3) {
-    cvodes_integrator* integrator = static_cast<cvodes_integrator*>(user_data);
-    integrator->jacobian_states(t, NV_DATA_S(y), J);
+    cvodes_integrator* integrator = cast_to_self(user_data);
+    if (integrator->mupper_ < 0) {
+      integrator->jacobian_states(t, NV_DATA_S(y), J);
+    } else {
+      integrator->jacobian_states_band(t, NV_DATA_S(y), J, fvar_rhs_tag());
+    }
+    return 0;
+  }
+
+  /**
+   * Implements the function of type CVLsJacTimesVecFn which is the
+   * user-defined callback for CVODES to calculate the product of the
+   * jacobian of the ode_rhs wrt to the states y with a vector v.
+   */
+  static int cv_jacobian_times_vector(N_Vector v, N_Vector Jv, realtype t,
+                                      N_Vector y, N_Vector fy, void* user_data,
+                                      N_Vector tmp) {
+    cvodes_integrator* integrator = cast_to_self(user_data);
+    integrator->jacobian_times_vector(t, NV_DATA_S(y), NV_DATA_S(v),
+                                      NV_DATA_S(Jv));
+    return 0;
+  }
+
+  /**
+   * Returns the callback for the products of the jacobian with vectors
+   * if the RHS can be called with <code>fvar&lt;double&gt;</code>
+   * states, and otherwise nullptr, with which CVODES approximates the
+   * products with difference quotients.
+   */
+  static CVLsJacTimesVecFn jacobian_times_vector_fn(std::true_type) {
+    return &cvodes_integrator::cv_jacobian_times_vector;
+  }
+
+  static CVLsJacTimesVecFn jacobian_times_vector_fn(std::false_type) {
+    return nullptr;
+  }
+
+  /**
+   * Implements the function of type CVLsPrecSolveFn which is the
+   * user-defined callback for CVODES to approximately solve
+   * (I - gamma J) z = r with the preconditioner.
+   */
+  static int cv_preconditioner_solve(realtype t, N_Vector y, N_Vector fy,
+                                     N_Vector r, N_Vector z, realtype gamma,
+                                     realtype delta, int lr, void* user_data) {
+    cvodes_integrator* integrator = cast_to_self(user_data);
+    integrator->preconditioner_solve(t, NV_DATA_S(y), NV_DATA_S(r), gamma,
+                                     NV_DATA_S(z));
     return 0;
   }
 
@@ -120,6 +293,20 @@ class cvodes_integrator {
    * given time-point t and state y.
    */
   inline void jacobian_states(double t, const double y[], SUNMatrix J) const {
+    const Eigen::MatrixXd Jfy = jacobian_states(t, y);
+
+    for (size_t j = 0; j < Jfy.cols(); ++j) {
+      for (size_t i = 0; i < Jfy.rows(); ++i) {
+        SM_ELEMENT_D(J, i, j) = Jfy(i, j);
+      }
+    }
+  }
+
+  /**
+   * Returns the jacobian of the ODE RHS wrt to its states y at the given
+   * time-point t and state y, calculated in reverse mode.
+   */
+  inline Eigen::MatrixXd jacobian_states(double t, const double y[]) const {
     Eigen::VectorXd fy;
     Eigen::MatrixXd Jfy;
 
@@ -130,14 +317,185 @@ class cvodes_integrator {
     };
 
     jacobian(f_wrapped, Eigen::Map<const Eigen::VectorXd>(y, N_), fy, Jfy);
+    return Jfy;
+  }
 
-    for (size_t j = 0; j < Jfy.cols(); ++j) {
-      for (size_t i = 0; i < Jfy.rows(); ++i) {
-        SM_ELEMENT_D(J, i, j) = Jfy(i, j);
+  /**
+   * Calculates the band of the jacobian of the ODE RHS wrt to its
+   * states y at the given time-point t and state y. Columns which are
+   * more than mupper + mlower apart have no nonzero rows in common,
+   * such that each RHS evaluation seeded with the sum of the unit
+   * tangents of such columns gives all of them.
+   */
+  inline void jacobian_states_band(double t, const double y[], SUNMatrix J,
+                                   std::true_type) const {
+    const int N = N_;
+    const int width = mupper_ + mlower_ + 1;
+    Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> y_fvar(N);
+    for (int i = 0; i < N; ++i) {
+      y_fvar.coeffRef(i).val_ = y[i];
+    }
+
+    for (int group = 0; group < std::min(width, N); ++group) {
+      for (int j = 0; j < N; ++j) {
+        y_fvar.coeffRef(j).d_ = j % width == group ? 1.0 : 0.0;
       }
+
+      const Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> dy_dt
+          = rhs_tangent(t, y_fvar);
+
+      for (int j = group; j < N; j += width) {
+        const int last = std::min(N - 1, j + mlower_);
+        for (int i = std::max(0, j - mupper_); i <= last; ++i) {
+          SM_ELEMENT_B(J, i, j) = dy_dt.coeff(i).d_;
+        }
+      }
+    }
+  }
+
+  /**
+   * Calculates the band of the jacobian of the ODE RHS wrt to its
+   * states y from the full jacobian in reverse mode, for a RHS which
+   * cannot be called with <code>fvar&lt;double&gt;</code> states.
+   */
+  inline void jacobian_states_band(double t, const double y[], SUNMatrix J,
+                                   std::false_type) const {
+    const int N = N_;
+    const Eigen::MatrixXd Jfy = jacobian_states(t, y);
+    for (int j = 0; j < N; ++j) {
+      const int last = std::min(N - 1, j + mlower_);
+      for (int i = std::max(0, j - mupper_); i <= last; ++i) {
+        SM_ELEMENT_B(J, i, j) = Jfy(i, j);
+      }
+    }
+  }
+
+  /**
+   * Calculates the product of the jacobian of the ODE RHS wrt to its
+   * states y at the given time-point t and state y with the vector v,
+   * which is the tangent of the RHS in the direction v.
+   */
+  inline void jacobian_times_vector(double t, const double y[],
+                                    const double v[], double Jv[]) const {
+    Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> y_fvar(N_);
+    for (size_t i = 0; i < N_; ++i) {
+      y_fvar.coeffRef(i) = fvar<double>(y[i], v[i]);
+    }
+
+    const Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> dy_dt
+        = rhs_tangent(t, y_fvar);
+
+    for (size_t i = 0; i < N_; ++i) {
+      Jv[i] = dy_dt.coeff(i).d_;
     }
   }
 
+  /**
+   * Calculates the ODE RHS and its tangent for states y with tangents.
+   */
+  inline Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> rhs_tangent(
+      double t, const Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1>& y) const {
+    Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> dy_dt = math::apply(
+        [&](auto&&... args) { return f_(t, y, msgs_, args...); },
+        value_of_args_tuple_);
+
+    check_size_match("cvodes_integrator", "dy_dt", dy_dt.size(), "states", N_);
+
+    return dy_dt;
+  }
+
+  /**
+   * Applies the user-supplied preconditioner to the residual r of the
+   * Newton system (I - gamma J) z = r at the given time-point t and
+   * state y.
+   */
+  inline void preconditioner_solve(double t, const double y[],
+                                   const double r[], double gamma,
+                                   double z[]) const {
+    const Eigen::VectorXd z_vec
+        = preconditioner_(t, Eigen::Map<const Eigen::VectorXd>(y, N_),
+                          Eigen::Map<const Eigen::VectorXd>(r, N_), gamma);
+
+    check_size_match("cvodes_integrator", "preconditioned residual",
+                     z_vec.size(), "states", N_);
+
+    std::copy(z_vec.data(), z_vec.data() + N_, z);
+  }
+
+  /**
+   * Binds the user-supplied preconditioner to the message stream and the
+   * values of the extra arguments.
+   */
+  template <typename Preconditioner>
+  void set_preconditioner(const Preconditioner& preconditioner) {
+    preconditioner_
+        = [this, &preconditioner](double t, const Eigen::VectorXd& y,
+                                  const Eigen::VectorXd& r, double gamma) {
+            return math::apply(
+                [&](auto&&... args) {
+                  return Eigen::VectorXd(
+                      preconditioner(t, y, r, gamma, msgs_, args...));
+                },
+                value_of_args_tuple_);
+          };
+  }
+
+  void set_preconditioner(std::nullptr_t) {}
+
+  /**
+   * Returns the number of states, the number of sensitivities and the
+   * linear solver, which determine the workspace of a solve.
+   */
+  inline workspace_key make_workspace_key() const {
+    return workspace_key(N_, num_y0_vars_ + num_args_vars_, mupper_, mlower_,
+                         krylov_, static_cast<bool>(preconditioner_));
+  }
+
+  /**
+   * Returns the idle workspaces of the current thread, at most one per
+   * key.
+   */
+  static inline std::map<workspace_key, std::unique_ptr<workspace>>&
+  workspace_cache() {
+    static thread_local std::map<workspace_key, std::unique_ptr<workspace>>
+        cache;
+    return cache;
+  }
+
+  /**
+   * Returns a workspace for a solve, taken from the cache of the current
+   * thread if <code>STAN_CVODES_CACHE</code> is defined and it holds one
+   * with the same key, and created otherwise.
+   */
+  inline std::unique_ptr<workspace> acquire_workspace() const {
+    const workspace_key key = make_workspace_key();
+#ifdef STAN_CVODES_CACHE
+    auto cached = workspace_cache().find(key);
+    if (cached != workspace_cache().end() && cached->second) {
+      ++internal::cvodes_workspace_cache_hits();
+      return std::move(cached->second);
+    }
+#endif
+    return std::make_unique<workspace>(
+        std::get<0>(key), std::get<1>(key), std::get<2>(key),
+        std::get<3>(key), std::get<4>(key), std::get<5>(key));
+  }
+
+  /**
+   * Returns the workspace of a successful solve to the cache of the
+   * current thread if <code>STAN_CVODES_CACHE</code> is defined and
+   * the cache holds none with the same key, and frees it otherwise.
+   */
+  inline void release_workspace(std::unique_ptr<workspace> ws) const {
+#ifdef STAN_CVODES_CACHE
+    std::unique_ptr<workspace>& cached
+        = workspace_cache()[make_workspace_key()];
+    if (!cached) {
+      cached = std::move(ws);
+    }
+#endif
+  }
+
   /**
    * Calculates the RHS of the sensitivity ODE system which
    * corresponds to the coupled ode system from which the first N
@@ -193,8 +551,47 @@ class cvodes_integrator {
                     double relative_tolerance, double absolute_tolerance,
                     long int max_num_steps,  // NOLINT(runtime/int)
                     std::ostream* msgs, const T_Args&... args)
+      : cvodes_integrator(function_name, f, y0, t0, ts, relative_tolerance,
+                          absolute_tolerance, max_num_steps, -1, -1, msgs,
+                          args...) {}
+
+  /**
+   * Construct cvodes_integrator object which stores the Jacobian of
+   * the ODE RHS wrt to the states as a band matrix.
+   *
+   * @param function_name Calling function name (for printing debugging
+   * messages)
+   * @param f Right hand side of the ODE
+   * @param y0 Initial state
+   * @param t0 Initial time
+   * @param ts Times at which to solve the ODE at. All values must be sorted and
+   *   not less than t0.
+   * @param relative_tolerance Relative tolerance passed to CVODES
+   * @param absolute_tolerance Absolute tolerance passed to CVODES
+   * @param max_num_steps Upper limit on the number of integration steps to
+   *   take between each output (error if exceeded)
+   * @param mupper Upper bandwidth of the Jacobian, or -1 for a dense
+   *   Jacobian
+   * @param mlower Lower bandwidth of the Jacobian, or -1 for a dense
+   *   Jacobian
+   * @param[in, out] msgs the print stream for warning messages
+   * @param args Extra arguments passed unmodified through to ODE right hand
+   * side function
+   * @throw <code>std::domain_error</code> if y0, t0, ts, theta, x are not
+   *   finite, all elements of ts are not greater than t0, ts is not
+   *   sorted in strictly increasing order, or a bandwidth is not less
+   *   than the number of states.
+   * @throw <code>std::invalid_argument</code> if arguments are the wrong
+   *   size or tolerances or max_num_steps are out of range.
+   */
+  template <require_eigen_col_vector_t<T_y0>* = nullptr>
+  cvodes_integrator(const char* function_name, const F& f, const T_y0& y0,
+                    const T_t0& t0, const std::vector<T_ts>& ts,
+                    double relative_tolerance, double absolute_tolerance,
+                    long int max_num_steps,  // NOLINT(runtime/int)
+                    int mupper, int mlower, std::ostream* msgs,
+                    const T_Args&... args)
       : function_name_(function_name),
-        sundials_context_(),
         f_(f),
         y0_(y0.template cast<T_y0_t0>()),
         t0_(t0),
@@ -206,6 +603,8 @@ class cvodes_integrator {
         relative_tolerance_(relative_tolerance),
         absolute_tolerance_(absolute_tolerance),
         max_num_steps_(max_num_steps),
+        mupper_(mupper < 0 || mlower < 0 ? -1 : mupper),
+        mlower_(mupper < 0 || mlower < 0 ? -1 : mlower),
         num_y0_vars_(count_vars(y0_)),
         num_args_vars_(count_vars(args...)),
         coupled_ode_(f, y0_, msgs, args...),
@@ -233,28 +632,62 @@ class cvodes_integrator {
     check_positive_finite(function_name, "absolute_tolerance",
                           absolute_tolerance_);
     check_positive(function_name, "max_num_steps", max_num_steps_);
-
-    nv_state_ = N_VMake_Serial(N_, &coupled_state_[0], sundials_context_);
-    nv_state_sens_ = nullptr;
-    A_ = SUNDenseMatrix(N_, N_, sundials_context_);
-    LS_ = SUNLinSol_Dense(nv_state_, A_, sundials_context_);
-
-    if (num_y0_vars_ + num_args_vars_ > 0) {
-      nv_state_sens_
-          = N_VCloneEmptyVectorArray(num_y0_vars_ + num_args_vars_, nv_state_);
-      for (std::size_t i = 0; i < num_y0_vars_ + num_args_vars_; i++) {
-        NV_DATA_S(nv_state_sens_[i]) = &coupled_state_[N_] + i * N_;
-      }
+    if (mupper_ >= 0) {
+      check_less(function_name, "upper_bandwidth", mupper_,
+                 static_cast<int>(N_));
+      check_less(function_name, "lower_bandwidth", mlower_,
+                 static_cast<int>(N_));
     }
   }
 
-  ~cvodes_integrator() {
-    SUNLinSolFree(LS_);
-    SUNMatDestroy(A_);
-    N_VDestroy_Serial(nv_state_);
-    if (num_y0_vars_ + num_args_vars_ > 0) {
-      N_VDestroyVectorArray(nv_state_sens_, num_y0_vars_ + num_args_vars_);
-    }
+  /**
+   * Construct cvodes_integrator object which solves the Newton
+   * iterations with the matrix-free GMRES solver of CVODES.
+   *
+   * The preconditioner, if not <code>nullptr</code>, must define an
+   * operator() with the signature
+   *   Eigen::VectorXd operator()(double t, const Eigen::VectorXd& y,
+   *     const Eigen::VectorXd& r, double gamma, std::ostream* msgs,
+   *     const T_Args_Values&... args);
+   * which returns an approximate solution z of (I - gamma J) z = r,
+   * where J is the jacobian of the ODE RHS wrt to the states at y.
+   * The extra arguments are passed as values.
+   *
+   * @param function_name Calling function name (for printing debugging
+   * messages)
+   * @param f Right hand side of the ODE
+   * @param y0 Initial state
+   * @param t0 Initial time
+   * @param ts Times at which to solve the ODE at. All values must be sorted and
+   *   not less than t0.
+   * @param relative_tolerance Relative tolerance passed to CVODES
+   * @param absolute_tolerance Absolute tolerance passed to CVODES
+   * @param max_num_steps Upper limit on the number of integration steps to
+   *   take between each output (error if exceeded)
+   * @param preconditioner Preconditioner of the Newton systems, or
+   *   <code>nullptr</code>. Must outlive the integrator.
+   * @param[in, out] msgs the print stream for warning messages
+   * @param args Extra arguments passed unmodified through to ODE right hand
+   * side function
+   * @throw <code>std::domain_error</code> if y0, t0, ts, theta, x are not
+   *   finite, all elements of ts are not greater than t0, or ts is not
+   *   sorted in strictly increasing order.
+   * @throw <code>std::invalid_argument</code> if arguments are the wrong
+   *   size or tolerances or max_num_steps are out of range.
+   */
+  template <typename Preconditioner,
+            require_eigen_col_vector_t<T_y0>* = nullptr>
+  cvodes_integrator(const char* function_name, const F& f, const T_y0& y0,
+                    const T_t0& t0, const std::vector<T_ts>& ts,
+                    double relative_tolerance, double absolute_tolerance,
+                    long int max_num_steps,  // NOLINT(runtime/int)
+                    const Preconditioner& preconditioner, std::ostream* msgs,
+                    const T_Args&... args)
+      : cvodes_integrator(function_name, f, y0, t0, ts, relative_tolerance,
+                          absolute_tolerance, max_num_steps, -1, -1, msgs,
+                          args...) {
+    krylov_ = true;
+    set_preconditioner(preconditioner);
   }
 
   /**
@@ -268,68 +701,90 @@ class cvodes_integrator {
   std::vector<Eigen::Matrix<T_Return, Eigen::Dynamic, 1>> operator()() {
     std::vector<Eigen::Matrix<T_Return, Eigen::Dynamic, 1>> y;
 
-    void* cvodes_mem = CVodeCreate(Lmm, sundials_context_);
-    if (cvodes_mem == nullptr) {
-      throw std::runtime_error("CVodeCreate failed to allocate memory");
+    const size_t num_sens = num_y0_vars_ + num_args_vars_;
+    std::unique_ptr<workspace> ws = acquire_workspace();
+    void* cvodes_mem = ws->cvodes_mem_;
+    N_Vector nv_state = ws->nv_state_;
+    N_Vector* nv_state_sens = ws->nv_state_sens_;
+
+    ws->integrator_ = this;
+    N_VSetArrayPointer_Serial(&coupled_state_[0], nv_state);
+    for (std::size_t i = 0; i < num_sens; i++) {
+      N_VSetArrayPointer_Serial(&coupled_state_[N_] + i * N_,
+                                nv_state_sens[i]);
     }
 
-    try {
+    if (ws->initialized_) {
+      CHECK_CVODES_CALL(CVodeReInit(cvodes_mem, value_of(t0_), nv_state));
+      if (num_sens > 0) {
+        CHECK_CVODES_CALL(
+            CVodeSensReInit(cvodes_mem, CV_STAGGERED, nv_state_sens));
+      }
+    } else {
       CHECK_CVODES_CALL(CVodeInit(cvodes_mem, &cvodes_integrator::cv_rhs,
-                                  value_of(t0_), nv_state_));
+                                  value_of(t0_), nv_state));
 
-      // Assign pointer to this as user data
+      // Assign pointer to the workspace as user data
       CHECK_CVODES_CALL(
-          CVodeSetUserData(cvodes_mem, reinterpret_cast<void*>(this)));
-
-      cvodes_set_options(cvodes_mem, max_num_steps_);
-
-      CHECK_CVODES_CALL(CVodeSStolerances(cvodes_mem, relative_tolerance_,
-                                          absolute_tolerance_));
-
-      CHECK_CVODES_CALL(CVodeSetLinearSolver(cvodes_mem, LS_, A_));
-      CHECK_CVODES_CALL(
-          CVodeSetJacFn(cvodes_mem, &cvodes_integrator::cv_jacobian_states));
+          CVodeSetUserData(cvodes_mem, reinterpret_cast<void*>(ws.get())));
+
+      CHECK_CVODES_CALL(CVodeSetLinearSolver(cvodes_mem, ws->LS_, ws->A_));
+      if (krylov_) {
+        CHECK_CVODES_CALL(CVodeSetJacTimes(
+            cvodes_mem, nullptr, jacobian_times_vector_fn(fvar_rhs_tag())));
+        if (preconditioner_) {
+          CHECK_CVODES_CALL(CVodeSetPreconditioner(
+              cvodes_mem, nullptr,
+              &cvodes_integrator::cv_preconditioner_solve));
+        }
+      } else {
+        CHECK_CVODES_CALL(
+            CVodeSetJacFn(cvodes_mem, &cvodes_integrator::cv_jacobian_states));
+      }
 
       // initialize forward sensitivity system of CVODES as needed
-      if (num_y0_vars_ + num_args_vars_ > 0) {
-        CHECK_CVODES_CALL(CVodeSensInit(
-            cvodes_mem, static_cast<int>(num_y0_vars_ + num_args_vars_),
-            CV_STAGGERED, &cvodes_integrator::cv_rhs_sens, nv_state_sens_));
+      if (num_sens > 0) {
+        CHECK_CVODES_CALL(CVodeSensInit(cvodes_mem, static_cast<int>(num_sens),
+                                        CV_STAGGERED,
+                                        &cvodes_integrator::cv_rhs_sens,
+                                        nv_state_sens));
 
         CHECK_CVODES_CALL(CVodeSetSensErrCon(cvodes_mem, SUNTRUE));
 
         CHECK_CVODES_CALL(CVodeSensEEtolerances(cvodes_mem));
       }
+      ws->initialized_ = true;
+    }
 
-      double t_init = value_of(t0_);
-      for (size_t n = 0; n < ts_.size(); ++n) {
-        double t_final = value_of(ts_[n]);
+    cvodes_set_options(cvodes_mem, max_num_steps_);
 
-        if (t_final != t_init) {
-          CHECK_CVODES_CALL(
-              CVode(cvodes_mem, t_final, nv_state_, &t_init, CV_NORMAL));
+    CHECK_CVODES_CALL(CVodeSStolerances(cvodes_mem, relative_tolerance_,
+                                        absolute_tolerance_));
 
-          if (num_y0_vars_ + num_args_vars_ > 0) {
-            CHECK_CVODES_CALL(
-                CVodeGetSens(cvodes_mem, &t_init, nv_state_sens_));
-          }
-        }
+    double t_init = value_of(t0_);
+    for (size_t n = 0; n < ts_.size(); ++n) {
+      double t_final = value_of(ts_[n]);
 
-        y.emplace_back(math::apply(
-            [&](auto&&... args) {
-              return ode_store_sensitivities(f_, coupled_state_, y0_, t0_,
-                                             ts_[n], msgs_, args...);
-            },
-            args_tuple_));
+      if (t_final != t_init) {
+        CHECK_CVODES_CALL(
+            CVode(cvodes_mem, t_final, nv_state, &t_init, CV_NORMAL));
 
-        t_init = t_final;
+        if (num_sens > 0) {
+          CHECK_CVODES_CALL(CVodeGetSens(cvodes_mem, &t_init, nv_state_sens));
+        }
       }
-    } catch (const std::exception& e) {
-      CVodeFree(&cvodes_mem);
-      throw;
+
+      y.emplace_back(math::apply(
+          [&](auto&&... args) {
+            return ode_store_sensitivities(f_, coupled_state_, y0_, t0_,
+                                           ts_[n], msgs_, args...);
+          },
+          args_tuple_));
+
+      t_init = t_final;
     }
 
-    CVodeFree(&cvodes_mem);
+    release_workspace(std::move(ws));
 
     return y;
   }
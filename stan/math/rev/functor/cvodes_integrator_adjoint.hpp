@@ -1,9 +1,11 @@
 #ifndef STAN_MATH_REV_FUNCTOR_CVODES_INTEGRATOR_ADJOINT_HPP
 #define STAN_MATH_REV_FUNCTOR_CVODES_INTEGRATOR_ADJOINT_HPP
 
+#include <stan/math/fwd/core.hpp>
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/core/save_varis.hpp>
 #include <stan/math/rev/functor/cvodes_utils.hpp>
+#include <stan/math/rev/functor/coupled_ode_system.hpp>
 #include <stan/math/rev/functor/ode_store_sensitivities.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
@@ -14,8 +16,11 @@
 #include <nvector/nvector_serial.h>
 #include <sunmatrix/sunmatrix_dense.h>
 #include <sunlinsol/sunlinsol_dense.h>
+#include <sunlinsol/sunlinsol_spgmr.h>
 #include <algorithm>
 #include <ostream>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -26,6 +31,15 @@ namespace math {
  * Integrator interface for CVODES' adjoint ODE solvers (Adams & BDF
  * methods).
  *
+ * The forward and backward solvers are 1 for Adams, 2 for BDF and 3
+ * for BDF with the Newton iterations solved by the matrix-free GMRES
+ * solver of CVODES. The latter forms no Jacobian; each product of the
+ * Jacobian with a vector is one evaluation of the ODE RHS in forward
+ * mode for the forward problem and one reverse sweep through it for
+ * the backward problem. For a RHS which cannot be called with
+ * <code>fvar&lt;double&gt;</code> states CVODES approximates the
+ * products of the forward problem with difference quotients.
+ *
  * @tparam F Type of ODE right hand side
  * @tparam T_y0 Type of scalars for initial state
  * @tparam T_t0 Type of initial time
@@ -47,6 +61,12 @@ class cvodes_integrator_adjoint_vari : public vari_base {
   static constexpr bool is_var_return_{is_var<T_Return>::value};
   static constexpr bool is_var_only_ts_{
       is_var_ts_ && !(is_var_t0_ || is_var_y0_t0_ || is_any_var_args_)};
+  // whether the RHS can be called with fvar<double> states
+  using fvar_rhs_tag = std::integral_constant<
+      bool, internal::is_ode_fvar_invocable<
+                F, std::tuple<promote_scalar_t<
+                       partials_type_t<scalar_type_t<T_Args>>, T_Args>...>>::
+                value>;
 
   const size_t num_args_vars_;
 
@@ -64,6 +84,31 @@ class cvodes_integrator_adjoint_vari : public vari_base {
   const int solver_forward_;
   const int solver_backward_;
   int index_backward_;
+
+  /**
+   * Solver code of BDF with a matrix-free Krylov linear solver.
+   */
+  static constexpr int krylov_solver_{3};
+
+  /**
+   * Return the CVODES linear multistep method of a solver code.
+   */
+  static constexpr int linear_multistep_method(int solver) {
+    return solver == krylov_solver_ ? CV_BDF : solver;
+  }
+
+  /**
+   * Return a new linear solver for the Newton iterations with the solver
+   * code, which works on the matrix A unless the solver is matrix-free.
+   */
+  static SUNLinearSolver make_linear_solver(int solver, N_Vector y,
+                                            SUNMatrix A,
+                                            SUNContext sundials_context) {
+    return solver == krylov_solver_
+               ? SUNLinSol_SPGMR(y, SUN_PREC_NONE, 0, sundials_context)
+               : SUNLinSol_Dense(y, A, sundials_context);
+  }
+
   bool backward_is_initialized_{false};
 
   /**
@@ -108,7 +153,7 @@ class cvodes_integrator_adjoint_vari : public vari_base {
                   const Eigen::VectorXd& absolute_tolerance_forward,
                   const Eigen::VectorXd& absolute_tolerance_backward,
                   size_t num_args_vars, int solver_forward,
-                  const T_Args&... args)
+                  int solver_backward, const T_Args&... args)
         : chainable_alloc(),
           sundials_context_(),
           function_name_str_(function_name),
@@ -133,15 +178,22 @@ class cvodes_integrator_adjoint_vari : public vari_base {
               N, absolute_tolerance_forward_.data(), sundials_context_)),
           nv_absolute_tolerance_backward_(N_VMake_Serial(
               N, absolute_tolerance_backward_.data(), sundials_context_)),
-          A_forward_(SUNDenseMatrix(N, N, sundials_context_)),
-          A_backward_(SUNDenseMatrix(N, N, sundials_context_)),
+          A_forward_(solver_forward == krylov_solver_
+                         ? nullptr
+                         : SUNDenseMatrix(N, N, sundials_context_)),
           LS_forward_(N == 0 ? nullptr
-                             : SUNLinSol_Dense(nv_state_forward_, A_forward_,
-                                               sundials_context_)),
+                             : make_linear_solver(solver_forward,
+                                                  nv_state_forward_, A_forward_,
+                                                  sundials_context_)),
+          A_backward_(solver_backward == krylov_solver_
+                          ? nullptr
+                          : SUNDenseMatrix(N, N, sundials_context_)),
           LS_backward_(N == 0 ? nullptr
-                              : SUNLinSol_Dense(nv_state_backward_, A_backward_,
-                                                sundials_context_)),
-          cvodes_mem_(CVodeCreate(solver_forward, sundials_context_)),
+                              : make_linear_solver(
+                                  solver_backward, nv_state_backward_,
+                                  A_backward_, sundials_context_)),
+          cvodes_mem_(CVodeCreate(linear_multistep_method(solver_forward),
+                                  sundials_context_)),
           local_args_tuple_(deep_copy_vars(args)...),
           value_of_args_tuple_(value_of(args)...) {
       if (cvodes_mem_ == nullptr) {
@@ -197,9 +249,10 @@ class cvodes_integrator_adjoint_vari : public vari_base {
    * @param num_steps_between_checkpoints Number of integrator steps after which
    * a checkpoint is stored for the backward pass
    * @param interpolation_polynomial type of polynomial used for interpolation
-   * @param solver_forward solver used for forward pass
-   * @param solver_backward solver used for backward pass
-   *   take between each output (error if exceeded)
+   * @param solver_forward solver used for forward pass, 1 for Adams, 2 for
+   * BDF or 3 for BDF with a matrix-free Krylov linear solver
+   * @param solver_backward solver used for backward pass, 1 for Adams, 2 for
+   * BDF or 3 for BDF with a matrix-free Krylov linear solver
    * @param[in, out] msgs the print stream for warning messages
    * @param args Extra arguments passed unmodified through to ODE right hand
    * side function
@@ -278,18 +331,20 @@ class cvodes_integrator_adjoint_vari : public vari_base {
                        interpolation_polynomial_, "",
                        ", must be 1 for Hermite or 2 for polynomial "
                        "interpolation of ODE solution");
-    // 1=Adams=CV_ADAMS, 2=BDF=CV_BDF
-    if (solver_forward_ != 1 && solver_forward_ != 2)
+    // 1=Adams=CV_ADAMS, 2=BDF=CV_BDF, 3=BDF with Krylov linear solver
+    if (solver_forward_ < 1 || solver_forward_ > 3)
       invalid_argument(function_name, "solver_forward", solver_forward_, "",
-                       ", must be 1 for Adams or 2 for BDF forward solver");
-    if (solver_backward_ != 1 && solver_backward_ != 2)
+                       ", must be 1 for Adams, 2 for BDF or 3 for BDF with "
+                       "Krylov linear solver forward solver");
+    if (solver_backward_ < 1 || solver_backward_ > 3)
       invalid_argument(function_name, "solver_backward", solver_backward_, "",
-                       ", must be 1 for Adams or 2 for BDF backward solver");
+                       ", must be 1 for Adams, 2 for BDF or 3 for BDF with "
+                       "Krylov linear solver backward solver");
 
     solver_ = new cvodes_solver(function_name, std::forward<FF>(f), N_, y0, t0,
                                 ts, absolute_tolerance_forward,
                                 absolute_tolerance_backward, num_args_vars_,
-                                solver_forward_, args...);
+                                solver_forward_, solver_backward_, args...);
 
     stan::math::for_each(
         [func_name = function_name](auto&& arg) {
@@ -314,9 +369,15 @@ class cvodes_integrator_adjoint_vari : public vari_base {
     CHECK_CVODES_CALL(CVodeSetLinearSolver(
         solver_->cvodes_mem_, solver_->LS_forward_, solver_->A_forward_));
 
-    CHECK_CVODES_CALL(
-        CVodeSetJacFn(solver_->cvodes_mem_,
-                      &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_states));
+    if (solver_forward_ == krylov_solver_) {
+      CHECK_CVODES_CALL(
+          CVodeSetJacTimes(solver_->cvodes_mem_, nullptr,
+                           jacobian_rhs_states_times_vector_fn(fvar_rhs_tag())));
+    } else {
+      CHECK_CVODES_CALL(CVodeSetJacFn(
+          solver_->cvodes_mem_,
+          &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_states));
+    }
 
     // initialize backward sensitivity system of CVODES as needed
     if (is_var_return_ && !is_var_only_ts_) {
@@ -440,8 +501,10 @@ class cvodes_integrator_adjoint_vari : public vari_base {
       double t_final = value_of((i > 0) ? solver_->ts_[i - 1] : solver_->t0_);
       if (t_final != t_init) {
         if (unlikely(!backward_is_initialized_)) {
-          CHECK_CVODES_CALL(CVodeCreateB(solver_->cvodes_mem_, solver_backward_,
-                                         &index_backward_));
+          CHECK_CVODES_CALL(
+              CVodeCreateB(solver_->cvodes_mem_,
+                           linear_multistep_method(solver_backward_),
+                           &index_backward_));
 
           CHECK_CVODES_CALL(CVodeSetUserDataB(solver_->cvodes_mem_,
                                               index_backward_,
@@ -467,9 +530,16 @@ class cvodes_integrator_adjoint_vari : public vari_base {
               solver_->cvodes_mem_, index_backward_, solver_->LS_backward_,
               solver_->A_backward_));
 
-          CHECK_CVODES_CALL(CVodeSetJacFnB(
-              solver_->cvodes_mem_, index_backward_,
-              &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_adj_states));
+          if (solver_backward_ == krylov_solver_) {
+            CHECK_CVODES_CALL(CVodeSetJacTimesB(
+                solver_->cvodes_mem_, index_backward_, nullptr,
+                &cvodes_integrator_adjoint_vari::
+                    cv_jacobian_rhs_adj_states_times_vector));
+          } else {
+            CHECK_CVODES_CALL(CVodeSetJacFnB(
+                solver_->cvodes_mem_, index_backward_,
+                &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_adj_states));
+          }
 
           // Allocate space for backwards quadrature needed when
           // parameters vary.
@@ -729,6 +799,67 @@ class cvodes_integrator_adjoint_vari : public vari_base {
                                                   N_Vector tmp3) {
     return cast_to_self(user_data)->jacobian_rhs_adj_states(t, y, J);
   }
+
+  /**
+   * Calculates the product of the jacobian of the ODE RHS wrt to its
+   * states y at the given time-point t and state y with the vector v,
+   * which is the tangent of the RHS in the direction v.
+   */
+  inline int jacobian_rhs_states_times_vector(double t, N_Vector y, N_Vector v,
+                                              N_Vector Jv) const {
+    Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> y_fvar(N_);
+    for (size_t i = 0; i < N_; ++i) {
+      y_fvar.coeffRef(i) = fvar<double>(NV_Ith_S(y, i), NV_Ith_S(v, i));
+    }
+    const Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> fy_fvar
+        = rhs(t, y_fvar, solver_->value_of_args_tuple_);
+    check_size_match(solver_->function_name_str_.c_str(), "dy_dt",
+                     fy_fvar.size(), "states", N_);
+    for (size_t i = 0; i < N_; ++i) {
+      NV_Ith_S(Jv, i) = fy_fvar.coeff(i).d_;
+    }
+    return 0;
+  }
+
+  /**
+   * Implements the function of type CVLsJacTimesVecFn which is the
+   * user-defined callback for CVODES to calculate the product of the
+   * jacobian of the ode_rhs wrt to the states y with a vector v.
+   */
+  constexpr static int cv_jacobian_rhs_states_times_vector(
+      N_Vector v, N_Vector Jv, realtype t, N_Vector y, N_Vector fy,
+      void* user_data, N_Vector tmp) {
+    return cast_to_self(user_data)->jacobian_rhs_states_times_vector(t, y, v,
+                                                                     Jv);
+  }
+
+  /**
+   * Returns the callback for the products of the jacobian with vectors
+   * if the RHS can be called with <code>fvar&lt;double&gt;</code>
+   * states, and otherwise nullptr, with which CVODES approximates the
+   * products with difference quotients.
+   */
+  static CVLsJacTimesVecFn jacobian_rhs_states_times_vector_fn(
+      std::true_type) {
+    return &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_states_times_vector;
+  }
+
+  static CVLsJacTimesVecFn jacobian_rhs_states_times_vector_fn(
+      std::false_type) {
+    return nullptr;
+  }
+
+  /**
+   * Implements the CVLsJacTimesVecFnB function for evaluating the
+   * product of the jacobian of the adjoint problem wrt to the backward
+   * states with a vector vB. The adjoint ODE RHS is linear in the
+   * backward states, such that this is the adjoint ODE RHS at vB.
+   */
+  constexpr static int cv_jacobian_rhs_adj_states_times_vector(
+      N_Vector vB, N_Vector JvB, realtype t, N_Vector y, N_Vector yB,
+      N_Vector fyB, void* user_data, N_Vector tmpB) {
+    return cast_to_self(user_data)->rhs_adj(t, y, vB, JvB);
+  }
 };  // cvodes integrator adjoint vari
 
 }  // namespace math
@@ -43,6 +43,10 @@ namespace math {
  * @param atol Absolute tolerance passed to IDAS
  * @param max_num_steps Upper limit on the number of integration steps to
  *   take between each output (error if exceeded)
+ * @param upper_bandwidth Upper bandwidth of the Jacobian of the residual, or
+ *   -1 for a dense Jacobian
+ * @param lower_bandwidth Lower bandwidth of the Jacobian of the residual, or
+ *   -1 for a dense Jacobian
  * @param[in, out] msgs the print stream for warning messages
  * @param args Extra arguments passed unmodified through to DAE right hand side
  * @return Solution to DAE at times \p ts
@@ -52,7 +56,8 @@ template <typename F, typename T_yy, typename T_yp, typename... T_Args,
 std::vector<Eigen::Matrix<stan::return_type_t<T_yy, T_yp, T_Args...>, -1, 1>>
 dae_tol_impl(const char* func, const F& f, const T_yy& yy0, const T_yp& yp0,
              double t0, const std::vector<double>& ts, double rtol, double atol,
-             int64_t max_num_steps, std::ostream* msgs, const T_Args&... args) {
+             int64_t max_num_steps, int upper_bandwidth, int lower_bandwidth,
+             std::ostream* msgs, const T_Args&... args) {
   check_finite(func, "initial state", yy0);
   check_finite(func, "initial state derivative", yp0);
   check_nonzero_size(func, "initial state", yy0);
@@ -65,6 +70,10 @@ dae_tol_impl(const char* func, const F& f, const T_yy& yy0, const T_yp& yp0,
   check_positive_finite(func, "relative_tolerance", rtol);
   check_positive_finite(func, "absolute_tolerance", atol);
   check_positive(func, "max_num_steps", max_num_steps);
+  if (upper_bandwidth >= 0) {
+    check_less(func, "upper_bandwidth", upper_bandwidth, yy0.size());
+    check_less(func, "lower_bandwidth", lower_bandwidth, yy0.size());
+  }
 
   const auto& args_ref_tuple = std::make_tuple(to_ref(args)...);
   math::apply(
@@ -78,7 +87,8 @@ dae_tol_impl(const char* func, const F& f, const T_yy& yy0, const T_yp& yp0,
       [&](const auto&... args_refs) {
         dae_system<F, T_yy, T_yp, ref_type_t<T_Args>...> dae(f, yy0, yp0, msgs,
                                                              args_refs...);
-        idas_integrator integ(rtol, atol, max_num_steps);
+        idas_integrator integ(rtol, atol, max_num_steps, upper_bandwidth,
+                              lower_bandwidth);
         return integ(func, dae, t0, ts);
       },
       args_ref_tuple);
@@ -126,7 +136,68 @@ dae_tol(const F& f, const T_yy& yy0, const T_yp& yp0, double t0,
         const std::vector<double>& ts, double rtol, double atol,
         int64_t max_num_steps, std::ostream* msgs, const T_Args&... args) {
   return dae_tol_impl("dae_tol", f, yy0, yp0, t0, ts, rtol, atol, max_num_steps,
-                      msgs, args...);
+                      -1, -1, msgs, args...);
+}
+
+/**
+ * Solve the DAE initial value problem f(t, y, y')=0, y(t0) = yy0, y'(t0)=yp0 at
+ * a set of times, { t1, t2, t3, ... } using IDAS, storing the iteration
+ * matrix of the Newton iterations as a band matrix.
+ *
+ * The Jacobians of \p f with respect to y and y' must be zero outside of the
+ * band, that is the derivatives of the i-th residual with respect to the j-th
+ * state and state derivative must be zero for j - i > upper_bandwidth and
+ * i - j > lower_bandwidth. IDAS then approximates the band by difference
+ * quotients with upper_bandwidth + lower_bandwidth + 1 residual evaluations
+ * and factorizes it with a banded solver.
+ *
+ * \p f must define an operator() with the signature as:
+ *   template<typename T_yy, typename T_yp, typename... T_Args>
+ *   Eigen::Matrix<stan::return_type_t<T_yy, T_yp, T_Args...>, Eigen::Dynamic,
+ * 1> operator()(double t, const Eigen::Matrix<T_yy, Eigen::Dynamic, 1>& yy,
+ *     const Eigen::Matrix<T_yp, Eigen::Dynamic, 1>& yp,
+ *     std::ostream* msgs, const T_Args&... args);
+ *
+ * t is the time, yy the vector-valued state, yp the vector-valued
+ * state derivative, msgs a stream for error
+ * messages, and args the optional arguments passed to the DAE solve function
+ * (which are passed through to \p f without modification).
+ *
+ * @tparam F Type of DAE residual functor
+ * @tparam T_yy0 Type of initial state
+ * @tparam T_yp0 Type of initial state derivatives
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f DAE residual functor
+ * @param yy0 Initial state
+ * @param yp0 Initial state derivatives
+ * @param t0 Initial time
+ * @param ts Times at which to solve the DAE at. All values must be sorted and
+ *   not less than t0.
+ * @param rtol Relative tolerance passed to IDAS
+ * @param atol Absolute tolerance passed to IDAS
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param upper_bandwidth Number of nonzero diagonals of the Jacobian of the
+ *   residual above the main diagonal
+ * @param lower_bandwidth Number of nonzero diagonals of the Jacobian of the
+ *   residual below the main diagonal
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments passed unmodified through to DAE right hand side
+ * @return Solution to DAE at times \p ts
+ */
+template <typename F, typename T_yy, typename T_yp, typename... T_Args,
+          require_all_eigen_col_vector_t<T_yy, T_yp>* = nullptr>
+std::vector<Eigen::Matrix<stan::return_type_t<T_yy, T_yp, T_Args...>, -1, 1>>
+dae_banded_tol(const F& f, const T_yy& yy0, const T_yp& yp0, double t0,
+               const std::vector<double>& ts, double rtol, double atol,
+               int64_t max_num_steps, int upper_bandwidth, int lower_bandwidth,
+               std::ostream* msgs, const T_Args&... args) {
+  check_nonnegative("dae_banded_tol", "upper_bandwidth", upper_bandwidth);
+  check_nonnegative("dae_banded_tol", "lower_bandwidth", lower_bandwidth);
+  return dae_tol_impl("dae_banded_tol", f, yy0, yp0, t0, ts, rtol, atol,
+                      max_num_steps, upper_bandwidth, lower_bandwidth, msgs,
+                      args...);
 }
 
 /**
@@ -166,8 +237,8 @@ template <typename F, typename T_yy, typename T_yp, typename... T_Args,
 std::vector<Eigen::Matrix<stan::return_type_t<T_yy, T_yp, T_Args...>, -1, 1>>
 dae(const F& f, const T_yy& yy0, const T_yp& yp0, double t0,
     const std::vector<double>& ts, std::ostream* msgs, const T_Args&... args) {
-  return dae_tol_impl("dae", f, yy0, yp0, t0, ts, 1.e-10, 1.e-10, 1e8, msgs,
-                      args...);
+  return dae_tol_impl("dae", f, yy0, yp0, t0, ts, 1.e-10, 1.e-10, 1e8, -1, -1,
+                      msgs, args...);
 }
 
 }  // namespace math
@@ -0,0 +1,197 @@
+#ifndef STAN_MATH_REV_FUNCTOR_FUSED_ELEMENTWISE_HPP
+#define STAN_MATH_REV_FUNCTOR_FUSED_ELEMENTWISE_HPP
+
+#include <stan/math/fwd/core/fvar_multi.hpp>
+#include <stan/math/fwd/fun/cos.hpp>
+#include <stan/math/fwd/fun/exp.hpp>
+#include <stan/math/fwd/fun/inv.hpp>
+#include <stan/math/fwd/fun/inv_logit.hpp>
+#include <stan/math/fwd/fun/log.hpp>
+#include <stan/math/fwd/fun/log1p.hpp>
+#include <stan/math/fwd/fun/pow.hpp>
+#include <stan/math/fwd/fun/sin.hpp>
+#include <stan/math/fwd/fun/sqrt.hpp>
+#include <stan/math/fwd/fun/square.hpp>
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/functor/fused_elementwise.hpp>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Placeholder for an argument of <code>fused_elementwise()</code>
+ * which holds no variables and is not needed in the reverse pass.
+ */
+struct fused_constant {};
+
+template <typename T, require_st_var<T>* = nullptr>
+inline arena_t<T> fused_arena(const T& x) {
+  return x;
+}
+
+template <typename T, require_not_st_var<T>* = nullptr>
+inline fused_constant fused_arena(const T& x) {
+  return {};
+}
+
+/**
+ * Return the number of arguments before the <code>I</code>-th one
+ * which hold variables, that is the index of the tangent of the
+ * <code>I</code>-th argument if it holds variables.
+ */
+template <typename... Ts>
+constexpr int fused_tangent_index(size_t I) {
+  constexpr bool holds_vars[] = {false, is_var<scalar_type_t<Ts>>::value...};
+  int index = 0;
+  for (size_t j = 0; j < I; ++j) {
+    index += holds_vars[j + 1];
+  }
+  return index;
+}
+
+/**
+ * Return the value of an argument at the specified linear index,
+ * seeded with a unit tangent if the argument holds variables.
+ */
+template <int K, int Index, typename T, typename Arena,
+          require_st_var<T>* = nullptr>
+inline fvar_multi<double, K> fused_seed(const T& x, const Arena& arena_x,
+                                        Eigen::Index i) {
+  return fvar_multi<double, K>(
+      fused_coeff(value_of(arena_x), i),
+      Eigen::Matrix<double, K, 1>::Unit(Index).array());
+}
+
+template <int K, int Index, typename T, typename Arena,
+          require_not_st_var<T>* = nullptr>
+inline decltype(auto) fused_seed(const T& x, const Arena& arena_x,
+                                 Eigen::Index i) {
+  return fused_coeff(x, i);
+}
+
+template <int K, typename... Args, typename F, typename Ret,
+          typename Partials, typename Arenas, size_t... Is>
+inline void fused_forward(const F& f, Ret& ret, Partials& partials,
+                          const Arenas& arenas, std::index_sequence<Is...>,
+                          const Args&... args) {
+  for (Eigen::Index i = 0; i < ret.size(); ++i) {
+    const fvar_multi<double, K> res
+        = f(fused_seed<K, fused_tangent_index<Args...>(Is), Args>(
+            args, std::get<Is>(arenas), i)...);
+    ret.coeffRef(i) = res.val_;
+    partials.col(i) = res.d_.matrix();
+  }
+}
+
+/**
+ * Add the adjoint of the result times the partials of the result with
+ * respect to an argument to the adjoints of the argument.
+ */
+template <int Index, typename Partials, typename RetAdj>
+inline void fused_chain(fused_constant& x, const Partials& partials,
+                        const RetAdj& ret_adj) {}
+
+template <int Index, typename Partials, typename RetAdj>
+inline void fused_chain(var& x, const Partials& partials,
+                        const RetAdj& ret_adj) {
+  double adj = 0;
+  for (Eigen::Index i = 0; i < ret_adj.size(); ++i) {
+    adj += partials.coeff(Index, i) * ret_adj.coeff(i);
+  }
+  x.adj() += adj;
+}
+
+template <int Index, typename T, typename Partials, typename RetAdj,
+          require_rev_matrix_t<T>* = nullptr>
+inline void fused_chain(T& x, const Partials& partials,
+                        const RetAdj& ret_adj) {
+  for (Eigen::Index i = 0; i < ret_adj.size(); ++i) {
+    x.adj().coeffRef(i) += partials.coeff(Index, i) * ret_adj.coeff(i);
+  }
+}
+
+template <typename... Args, typename Arenas, typename Partials,
+          typename RetAdj, size_t... Is>
+inline void fused_reverse(Arenas& arenas, const Partials& partials,
+                          const RetAdj& ret_adj, std::index_sequence<Is...>) {
+  static_cast<void>(std::initializer_list<int>{
+      (fused_chain<fused_tangent_index<Args...>(Is)>(std::get<Is>(arenas),
+                                                     partials, ret_adj),
+       0)...});
+}
+
+}  // namespace internal
+
+/**
+ * Return the result of applying the specified scalar function to the
+ * elements of the specified matrices in a single loop, recording a
+ * single node on the autodiff stack.
+ *
+ * The arguments are matrices of the same dimensions, or scalars which
+ * are passed to every call of the function.  With reverse mode
+ * arguments, the function is evaluated on each element with a
+ * <code>fvar_multi&lt;double, K&gt;</code> seeded with one tangent for
+ * each of the <code>K</code> arguments holding variables, which gives
+ * the value and the partials of the element in one evaluation.  Only
+ * the result and the <code>K</code> partials of each element are kept
+ * for the reverse pass, which is a single callback adding the adjoint
+ * of each element times its partials to the arguments.  An expression
+ * such as <code>exp(elt_multiply(a, b) + c)</code>, which creates
+ * three intermediate matrices and callbacks, thus takes one.
+ *
+ * The function must accept <code>fvar_multi</code> arguments, which
+ * support arithmetic, <code>exp</code>, <code>log</code>,
+ * <code>sqrt</code>, <code>square</code>, <code>inv</code>,
+ * <code>sin</code>, <code>cos</code>, <code>log1p</code>,
+ * <code>inv_logit</code> and <code>pow</code>.  Their overloads are
+ * included here so that reverse mode code needs only
+ * <code>stan/math/rev.hpp</code>.
+ *
+ * The result is a <code>var_value</code> matrix if any argument is
+ * one, and an Eigen matrix of <code>var</code> otherwise.
+ *
+ * @tparam F Type of scalar function
+ * @tparam Args Types of arguments, matrices or scalars
+ * @param f Scalar function
+ * @param args Arguments, at least one of which is a matrix
+ * @return Matrix of the results of the function
+ * @throw std::invalid_argument if the dimensions of the matrix
+ * arguments do not match
+ */
+template <typename F, typename... Args, require_any_st_var<Args...>* = nullptr,
+          require_any_matrix_t<Args...>* = nullptr>
+inline auto fused_elementwise(const F& f, const Args&... args) {
+  constexpr int K = internal::fused_tangent_index<Args...>(sizeof...(Args));
+  using T_matrix = internal::fused_matrix_t<Args...>;
+  using ret_val_type = Eigen::Matrix<double, T_matrix::RowsAtCompileTime,
+                                     T_matrix::ColsAtCompileTime>;
+  using ret_type = return_var_matrix_t<ret_val_type, Args...>;
+  Eigen::Index rows = -1;
+  Eigen::Index cols = -1;
+  static_cast<void>(std::initializer_list<int>{
+      (internal::fused_dims(args, rows, cols), 0)...});
+
+  auto arenas = std::make_tuple(internal::fused_arena(args)...);
+  arena_t<ret_val_type> ret_val(rows, cols);
+  arena_t<Eigen::Matrix<double, K, Eigen::Dynamic>> partials(K, rows * cols);
+  internal::fused_forward<K, Args...>(f, ret_val, partials, arenas,
+                                      std::index_sequence_for<Args...>{},
+                                      args...);
+  arena_t<ret_type> ret(ret_val);
+  reverse_pass_callback([arenas, partials, ret]() mutable {
+    internal::fused_reverse<Args...>(arenas, partials, ret.adj(),
+                                     std::index_sequence_for<Args...>{});
+  });
+  return ret_type(ret);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
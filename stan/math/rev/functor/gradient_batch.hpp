@@ -0,0 +1,116 @@
+#ifndef STAN_MATH_REV_FUNCTOR_GRADIENT_BATCH_HPP
+#define STAN_MATH_REV_FUNCTOR_GRADIENT_BATCH_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/nested_parallel_for.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/constants.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+
+/**
+ * Calculate the values and gradients of the specified function at the
+ * rows <code>start</code> to <code>end - 1</code> of the specified
+ * matrix, each in its own nested autodiff scope on the autodiff stack
+ * of the calling thread.  A row for which the function throws gets
+ * NaN values and gradient and keeps the exception.
+ */
+template <typename F>
+void gradient_batch_rows(
+    const F& f, const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& X,
+    Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& grad_fx,
+    std::vector<std::exception_ptr>& errors, Eigen::Index start,
+    Eigen::Index end) {
+  for (Eigen::Index b = start; b < end; ++b) {
+    try {
+      // recovering the nested memory keeps the arena of the thread
+      // allocated for the next row
+      nested_rev_autodiff nested;
+      Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(X.row(b).transpose());
+      var fx_var = f(x_var);
+      grad(fx_var.vi_);
+      fx.coeffRef(b) = fx_var.val();
+      grad_fx.row(b) = x_var.adj().transpose();
+    } catch (...) {
+      fx.coeffRef(b) = NOT_A_NUMBER;
+      grad_fx.row(b).setConstant(NOT_A_NUMBER);
+      errors[b] = std::current_exception();
+    }
+  }
+}
+
+}  // namespace internal
+
+/**
+ * Calculate the values and the gradients of the specified function
+ * at each row of the specified matrix, evaluating the rows
+ * concurrently on the TBB thread pool.
+ *
+ * <p>The functor must implement
+ *
+ * <code>
+ * var
+ * operator()(const
+ * Eigen::Matrix<var, Eigen::Dynamic, 1>&)
+ * </code>
+ *
+ * as for <code>gradient()</code> and must be safe to call from several
+ * threads at once.
+ *
+ * The rows are split into chunks of at least <code>grainsize</code>
+ * rows by <code>internal::nested_parallel_for</code>, which evaluates
+ * them serially unless <code>STAN_THREADS</code> is defined.  Each row
+ * is evaluated in a nested autodiff scope whose memory is recovered
+ * but not freed, so every thread reuses the arena of its stack for all
+ * the rows it evaluates.  The value and the gradient at row
+ * <code>b</code> of <code>X</code> are written to <code>fx(b)</code>
+ * and row <code>b</code> of <code>grad_fx</code>.
+ *
+ * Errors are isolated to the rows they occur in.  If the function
+ * throws at a row, the value and the gradient of that row are set to
+ * NaN and the exception is stored at the index of the row in the
+ * returned vector, while the other rows are evaluated as usual.
+ *
+ * @tparam F Type of function
+ * @param[in] f Function
+ * @param[in] X Arguments to function, one per row
+ * @param[out] fx Function applied to each argument
+ * @param[out] grad_fx Gradients of function at each argument, one per
+ * row
+ * @param[in] grainsize minimum number of rows per chunk
+ * @return exception thrown by the function at each row, or a null
+ * pointer for the rows which succeeded
+ * @throw std::domain_error if grainsize is not positive
+ */
+template <typename F>
+std::vector<std::exception_ptr> gradient_batch(
+    const F& f, const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& X,
+    Eigen::Matrix<double, Eigen::Dynamic, 1>& fx,
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& grad_fx,
+    int grainsize = 1) {
+  check_positive("gradient_batch", "grainsize", grainsize);
+  fx.resize(X.rows());
+  grad_fx.resize(X.rows(), X.cols());
+  std::vector<std::exception_ptr> errors(X.rows());
+  if (X.rows() == 0) {
+    return errors;
+  }
+  internal::nested_parallel_for(
+      X.rows(), grainsize, [&](std::size_t start, std::size_t end) {
+        internal::gradient_batch_rows(f, X, fx, grad_fx, errors, start, end);
+      });
+  return errors;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -8,6 +8,7 @@
 #include <idas/idas.h>
 #include <sunmatrix/sunmatrix_dense.h>
 #include <sunlinsol/sunlinsol_dense.h>
+#include <sunlinsol/sunlinsol_band.h>
 #include <nvector/nvector_serial.h>
 #include <ostream>
 #include <vector>
@@ -25,6 +26,8 @@ class idas_integrator {
   const double rtol_;
   const double atol_;
   const int64_t max_num_steps_;
+  const int mupper_;
+  const int mlower_;
 
  public:
   /**
@@ -32,10 +35,19 @@ class idas_integrator {
    * @param[in] rtol relative tolerance
    * @param[in] atol absolute tolerance
    * @param[in] max_num_steps max nb. of times steps
+   * @param[in] mupper upper bandwidth of the Jacobian of the residual, or
+   * -1 for a dense Jacobian
+   * @param[in] mlower lower bandwidth of the Jacobian of the residual, or
+   * -1 for a dense Jacobian
    */
   idas_integrator(const double rtol, const double atol,
-                  const int64_t max_num_steps)
-      : rtol_(rtol), atol_(atol), max_num_steps_(max_num_steps) {}
+                  const int64_t max_num_steps, const int mupper = -1,
+                  const int mlower = -1)
+      : rtol_(rtol),
+        atol_(atol),
+        max_num_steps_(max_num_steps),
+        mupper_(mupper),
+        mlower_(mlower) {}
 
   /**
    * Return the solutions for the specified DAE
@@ -57,7 +69,7 @@ class idas_integrator {
   typename dae_type::return_t operator()(const char* func, dae_type& dae,
                                          double t0,
                                          const std::vector<double>& ts) {
-    idas_service<dae_type> serv(t0, dae);
+    idas_service<dae_type> serv(t0, dae, mupper_, mlower_);
 
     void* mem = serv.mem;
     N_Vector& yy = serv.nv_yy;
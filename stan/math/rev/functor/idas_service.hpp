@@ -8,7 +8,9 @@
 #include <idas/idas.h>
 #include <nvector/nvector_serial.h>
 #include <sunmatrix/sunmatrix_dense.h>
+#include <sunmatrix/sunmatrix_band.h>
 #include <sunlinsol/sunlinsol_dense.h>
+#include <sunlinsol/sunlinsol_band.h>
 #include <sundials/sundials_context.h>
 #include <ostream>
 #include <vector>
@@ -41,12 +43,19 @@ struct idas_service {
   SUNLinearSolver LS;
 
   /**
-   * Construct IDAS ODE mem & workspace
+   * Construct IDAS ODE mem & workspace. With nonnegative bandwidths the
+   * iteration matrix is a band matrix, which IDAS approximates by
+   * difference quotients with mupper + mlower + 1 residual evaluations
+   * and factorizes with its banded solver.
    *
    * @param t0 initial time
    * @param dae differential-algebraic system of equations
+   * @param mupper upper bandwidth of the iteration matrix, or -1 for a
+   * dense matrix
+   * @param mlower lower bandwidth of the iteration matrix, or -1 for a
+   * dense matrix
    */
-  idas_service(double t0, dae_type& dae)
+  idas_service(double t0, dae_type& dae, int mupper = -1, int mlower = -1)
       : sundials_context_(),
         ns(dae.ns),
         nv_yy(N_VNew_Serial(dae.N, sundials_context_)),
@@ -54,8 +63,12 @@ struct idas_service {
         nv_yys(nullptr),
         nv_yps(nullptr),
         mem(IDACreate(sundials_context_)),
-        A(SUNDenseMatrix(dae.N, dae.N, sundials_context_)),
-        LS(SUNLinSol_Dense(nv_yy, A, sundials_context_)) {
+        A(mupper < 0 || mlower < 0
+              ? SUNDenseMatrix(dae.N, dae.N, sundials_context_)
+              : SUNBandMatrix(dae.N, mupper, mlower, sundials_context_)),
+        LS(mupper < 0 || mlower < 0
+               ? SUNLinSol_Dense(nv_yy, A, sundials_context_)
+               : SUNLinSol_Band(nv_yy, A, sundials_context_)) {
     const int n = dae.N;
     for (auto i = 0; i < n; ++i) {
       NV_Ith_S(nv_yy, i) = dae.dbl_yy[i];
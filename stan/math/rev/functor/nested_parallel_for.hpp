@@ -0,0 +1,53 @@
+#ifndef STAN_MATH_REV_FUNCTOR_NESTED_PARALLEL_FOR_HPP
+#define STAN_MATH_REV_FUNCTOR_NESTED_PARALLEL_FOR_HPP
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <cstddef>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Call <code>f(start, end)</code> for chunks of consecutive indices
+ * which together cover <code>[0, n)</code>, each chunk holding at least
+ * <code>grainsize</code> indices.
+ *
+ * If <code>STAN_THREADS</code> is defined the chunks run concurrently
+ * on the TBB thread pool, each on the autodiff stack of the thread it
+ * is scheduled on, so <code>f</code> has to run its autodiff in a
+ * nested scope and must be safe to call from several threads at once.
+ * The tasks are isolated, as in <code>map_rect_concurrent</code>,
+ * which keeps the calling thread from picking up unrelated tasks of
+ * its arena while it waits and running them on its nested stack.
+ * Without <code>STAN_THREADS</code> the autodiff stack is shared by
+ * all threads and <code>f(0, n)</code> is called on the calling
+ * thread.
+ *
+ * @tparam F type of functor
+ * @param n number of indices
+ * @param grainsize minimum number of indices per chunk
+ * @param f functor called with the first and one past the last index
+ * of a chunk
+ */
+template <typename F>
+inline void nested_parallel_for(std::size_t n, std::size_t grainsize,
+                                const F& f) {
+#ifdef STAN_THREADS
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n, grainsize),
+                      [&](const tbb::blocked_range<std::size_t>& r) {
+                        f(r.begin(), r.end());
+                      });
+  });
+#else
+  f(0, n);
+#endif
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
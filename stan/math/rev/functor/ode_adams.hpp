@@ -112,6 +112,81 @@ ode_adams_tol(const F& f, const T_y0& y0, const T_t0& t0,
                             absolute_tolerance, max_num_steps, msgs, args...);
 }
 
+/**
+ * Solve the ODE initial value problem y' = f(t, y), y(t0) = y0 at a set of
+ * times, { t1, t2, t3, ... } using the non-stiff Adams-Moulton
+ * solver from CVODES, storing the Jacobian of \p f
+ * with respect to the states as a band matrix.
+ *
+ * The Jacobian must be zero outside of the band, that is the derivative of
+ * the i-th element of the RHS with respect to the j-th state must be zero
+ * for j - i > upper_bandwidth and i - j > lower_bandwidth. If \p f also
+ * accepts states of type <code>fvar<double></code>, the band is computed
+ * in forward mode with upper_bandwidth + lower_bandwidth + 1 evaluations
+ * of \p f, and otherwise it is taken from the full Jacobian in reverse
+ * mode. It is factorized with a banded solver.
+ *
+ * \p f must define an operator() with the signature as:
+ *   template<typename T_t, typename T_y, typename... T_Args>
+ *   Eigen::Matrix<stan::return_type_t<T_t, T_y, T_Args...>, Eigen::Dynamic, 1>
+ *     operator()(const T_t& t, const Eigen::Matrix<T_y, Eigen::Dynamic, 1>& y,
+ *     std::ostream* msgs, const T_Args&... args);
+ *
+ * t is the time, y is the vector-valued state, msgs is a stream for error
+ * messages, and args are optional arguments passed to the ODE solve function
+ * (which are passed through to \p f without modification).
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial state
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state
+ * @param t0 Initial time
+ * @param ts Times at which to solve the ODE at. All values must be sorted and
+ *   not less than t0.
+ * @param relative_tolerance Relative tolerance passed to CVODES
+ * @param absolute_tolerance Absolute tolerance passed to CVODES
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param upper_bandwidth Number of nonzero diagonals of the Jacobian above
+ *   the main diagonal
+ * @param lower_bandwidth Number of nonzero diagonals of the Jacobian below
+ *   the main diagonal
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments passed unmodified through to ODE right hand side
+ * @return Solution to ODE at times \p ts
+ * @throw std::domain_error if a bandwidth is negative or not less than the
+ *   number of states
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<Eigen::Matrix<stan::return_type_t<T_y0, T_t0, T_ts, T_Args...>,
+                          Eigen::Dynamic, 1>>
+ode_adams_banded_tol(const F& f, const T_y0& y0, const T_t0& t0,
+                     const std::vector<T_ts>& ts, double relative_tolerance,
+                     double absolute_tolerance,
+                     long int max_num_steps,  // NOLINT(runtime/int)
+                     int upper_bandwidth, int lower_bandwidth,
+                     std::ostream* msgs, const T_Args&... args) {
+  static const char* function_name = "ode_adams_banded_tol";
+  check_nonnegative(function_name, "upper_bandwidth", upper_bandwidth);
+  check_nonnegative(function_name, "lower_bandwidth", lower_bandwidth);
+  const auto& args_ref_tuple = std::make_tuple(to_ref(args)...);
+  return math::apply(
+      [&](const auto&... args_refs) {
+        cvodes_integrator<CV_ADAMS, F, T_y0, T_t0, T_ts, ref_type_t<T_Args>...>
+        integrator(function_name, f, y0, t0, ts, relative_tolerance,
+                   absolute_tolerance, max_num_steps, upper_bandwidth,
+                   lower_bandwidth, msgs, args_refs...);
+
+        return integrator();
+      },
+      args_ref_tuple);
+}
+
 /**
  * Solve the ODE initial value problem y' = f(t, y), y(t0) = y0 at a set of
  * times, { t1, t2, t3, ... } using the non-stiff Adams-Moulton
@@ -55,8 +55,10 @@ namespace math {
  * @param num_steps_between_checkpoints Number of integrator steps after which a
  * checkpoint is stored for the backward pass
  * @param interpolation_polynomial type of polynomial used for interpolation
- * @param solver_forward solver used for forward pass
- * @param solver_backward solver used for backward pass
+ * @param solver_forward solver used for forward pass, 1 for Adams, 2 for BDF
+ * or 3 for BDF with a matrix-free Krylov linear solver
+ * @param solver_backward solver used for backward pass, 1 for Adams, 2 for BDF
+ * or 3 for BDF with a matrix-free Krylov linear solver
  * @param[in, out] msgs the print stream for warning messages
  * @param args Extra arguments passed unmodified through to ODE right hand side
  * @return An `std::vector` of Eigen column vectors with scalars equal to
@@ -139,8 +141,10 @@ auto ode_adjoint_impl(
  * @param num_steps_between_checkpoints Number of integrator steps after which a
  * checkpoint is stored for the backward pass
  * @param interpolation_polynomial type of polynomial used for interpolation
- * @param solver_forward solver used for forward pass
- * @param solver_backward solver used for backward pass
+ * @param solver_forward solver used for forward pass, 1 for Adams, 2 for BDF
+ * or 3 for BDF with a matrix-free Krylov linear solver
+ * @param solver_backward solver used for backward pass, 1 for Adams, 2 for BDF
+ * or 3 for BDF with a matrix-free Krylov linear solver
  * @param[in, out] msgs the print stream for warning messages
  * @param args Extra arguments passed unmodified through to ODE right hand side
  * @return An `std::vector` of Eigen column vectors with scalars equal to
@@ -228,8 +232,10 @@ std::vector<Eigen::VectorXd> ode_adjoint_impl(
  * @param num_steps_between_checkpoints Number of integrator steps after which a
  * checkpoint is stored for the backward pass
  * @param interpolation_polynomial type of polynomial used for interpolation
- * @param solver_forward solver used for forward pass
- * @param solver_backward solver used for backward pass
+ * @param solver_forward solver used for forward pass, 1 for Adams, 2 for BDF
+ * or 3 for BDF with a matrix-free Krylov linear solver
+ * @param solver_backward solver used for backward pass, 1 for Adams, 2 for BDF
+ * or 3 for BDF with a matrix-free Krylov linear solver
  * @param[in, out] msgs the print stream for warning messages
  * @param args Extra arguments passed unmodified through to ODE right hand side
  * @return An `std::vector` of Eigen column vectors with scalars equal to
@@ -0,0 +1,537 @@
+#ifndef STAN_MATH_REV_FUNCTOR_ODE_BATCH_HPP
+#define STAN_MATH_REV_FUNCTOR_ODE_BATCH_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/ode_adams.hpp>
+#include <stan/math/rev/functor/ode_bdf.hpp>
+#include <stan/math/rev/functor/nested_parallel_for.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <stan/math/prim/functor/ode_rk45.hpp>
+
+#include <initializer_list>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Values and sensitivities of the solution of one subject of a batch of
+ * ODE solves, held in ordinary memory such that they can be computed on
+ * any thread.
+ */
+struct ode_batch_subject {
+  /// The states at the output times as columns
+  Eigen::MatrixXd y_;
+  /// The gradients of the elements of y_ with respect to the vars of the
+  /// subject as columns, in the column major order of y_
+  Eigen::MatrixXd jacobian_;
+};
+
+/**
+ * Solve the ODE of one subject with arithmetic inputs.
+ *
+ * @tparam Solve Type of solver functor
+ * @tparam T_y0 Type of initial state
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param[out] result Values of the solution
+ * @param solve Functor solving the ODE, called as
+ *   <code>solve(y0, t0, ts, args...)</code>
+ * @param y0 Initial state
+ * @param t0 Initial time
+ * @param ts Output times
+ * @param args Extra arguments passed unmodified through to ODE right hand side
+ */
+template <typename Solve, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args,
+          require_all_arithmetic_t<scalar_type_t<T_y0>, T_t0, T_ts,
+                                   scalar_type_t<T_Args>...>* = nullptr>
+inline void ode_batch_solve_subject(ode_batch_subject& result,
+                                    const Solve& solve, const T_y0& y0,
+                                    const T_t0& t0, const std::vector<T_ts>& ts,
+                                    const T_Args&... args) {
+  const auto ys = solve(y0, t0, ts, args...);
+  result.y_.resize(y0.size(), ys.size());
+  for (size_t j = 0; j < ys.size(); ++j) {
+    result.y_.col(j) = ys[j];
+  }
+}
+
+/**
+ * Solve the ODE of one subject with autodiff inputs on a nested tape of
+ * the current thread and compute the gradients of every output element
+ * with respect to the vars of the subject. The inputs are deep copied
+ * onto the nested tape such that the tape of the thread owning them is
+ * never touched.
+ *
+ * @tparam Solve Type of solver functor
+ * @tparam T_y0 Type of initial state
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param[out] result Values and sensitivities of the solution
+ * @param solve Functor solving the ODE, called as
+ *   <code>solve(y0, t0, ts, args...)</code>
+ * @param y0 Initial state
+ * @param t0 Initial time
+ * @param ts Output times
+ * @param args Extra arguments passed unmodified through to ODE right hand side
+ */
+template <typename Solve, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args,
+          require_any_var_t<scalar_type_t<T_y0>, T_t0, T_ts,
+                            scalar_type_t<T_Args>...>* = nullptr>
+inline void ode_batch_solve_subject(ode_batch_subject& result,
+                                    const Solve& solve, const T_y0& y0,
+                                    const T_t0& t0, const std::vector<T_ts>& ts,
+                                    const T_Args&... args) {
+  const size_t N = y0.size();
+  const size_t num_vars = count_vars(y0, t0, ts, args...);
+
+  nested_rev_autodiff nested;
+
+  const auto y0_copy = deep_copy_vars(y0);
+  const auto t0_copy = deep_copy_vars(t0);
+  const auto ts_copy = deep_copy_vars(ts);
+  const auto args_copy = std::make_tuple(deep_copy_vars(args)...);
+
+  auto ys = math::apply(
+      [&](const auto&... args_copy_refs) {
+        return solve(y0_copy, t0_copy, ts_copy, args_copy_refs...);
+      },
+      args_copy);
+
+  result.y_.resize(N, ys.size());
+  result.jacobian_ = Eigen::MatrixXd::Zero(num_vars, N * ys.size());
+  for (size_t j = 0; j < ys.size(); ++j) {
+    for (size_t i = 0; i < N; ++i) {
+      result.y_.coeffRef(i, j) = ys[j].coeff(i).val();
+      nested.set_zero_all_adjoints();
+      ys[j].coeffRef(i).grad();
+      double* jacobian_col = result.jacobian_.col(j * N + i).data();
+      math::apply(
+          [&](const auto&... args_copy_refs) {
+            accumulate_adjoints(jacobian_col, y0_copy, t0_copy, ts_copy,
+                                args_copy_refs...);
+          },
+          args_copy);
+    }
+  }
+}
+
+/**
+ * Return the solution of one subject held by an ode_batch_subject.
+ *
+ * @param result Values of the solution
+ * @return Solution at the output times
+ */
+template <typename T_y0, typename T_t0, typename T_ts, typename... T_Args,
+          require_all_arithmetic_t<scalar_type_t<T_y0>, T_t0, T_ts,
+                                   scalar_type_t<T_Args>...>* = nullptr>
+inline std::vector<Eigen::VectorXd> ode_batch_outputs(
+    const ode_batch_subject& result, const T_y0& y0, const T_t0& t0,
+    const std::vector<T_ts>& ts, const T_Args&... args) {
+  std::vector<Eigen::VectorXd> ys(result.y_.cols());
+  for (size_t j = 0; j < ys.size(); ++j) {
+    ys[j] = result.y_.col(j);
+  }
+  return ys;
+}
+
+/**
+ * Return the solution of one subject held by an ode_batch_subject as
+ * vars on the tape of the current thread, storing the sensitivities in
+ * precomputed varis that point to the vars of the subject.
+ *
+ * @param result Values and sensitivities of the solution
+ * @param y0 Initial state
+ * @param t0 Initial time
+ * @param ts Output times
+ * @param args Extra arguments passed unmodified through to ODE right hand side
+ * @return Solution at the output times
+ */
+template <typename T_y0, typename T_t0, typename T_ts, typename... T_Args,
+          require_any_var_t<scalar_type_t<T_y0>, T_t0, T_ts,
+                            scalar_type_t<T_Args>...>* = nullptr>
+inline std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>> ode_batch_outputs(
+    const ode_batch_subject& result, const T_y0& y0, const T_t0& t0,
+    const std::vector<T_ts>& ts, const T_Args&... args) {
+  const size_t N = result.y_.rows();
+  const size_t num_vars = result.jacobian_.rows();
+
+  vari** varis
+      = ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_vars);
+  save_varis(varis, y0, t0, ts, args...);
+
+  double* jacobian_mem
+      = ChainableStack::instance_->memalloc_.alloc_array<double>(
+          result.jacobian_.size());
+  Eigen::Map<Eigen::MatrixXd>(jacobian_mem, num_vars, result.jacobian_.cols())
+      = result.jacobian_;
+
+  std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>> ys(
+      result.y_.cols(), Eigen::Matrix<var, Eigen::Dynamic, 1>(N));
+  for (size_t j = 0; j < ys.size(); ++j) {
+    for (size_t i = 0; i < N; ++i) {
+      ys[j].coeffRef(i) = new precomputed_gradients_vari(
+          result.y_.coeff(i, j), num_vars, varis,
+          jacobian_mem + (j * N + i) * num_vars);
+    }
+  }
+  return ys;
+}
+
+/**
+ * Solve the ODEs of a batch of independent subjects.
+ *
+ * The subjects are solved with nested_parallel_for, so if STAN_THREADS
+ * is defined they are solved concurrently on the TBB, each on a nested
+ * AD tape of the thread solving it. The solutions are then stored on
+ * the tape of the calling thread, with one precomputed vari per output
+ * element holding its gradient.
+ *
+ * @tparam Solve Type of solver functor
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param function_name Calling function name (for printing debugging messages)
+ * @param solve Functor solving the ODE of one subject, called as
+ *   <code>solve(y0, t0, ts, args...)</code>
+ * @param y0 Initial state of every subject
+ * @param t0 Initial time shared by all subjects
+ * @param ts Output times of every subject
+ * @param args Extra arguments of every subject
+ * @return Solution of every subject at its output times
+ */
+template <typename Solve, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args>
+std::vector<std::vector<Eigen::Matrix<
+    return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_batch(const char* function_name, const Solve& solve,
+          const std::vector<T_y0>& y0, const T_t0& t0,
+          const std::vector<std::vector<T_ts>>& ts,
+          const std::vector<T_Args>&... args) {
+  const size_t num_subjects = y0.size();
+  check_size_match(function_name, "number of initial states", num_subjects,
+                   "number of output time vectors", ts.size());
+  static_cast<void>(std::initializer_list<int>{
+      (check_size_match(function_name, "number of initial states",
+                        num_subjects, "number of arguments", args.size()),
+       0)...});
+
+  std::vector<ode_batch_subject> results(num_subjects);
+
+  nested_parallel_for(num_subjects, 1,
+                      [&](std::size_t start, std::size_t end) {
+                        for (std::size_t s = start; s != end; ++s) {
+                          ode_batch_solve_subject(results[s], solve, y0[s], t0,
+                                                  ts[s], args[s]...);
+                        }
+                      });
+
+  std::vector<std::vector<Eigen::Matrix<
+      return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+      ys;
+  ys.reserve(num_subjects);
+  for (size_t s = 0; s < num_subjects; ++s) {
+    ys.emplace_back(
+        ode_batch_outputs(results[s], y0[s], t0, ts[s], args[s]...));
+  }
+  return ys;
+}
+
+}  // namespace internal
+
+/**
+ * Solve the ODE initial value problems y_s' = f(t, y_s), y_s(t0) = y0[s]
+ * of a batch of independent subjects s at the times ts[s] using the
+ * stiff backward differentiation formula BDF solver from CVODES.
+ *
+ * Each argument is passed as a std::vector with one element per subject,
+ * and \p f is called with the elements args[s]... of the subject it
+ * integrates. Arguments shared by all subjects have to be repeated.
+ *
+ * If STAN_THREADS is defined the subjects are solved concurrently on the
+ * TBB, each with its own CVODES memory and on a nested AD tape of the
+ * thread solving it. The gradients of the solutions are stored on the
+ * tape of the calling thread once all subjects are solved.
+ *
+ * \p f must define an operator() as described for ode_bdf_tol.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of every subject
+ * @param t0 Initial time shared by all subjects
+ * @param ts Times at which to solve the ODE of every subject. All values
+ *   must be sorted and not less than t0.
+ * @param relative_tolerance Relative tolerance passed to CVODES
+ * @param absolute_tolerance Absolute tolerance passed to CVODES
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of every subject passed through to ODE right
+ *   hand side
+ * @return Solution of every subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_bdf_batch_tol(const F& f, const std::vector<T_y0>& y0, const T_t0& t0,
+                  const std::vector<std::vector<T_ts>>& ts,
+                  double relative_tolerance, double absolute_tolerance,
+                  long int max_num_steps,  // NOLINT(runtime/int)
+                  std::ostream* msgs, const std::vector<T_Args>&... args) {
+  const char* function_name = "ode_bdf_batch_tol";
+  return internal::ode_batch(
+      function_name,
+      [&](const auto& y0_s, const auto& t0_s, const auto& ts_s,
+          const auto&... args_s) {
+        return ode_bdf_tol_impl(function_name, f, y0_s, t0_s, ts_s,
+                                relative_tolerance, absolute_tolerance,
+                                max_num_steps, msgs, args_s...);
+      },
+      y0, t0, ts, args...);
+}
+
+/**
+ * Solve the ODE initial value problems of a batch of independent subjects
+ * with the stiff BDF solver from CVODES and the default tolerances of
+ * ode_bdf, as described for ode_bdf_batch_tol.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of every subject
+ * @param t0 Initial time shared by all subjects
+ * @param ts Times at which to solve the ODE of every subject. All values
+ *   must be sorted and not less than t0.
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of every subject passed through to ODE right
+ *   hand side
+ * @return Solution of every subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_bdf_batch(const F& f, const std::vector<T_y0>& y0, const T_t0& t0,
+              const std::vector<std::vector<T_ts>>& ts, std::ostream* msgs,
+              const std::vector<T_Args>&... args) {
+  const char* function_name = "ode_bdf_batch";
+  double relative_tolerance = 1e-10;
+  double absolute_tolerance = 1e-10;
+  long int max_num_steps = 1e8;  // NOLINT(runtime/int)
+  return internal::ode_batch(
+      function_name,
+      [&](const auto& y0_s, const auto& t0_s, const auto& ts_s,
+          const auto&... args_s) {
+        return ode_bdf_tol_impl(function_name, f, y0_s, t0_s, ts_s,
+                                relative_tolerance, absolute_tolerance,
+                                max_num_steps, msgs, args_s...);
+      },
+      y0, t0, ts, args...);
+}
+
+/**
+ * Solve the ODE initial value problems of a batch of independent subjects
+ * with the non-stiff Adams-Moulton solver from CVODES, as described for
+ * ode_bdf_batch_tol.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of every subject
+ * @param t0 Initial time shared by all subjects
+ * @param ts Times at which to solve the ODE of every subject. All values
+ *   must be sorted and not less than t0.
+ * @param relative_tolerance Relative tolerance passed to CVODES
+ * @param absolute_tolerance Absolute tolerance passed to CVODES
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of every subject passed through to ODE right
+ *   hand side
+ * @return Solution of every subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_adams_batch_tol(const F& f, const std::vector<T_y0>& y0, const T_t0& t0,
+                    const std::vector<std::vector<T_ts>>& ts,
+                    double relative_tolerance, double absolute_tolerance,
+                    long int max_num_steps,  // NOLINT(runtime/int)
+                    std::ostream* msgs, const std::vector<T_Args>&... args) {
+  const char* function_name = "ode_adams_batch_tol";
+  return internal::ode_batch(
+      function_name,
+      [&](const auto& y0_s, const auto& t0_s, const auto& ts_s,
+          const auto&... args_s) {
+        return ode_adams_tol_impl(function_name, f, y0_s, t0_s, ts_s,
+                                  relative_tolerance, absolute_tolerance,
+                                  max_num_steps, msgs, args_s...);
+      },
+      y0, t0, ts, args...);
+}
+
+/**
+ * Solve the ODE initial value problems of a batch of independent subjects
+ * with the non-stiff Adams-Moulton solver from CVODES and the default
+ * tolerances of ode_adams, as described for ode_bdf_batch_tol.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of every subject
+ * @param t0 Initial time shared by all subjects
+ * @param ts Times at which to solve the ODE of every subject. All values
+ *   must be sorted and not less than t0.
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of every subject passed through to ODE right
+ *   hand side
+ * @return Solution of every subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_adams_batch(const F& f, const std::vector<T_y0>& y0, const T_t0& t0,
+                const std::vector<std::vector<T_ts>>& ts, std::ostream* msgs,
+                const std::vector<T_Args>&... args) {
+  const char* function_name = "ode_adams_batch";
+  double relative_tolerance = 1e-10;
+  double absolute_tolerance = 1e-10;
+  long int max_num_steps = 1e8;  // NOLINT(runtime/int)
+  return internal::ode_batch(
+      function_name,
+      [&](const auto& y0_s, const auto& t0_s, const auto& ts_s,
+          const auto&... args_s) {
+        return ode_adams_tol_impl(function_name, f, y0_s, t0_s, ts_s,
+                                  relative_tolerance, absolute_tolerance,
+                                  max_num_steps, msgs, args_s...);
+      },
+      y0, t0, ts, args...);
+}
+
+/**
+ * Solve the ODE initial value problems of a batch of independent subjects
+ * with the non-stiff RK45 solver from Boost, as described for
+ * ode_bdf_batch_tol.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of every subject
+ * @param t0 Initial time shared by all subjects
+ * @param ts Times at which to solve the ODE of every subject. All values
+ *   must be sorted and not less than t0.
+ * @param relative_tolerance Relative tolerance passed to Boost
+ * @param absolute_tolerance Absolute tolerance passed to Boost
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of every subject passed through to ODE right
+ *   hand side
+ * @return Solution of every subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_rk45_batch_tol(const F& f, const std::vector<T_y0>& y0, const T_t0& t0,
+                   const std::vector<std::vector<T_ts>>& ts,
+                   double relative_tolerance, double absolute_tolerance,
+                   long int max_num_steps,  // NOLINT(runtime/int)
+                   std::ostream* msgs, const std::vector<T_Args>&... args) {
+  const char* function_name = "ode_rk45_batch_tol";
+  return internal::ode_batch(
+      function_name,
+      [&](const auto& y0_s, const auto& t0_s, const auto& ts_s,
+          const auto&... args_s) {
+        return ode_rk45_tol_impl(function_name, f, y0_s, t0_s, ts_s,
+                                 relative_tolerance, absolute_tolerance,
+                                 max_num_steps, msgs, args_s...);
+      },
+      y0, t0, ts, args...);
+}
+
+/**
+ * Solve the ODE initial value problems of a batch of independent subjects
+ * with the non-stiff RK45 solver from Boost and the default tolerances of
+ * ode_rk45, as described for ode_bdf_batch_tol.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of every subject
+ * @param t0 Initial time shared by all subjects
+ * @param ts Times at which to solve the ODE of every subject. All values
+ *   must be sorted and not less than t0.
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of every subject passed through to ODE right
+ *   hand side
+ * @return Solution of every subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_rk45_batch(const F& f, const std::vector<T_y0>& y0, const T_t0& t0,
+               const std::vector<std::vector<T_ts>>& ts, std::ostream* msgs,
+               const std::vector<T_Args>&... args) {
+  const char* function_name = "ode_rk45_batch";
+  double relative_tolerance = 1e-6;
+  double absolute_tolerance = 1e-6;
+  long int max_num_steps = 1e6;  // NOLINT(runtime/int)
+  return internal::ode_batch(
+      function_name,
+      [&](const auto& y0_s, const auto& t0_s, const auto& ts_s,
+          const auto&... args_s) {
+        return ode_rk45_tol_impl(function_name, f, y0_s, t0_s, ts_s,
+                                 relative_tolerance, absolute_tolerance,
+                                 max_num_steps, msgs, args_s...);
+      },
+      y0, t0, ts, args...);
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
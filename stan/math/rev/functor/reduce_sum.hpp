@@ -9,6 +9,8 @@
 #include <tbb/parallel_reduce.h>
 #include <tbb/blocked_range.h>
 
+#include <atomic>
+#include <mutex>
 #include <tuple>
 #include <memory>
 #include <utility>
@@ -30,15 +32,80 @@ template <typename ReduceFunction, typename ReturnType, typename Vec,
           typename... Args>
 struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
                        Vec, Args...> {
+  /**
+   * Reducer-specific copies of the shared arguments on their own AD
+   * tape.
+   *
+   * Setting up a scope allocates the tape's arena and the copies, which
+   * dominates the cost of small work chunks. Scopes are therefore kept
+   * in a pool per thread once a reducer is done with them and reused by
+   * later reducers, of the same and of later calls. A scope whose
+   * copies were made during the same call is reused as is; otherwise
+   * its tape is recovered and the arguments are copied again into the
+   * already allocated arena.
+   *
+   * The adjoints of the copies are never reset during a call, so they
+   * accumulate the adjoints of the shared arguments over all work
+   * chunks evaluated with the scope. The scope is pending until the
+   * call has added them to its result, and must not be taken by another
+   * call in the meantime.
+   */
   struct scoped_args_tuple {
     ScopedChainableStack stack_;
     using args_tuple_t
         = std::tuple<decltype(deep_copy_vars(std::declval<Args>()))...>;
     std::unique_ptr<args_tuple_t> args_tuple_holder_;
+    std::size_t call_id_{0};
+    std::atomic<std::size_t> pending_call_id_{0};
 
     scoped_args_tuple() : stack_(), args_tuple_holder_(nullptr) {}
   };
 
+  /**
+   * The scopes holding copies made during one call of reduce_sum.
+   */
+  struct call_scopes {
+    std::size_t call_id_;
+    std::mutex mutex_;
+    std::vector<scoped_args_tuple*> scopes_;
+
+    explicit call_scopes(std::size_t call_id) : call_id_(call_id) {}
+
+    inline void add(scoped_args_tuple* scope) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      scopes_.push_back(scope);
+    }
+
+    /**
+     * Release the scopes for use by other calls, also if the call
+     * failed.
+     */
+    ~call_scopes() {
+      for (auto* scope : scopes_) {
+        scope->pending_call_id_.store(0, std::memory_order_release);
+      }
+    }
+  };
+
+  using scope_pool_t = std::vector<std::unique_ptr<scoped_args_tuple>>;
+
+  /**
+   * Return the pool of idle scopes of the current thread.
+   */
+  static inline scope_pool_t& scope_pool() {
+    static thread_local scope_pool_t pool;
+    return pool;
+  }
+
+  /**
+   * Return a new identifier for a call of reduce_sum. Identifiers are
+   * never zero, which marks scopes holding no copies.
+   */
+  static inline std::size_t next_call_id() {
+    static std::atomic<std::size_t> call_id{0};
+    return ++call_id;
+  }
+
   /**
    * This struct is used by the TBB to accumulate partial
    *  sums over consecutive ranges of the input. To distribute the workload,
@@ -55,42 +122,85 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
     Vec vmapped_;
     std::stringstream msgs_;
     std::tuple<Args...> args_tuple_;
-    scoped_args_tuple local_args_tuple_scope_;
+    call_scopes* call_scopes_;
+    std::unique_ptr<scoped_args_tuple> local_args_tuple_scope_;
     double sum_{0.0};
-    Eigen::VectorXd args_adjoints_{0};
 
     template <typename VecT, typename... ArgsT>
     recursive_reducer(size_t num_vars_per_term, size_t num_vars_shared_terms,
-                      double* sliced_partials, VecT&& vmapped, ArgsT&&... args)
+                      double* sliced_partials, call_scopes* scopes,
+                      VecT&& vmapped, ArgsT&&... args)
         : num_vars_per_term_(num_vars_per_term),
           num_vars_shared_terms_(num_vars_shared_terms),
           sliced_partials_(sliced_partials),
           vmapped_(std::forward<VecT>(vmapped)),
-          args_tuple_(std::forward<ArgsT>(args)...) {}
+          args_tuple_(std::forward<ArgsT>(args)...),
+          call_scopes_(scopes) {}
 
     /*
      * This is the copy operator as required for tbb::parallel_reduce
-     *   Imperative form. This requires sum_ and arg_adjoints_ be reset
-     *   to zero since the newly created reducer is used to accumulate
-     *   an independent partial sum.
+     *   Imperative form. This requires sum_ be reset to zero since the
+     *   newly created reducer is used to accumulate an independent
+     *   partial sum.
      */
     recursive_reducer(recursive_reducer& other, tbb::split)
         : num_vars_per_term_(other.num_vars_per_term_),
           num_vars_shared_terms_(other.num_vars_shared_terms_),
           sliced_partials_(other.sliced_partials_),
           vmapped_(other.vmapped_),
-          args_tuple_(other.args_tuple_) {}
+          args_tuple_(other.args_tuple_),
+          call_scopes_(other.call_scopes_) {}
+
+    /**
+     * Return the scope of this reducer to the pool of the current thread.
+     */
+    ~recursive_reducer() {
+      if (local_args_tuple_scope_) {
+        scope_pool().emplace_back(std::move(local_args_tuple_scope_));
+      }
+    }
+
+    /**
+     * Return the scope of this reducer, taking one from the pool of the
+     * current thread if it has none yet. A scope already holding copies
+     * for this call is preferred, and scopes pending for other calls
+     * are skipped.
+     */
+    inline scoped_args_tuple& local_scope() {
+      if (!local_args_tuple_scope_) {
+        auto& pool = scope_pool();
+        auto take = pool.end();
+        for (auto it = pool.begin(); it != pool.end(); ++it) {
+          const std::size_t pending
+              = (*it)->pending_call_id_.load(std::memory_order_acquire);
+          if (pending == call_scopes_->call_id_) {
+            take = it;
+            break;
+          } else if (pending == 0 && take == pool.end()) {
+            take = it;
+          }
+        }
+        if (take == pool.end()) {
+          local_args_tuple_scope_ = std::make_unique<scoped_args_tuple>();
+        } else {
+          local_args_tuple_scope_ = std::move(*take);
+          pool.erase(take);
+        }
+      }
+      return *local_args_tuple_scope_;
+    }
 
     /**
      * Compute, using nested autodiff, the value and Jacobian of
      *  `ReduceFunction` called over the range defined by r and accumulate those
-     *  in member variable sum_ (for the value) and args_adjoints_ (for the
-     *  Jacobian). The nested autodiff uses deep copies of the involved operands
-     *  ensuring that no side effects are implied to the adjoints of the input
-     *  operands which reside potentially on a autodiff tape stored in a
-     *  different thread other than the current thread of execution. This
+     *  in member variable sum_ (for the value) and the adjoints of the local
+     *  copies of the shared arguments (for the Jacobian). The nested autodiff
+     *  uses deep copies of the involved operands ensuring that no side effects
+     *  are implied to the adjoints of the input operands which reside
+     *  potentially on a autodiff tape stored in a different thread other than
+     *  the current thread of execution. This
      * function may be called multiple times per object instantiation (so the
-     * sum_ and args_adjoints_ must be accumulated, not just assigned).
+     * sum_ and the adjoints must be accumulated, not just assigned).
      *
      * @param r Range over which to compute reduce_sum
      */
@@ -99,33 +209,35 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
         return;
       }
 
-      if (args_adjoints_.size() == 0) {
-        args_adjoints_ = Eigen::VectorXd::Zero(num_vars_shared_terms_);
-      }
+      auto& scope = local_scope();
 
       // Obtain reference to a local copy of all shared arguments that do
       // not point
       //   back to main autodiff stack
 
-      if (!local_args_tuple_scope_.args_tuple_holder_) {
+      if (scope.call_id_ != call_scopes_->call_id_) {
         // shared arguments need to be copied to reducer-specific
-        // scope. In this case no need for zeroing adjoints, since the
-        // fresh copy has all adjoints set to zero.
-        local_args_tuple_scope_.stack_.execute([&]() {
+        // scope. The fresh copy has all adjoints set to zero. A scope
+        // reused from an earlier call keeps its arena, so copying does
+        // not allocate once it is warm.
+        scope.stack_.execute([&]() {
+          scope.args_tuple_holder_.reset();
+          recover_memory();
           math::apply(
               [&](auto&&... args) {
-                local_args_tuple_scope_.args_tuple_holder_ = std::make_unique<
+                scope.args_tuple_holder_ = std::make_unique<
                     typename scoped_args_tuple::args_tuple_t>(
                     deep_copy_vars(args)...);
               },
               args_tuple_);
         });
-      } else {
-        // set adjoints of shared arguments to zero
-        local_args_tuple_scope_.stack_.execute([] { set_zero_all_adjoints(); });
+        scope.call_id_ = call_scopes_->call_id_;
+        scope.pending_call_id_.store(scope.call_id_,
+                                     std::memory_order_release);
+        call_scopes_->add(&scope);
       }
 
-      auto& args_tuple_local = *(local_args_tuple_scope_.args_tuple_holder_);
+      auto& args_tuple_local = *(scope.args_tuple_holder_);
 
       // Initialize nested autodiff stack
       const nested_rev_autodiff begin_nest;
@@ -155,28 +267,17 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
       // Accumulate adjoints of sliced_arguments
       accumulate_adjoints(sliced_partials_ + r.begin() * num_vars_per_term_,
                           std::move(local_sub_slice));
-
-      // Accumulate adjoints of shared_arguments
-      math::apply(
-          [&](auto&&... args) {
-            accumulate_adjoints(args_adjoints_.data(), args...);
-          },
-          args_tuple_local);
     }
 
     /**
-     * Join reducers. Accumuluate the value (sum_) and Jacobian (arg_adoints_)
-     *   of the other reducer.
+     * Join reducers. Accumuluate the value (sum_) of the other reducer. The
+     *   adjoints of the shared arguments stay in the scopes and are added
+     *   up once all reducers are done.
      *
      * @param rhs Another partial sum
      */
     inline void join(const recursive_reducer& rhs) {
       sum_ += rhs.sum_;
-      if (args_adjoints_.size() != 0 && rhs.args_adjoints_.size() != 0) {
-        args_adjoints_ += rhs.args_adjoints_;
-      } else if (args_adjoints_.size() == 0 && rhs.args_adjoints_.size() != 0) {
-        args_adjoints_ = rhs.args_adjoints_;
-      }
       msgs_ << rhs.msgs_.str();
     }
   };
@@ -240,12 +341,14 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
     save_varis(varis, vmapped);
     save_varis(varis + num_vars_sliced_terms, args...);
 
-    for (size_t i = 0; i < num_vars_sliced_terms; ++i) {
+    for (size_t i = 0; i < num_vars_sliced_terms + num_vars_shared_terms;
+         ++i) {
       partials[i] = 0.0;
     }
 
+    call_scopes scopes(next_call_id());
     recursive_reducer worker(num_vars_per_term, num_vars_shared_terms, partials,
-                             std::forward<Vec>(vmapped),
+                             &scopes, std::forward<Vec>(vmapped),
                              std::forward<Args>(args)...);
 
     // we must use task isolation as described here:
@@ -266,8 +369,14 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
       }
     });
 
-    for (size_t i = 0; i < num_vars_shared_terms; ++i) {
-      partials[num_vars_sliced_terms + i] = worker.args_adjoints_.coeff(i);
+    // each scope holds the adjoints of the shared arguments summed over
+    // the chunks evaluated with it
+    for (auto* scope : scopes.scopes_) {
+      math::apply(
+          [&](auto&&... args) {
+            accumulate_adjoints(partials + num_vars_sliced_terms, args...);
+          },
+          *scope->args_tuple_holder_);
     }
 
     if (msgs) {
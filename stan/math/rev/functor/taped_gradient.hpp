@@ -0,0 +1,373 @@
+#ifndef STAN_MATH_REV_FUNCTOR_TAPED_GRADIENT_HPP
+#define STAN_MATH_REV_FUNCTOR_TAPED_GRADIENT_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/core/scalar_op_tape.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/err.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Gradient functor which records the expression graph of a function
+ * once and replays it for new arguments.
+ *
+ * Many log densities have control flow which does not depend on the
+ * values of the parameters, so every gradient evaluation builds the
+ * same expression graph.  The first call of a <code>taped_gradient</code>
+ * evaluates the function on the autodiff stack as
+ * <code>gradient()</code> does and, if the whole graph consists of
+ * operations recorded on the scalar operation tape (see
+ * <code>scalar_op_segment</code>), translates it into a flat program
+ * over an array of values.  Later calls recompute the values with one
+ * forward sweep over the program and the adjoints with one reverse
+ * sweep, without running the function, constructing any
+ * <code>vari</code> or touching the arena.
+ *
+ * All comparisons of variables made while recording are recorded as
+ * well, and their outcomes are checked after each forward sweep.  If
+ * any outcome differs the function would have taken a different
+ * branch, so the replayed result is discarded and the function is
+ * recorded again at the new argument.  The functions of the library
+ * which branch on the value of a variable, such as <code>fabs()</code>,
+ * <code>fdim()</code>, <code>step()</code> and <code>is_nan()</code>,
+ * record their comparisons the same way, and those which create
+ * constants from it, such as <code>floor()</code> and
+ * <code>round()</code>, are never replayed.  Branches on values
+ * extracted with <code>value_of()</code> or <code>val()</code> in the
+ * function itself are not seen and must not be used in functions
+ * passed here.
+ *
+ * The scalar operation tape is compiled in only when
+ * <code>STAN_SCALAR_OP_TAPE</code> is defined.  Otherwise, or if the
+ * function uses operations which are not on the tape, every call falls
+ * back to evaluating the function as <code>gradient()</code> does.
+ * <code>taped_hessian</code> in <code>stan/math/mix</code> extends the
+ * replay to Hessian-vector products.
+ *
+ * @tparam F Type of function
+ */
+template <typename F>
+class taped_gradient {
+ protected:
+  // slots are 32 bit to keep the program compact
+  using slot_t = std::uint32_t;
+  union operand {
+    slot_t slot_;
+    double d_;
+  };
+  struct op {
+    internal::scalar_op op_;
+    slot_t res_;
+    slot_t a_;
+    operand b_;
+  };
+  struct cmp {
+    internal::scalar_cmp cmp_;
+    slot_t a_;
+    slot_t b_;
+    double a_d_;
+    double b_d_;
+    bool result_;
+  };
+  // marks operands which are constants rather than values in a slot
+  enum : slot_t { no_slot = static_cast<slot_t>(-1) };
+
+  F f_;
+  bool recorded_{false};
+  bool replayable_{true};
+  size_t num_recordings_{0};
+  size_t num_replays_{0};
+  Eigen::Index num_inputs_{0};
+  slot_t output_{0};
+  std::vector<op> ops_;
+  std::vector<cmp> cmps_;
+  std::vector<double> vals_;
+  std::vector<double> adjs_;
+
+  /**
+   * Translate the tape starting at the specified position of the stack
+   * into a program.  Return false if it has nodes which can not be
+   * replayed.
+   */
+  bool build_program(size_t stack_begin, size_t nochain_begin,
+                     const Eigen::Matrix<var, Eigen::Dynamic, 1>& x_var,
+                     const var& fx_var,
+                     const std::vector<internal::scalar_cmp_record>& log) {
+    std::unordered_map<const vari*, slot_t> slots;
+    ops_.clear();
+    cmps_.clear();
+    vals_.clear();
+    auto slot = [&slots](const vari* vi) {
+      auto it = slots.find(vi);
+      return it == slots.end() ? no_slot : it->second;
+    };
+    auto new_slot = [&](const vari* vi) {
+      slots[vi] = static_cast<slot_t>(vals_.size());
+      vals_.push_back(vi->val_);
+    };
+    for (Eigen::Index i = 0; i < x_var.size(); ++i) {
+      if (slot(x_var.coeff(i).vi_) != no_slot) {
+        return false;
+      }
+      new_slot(x_var.coeff(i).vi_);
+    }
+    // constants created by the function, such as literals
+    const auto& nochain_stack = ChainableStack::instance_->var_nochain_stack_;
+    for (size_t n = nochain_begin; n < nochain_stack.size(); ++n) {
+      if (typeid(*nochain_stack[n]) != typeid(vari)) {
+        return false;
+      }
+      const vari* vi = static_cast<const vari*>(nochain_stack[n]);
+      if (slot(vi) == no_slot) {
+        new_slot(vi);
+      }
+    }
+    const auto& var_stack = ChainableStack::instance_->var_stack_;
+    for (size_t n = stack_begin; n < var_stack.size(); ++n) {
+      auto* segment = dynamic_cast<internal::scalar_op_segment*>(var_stack[n]);
+      if (segment == nullptr) {
+        if (typeid(*var_stack[n]) != typeid(vari)) {
+          return false;
+        }
+        // constants, the inputs are already in place
+        const vari* vi = static_cast<const vari*>(var_stack[n]);
+        if (slot(vi) == no_slot) {
+          new_slot(vi);
+        }
+        continue;
+      }
+      if (vals_.size() + segment->size_ >= no_slot) {
+        return false;
+      }
+      for (size_t i = 0; i < segment->size_; ++i) {
+        op o;
+        o.op_ = segment->ops_[i];
+        o.res_ = static_cast<slot_t>(vals_.size());
+        o.a_ = slot(segment->a_[i]);
+        if (internal::is_binary_vv(o.op_)) {
+          o.b_.slot_ = slot(segment->b_[i].vi_);
+          if (o.b_.slot_ == no_slot) {
+            return false;
+          }
+        } else {
+          o.b_.d_ = segment->b_[i].d_;
+        }
+        if (o.a_ == no_slot) {
+          return false;
+        }
+        ops_.push_back(o);
+        new_slot(&segment->res_[i]);
+      }
+    }
+    output_ = slot(fx_var.vi_);
+    if (output_ == no_slot) {
+      return false;
+    }
+    for (const auto& r : log) {
+      cmp c{r.cmp_, no_slot, no_slot, r.a_d_, r.b_d_, r.result_};
+      if (r.a_) {
+        c.a_ = slot(r.a_);
+      }
+      if (r.b_) {
+        c.b_ = slot(r.b_);
+      }
+      if ((r.a_ && c.a_ == no_slot) || (r.b_ && c.b_ == no_slot)) {
+        return false;
+      }
+      cmps_.push_back(c);
+    }
+    adjs_.resize(vals_.size());
+    return true;
+  }
+
+  /**
+   * Evaluate the function on the autodiff stack, recording the program
+   * if the function has been replayable so far.
+   */
+  void record(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x, double& fx,
+              Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+    nested_rev_autodiff nested;
+    recorded_ = false;
+    const size_t stack_begin = ChainableStack::instance_->var_stack_.size();
+    const size_t nochain_begin
+        = ChainableStack::instance_->var_nochain_stack_.size();
+    std::vector<internal::scalar_cmp_record> log;
+    Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x);
+    var fx_var;
+    {
+      struct log_guard {
+        explicit log_guard(std::vector<internal::scalar_cmp_record>* log) {
+          internal::scalar_cmp_log() = log;
+          internal::scalar_cmp_unreplayable() = false;
+        }
+        ~log_guard() { internal::scalar_cmp_log() = nullptr; }
+      } guard(replayable_ ? &log : nullptr);
+      fx_var = f_(x_var);
+    }
+    replayable_ = replayable_ && !internal::scalar_cmp_unreplayable();
+    fx = fx_var.val();
+    grad(fx_var.vi_);
+    grad_fx = x_var.adj();
+    if (replayable_) {
+      replayable_
+          = build_program(stack_begin, nochain_begin, x_var, fx_var, log);
+      recorded_ = replayable_;
+      num_inputs_ = x.size();
+      ++num_recordings_;
+    }
+  }
+
+  /**
+   * Recompute the values of the program for the specified argument and
+   * return false if a recorded comparison has a different outcome.
+   */
+  bool forward(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x) {
+    for (Eigen::Index i = 0; i < num_inputs_; ++i) {
+      vals_[i] = x.coeff(i);
+    }
+    for (const auto& o : ops_) {
+      const double b
+          = internal::is_binary_vv(o.op_) ? vals_[o.b_.slot_] : o.b_.d_;
+      vals_[o.res_] = internal::scalar_op_value(o.op_, vals_[o.a_], b);
+    }
+    for (const auto& c : cmps_) {
+      const double a = c.a_ == no_slot ? c.a_d_ : vals_[c.a_];
+      const double b = c.b_ == no_slot ? c.b_d_ : vals_[c.b_];
+      if (internal::scalar_cmp_value(c.cmp_, a, b) != c.result_) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Propagate the adjoints of the program from the output back to the
+   * inputs.
+   */
+  void reverse() {
+    std::fill(adjs_.begin(), adjs_.end(), 0.0);
+    adjs_[output_] = 1.0;
+    using internal::scalar_op;
+    for (size_t i = ops_.size(); i-- > 0;) {
+      const op& o = ops_[i];
+      const double adj = adjs_[o.res_];
+      const double a = vals_[o.a_];
+      double& a_adj = adjs_[o.a_];
+      switch (o.op_) {
+        case scalar_op::add_vv:
+          a_adj += adj;
+          adjs_[o.b_.slot_] += adj;
+          break;
+        case scalar_op::add_vd:
+        case scalar_op::subtract_vd:
+          a_adj += adj;
+          break;
+        case scalar_op::subtract_vv:
+          a_adj += adj;
+          adjs_[o.b_.slot_] -= adj;
+          break;
+        case scalar_op::subtract_dv:
+        case scalar_op::negate_v:
+          a_adj -= adj;
+          break;
+        case scalar_op::multiply_vv:
+          a_adj += vals_[o.b_.slot_] * adj;
+          adjs_[o.b_.slot_] += a * adj;
+          break;
+        case scalar_op::multiply_vd:
+          a_adj += adj * o.b_.d_;
+          break;
+        case scalar_op::divide_vv: {
+          const double b = vals_[o.b_.slot_];
+          a_adj += adj / b;
+          adjs_[o.b_.slot_] -= adj * a / (b * b);
+          break;
+        }
+        case scalar_op::divide_vd:
+          a_adj += adj / o.b_.d_;
+          break;
+        case scalar_op::divide_dv:
+          a_adj -= adj * o.b_.d_ / (a * a);
+          break;
+        case scalar_op::exp_v:
+          a_adj += adj * vals_[o.res_];
+          break;
+        case scalar_op::log_v:
+          a_adj += adj / a;
+          break;
+        case scalar_op::sqrt_v:
+          a_adj += adj / (2.0 * vals_[o.res_]);
+          break;
+        case scalar_op::square_v:
+          a_adj += adj * 2.0 * a;
+          break;
+      }
+    }
+  }
+
+ public:
+  /**
+   * Construct a taped gradient for the specified function.
+   *
+   * @param f Function taking an <code>Eigen::Matrix<var, -1, 1></code>
+   * and returning a <code>var</code>
+   */
+  explicit taped_gradient(const F& f) : f_(f) {}
+
+  /**
+   * Calculate the value and the gradient of the function at the
+   * specified argument, replaying the recorded program if there is
+   * one.
+   *
+   * @param[in] x Argument to function
+   * @param[out] fx Function applied to argument
+   * @param[out] grad_fx Gradient of function at argument
+   */
+  void operator()(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                  double& fx,
+                  Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+    if (recorded_ && x.size() == num_inputs_ && forward(x)) {
+      reverse();
+      fx = vals_[output_];
+      grad_fx.resize(num_inputs_);
+      for (Eigen::Index i = 0; i < num_inputs_; ++i) {
+        grad_fx.coeffRef(i) = adjs_[i];
+      }
+      ++num_replays_;
+      return;
+    }
+    record(x, fx, grad_fx);
+  }
+
+  /**
+   * Return true if the function is recorded and will be replayed.
+   */
+  inline bool recorded() const { return recorded_; }
+
+  /**
+   * Return the number of times the function has been recorded.
+   */
+  inline size_t num_recordings() const { return num_recordings_; }
+
+  /**
+   * Return the number of evaluations computed by replaying.
+   */
+  inline size_t num_replays() const { return num_replays_; }
+
+  /**
+   * Return the number of operations in the recorded program.
+   */
+  inline size_t size() const { return ops_.size(); }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
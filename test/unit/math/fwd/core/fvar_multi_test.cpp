@@ -0,0 +1,95 @@
+#include <stan/math/fwd.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <sstream>
+
+namespace {
+template <typename T>
+T all_ops(const T& x, const T& y) {
+  T z = x * y - x / y + 2 * x - y / 3.0 + (1.5 - x) + (x + 0.5);
+  z += exp(x) + log(y) + sqrt(y) + square(x) + inv(y);
+  z -= sin(x) * cos(y) + log1p(y) + inv_logit(x);
+  z *= pow(y, x) + pow(y, 2.5) + pow(1.5, x);
+  z /= 3.0 / y + y;
+  return -z;
+}
+}  // namespace
+
+TEST(mathFwdCoreFvarMulti, ctor) {
+  using stan::math::fvar_multi;
+  fvar_multi<double, 3> a;
+  EXPECT_FLOAT_EQ(0.0, a.val_);
+  EXPECT_MATRIX_EQ(Eigen::Array3d::Zero(), a.d_);
+
+  fvar_multi<double, 3> b(1.9);
+  EXPECT_FLOAT_EQ(1.9, b.val());
+  EXPECT_MATRIX_EQ(Eigen::Array3d::Zero(), b.d());
+
+  fvar_multi<double, 3> c(1.93, Eigen::Array3d(1, 2, 3));
+  EXPECT_FLOAT_EQ(1.93, c.val_);
+  EXPECT_MATRIX_EQ(Eigen::Array3d(1, 2, 3), c.d_);
+
+  fvar_multi<double> d(2.5);
+  EXPECT_FLOAT_EQ(2.5, d.val_);
+  EXPECT_EQ(0, d.d_.size());
+}
+
+TEST(mathFwdCoreFvarMulti, matches_fvar) {
+  using stan::math::fvar;
+  using stan::math::fvar_multi;
+  const double x = 0.7;
+  const double y = 1.3;
+  fvar<double> dx = all_ops(fvar<double>(x, 1), fvar<double>(y, 0));
+  fvar<double> dy = all_ops(fvar<double>(x, 0), fvar<double>(y, 1));
+
+  fvar_multi<double, 2> f = all_ops(
+      fvar_multi<double, 2>(x, Eigen::Array2d(1, 0)),
+      fvar_multi<double, 2>(y, Eigen::Array2d(0, 1)));
+  EXPECT_FLOAT_EQ(dx.val_, f.val_);
+  EXPECT_FLOAT_EQ(dx.d_, f.d_(0));
+  EXPECT_FLOAT_EQ(dy.d_, f.d_(1));
+
+  fvar_multi<double> g
+      = all_ops(fvar_multi<double>(x, Eigen::Array3d(1, 0, 2)),
+                fvar_multi<double>(y, Eigen::Array3d(0, 1, 1)));
+  EXPECT_FLOAT_EQ(dx.val_, g.val_);
+  EXPECT_FLOAT_EQ(dx.d_, g.d_(0));
+  EXPECT_FLOAT_EQ(dy.d_, g.d_(1));
+  EXPECT_FLOAT_EQ(2 * dx.d_ + dy.d_, g.d_(2));
+}
+
+TEST(mathFwdCoreFvarMulti, vectorized) {
+  using stan::math::fvar_multi;
+  Eigen::Matrix<fvar_multi<double, 2>, Eigen::Dynamic, 1> v(2);
+  v << fvar_multi<double, 2>(0.5, Eigen::Array2d(1, 0)),
+      fvar_multi<double, 2>(-0.2, Eigen::Array2d(0, 1));
+  Eigen::Matrix<fvar_multi<double, 2>, Eigen::Dynamic, 1> e
+      = stan::math::exp(v);
+  EXPECT_FLOAT_EQ(std::exp(0.5), e(0).val_);
+  EXPECT_FLOAT_EQ(std::exp(0.5), e(0).d_(0));
+  EXPECT_FLOAT_EQ(0, e(0).d_(1));
+  EXPECT_FLOAT_EQ(std::exp(-0.2), e(1).d_(1));
+
+  fvar_multi<double, 2> s = v.sum() * 2.0;
+  EXPECT_FLOAT_EQ(0.6, s.val_);
+  EXPECT_MATRIX_EQ(Eigen::Array2d(2, 2), s.d_);
+}
+
+TEST(mathFwdCoreFvarMulti, comparisons) {
+  using stan::math::fvar_multi;
+  fvar_multi<double, 2> a(1.0, Eigen::Array2d(1, 0));
+  fvar_multi<double, 2> b(2.0, Eigen::Array2d(0, 1));
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(a <= 1.0);
+  EXPECT_TRUE(2 > a);
+  EXPECT_TRUE(b >= a);
+  EXPECT_TRUE(a == 1);
+  EXPECT_TRUE(a != b);
+  EXPECT_FALSE(a > b);
+}
+
+TEST(mathFwdCoreFvarMulti, print) {
+  std::stringstream ss;
+  ss << stan::math::fvar_multi<double, 2>(1.5);
+  EXPECT_EQ("1.5", ss.str());
+}
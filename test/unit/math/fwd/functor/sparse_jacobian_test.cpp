@@ -0,0 +1,80 @@
+#include <stan/math/fwd.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+// y_i = x_{i - 1} * x_i + exp(x_{i + 1}), with a tridiagonal Jacobian
+struct tridiagonal {
+  template <typename T>
+  Eigen::Matrix<T, Eigen::Dynamic, 1> operator()(
+      const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    const Eigen::Index N = x.size();
+    Eigen::Matrix<T, Eigen::Dynamic, 1> y(N);
+    for (Eigen::Index i = 0; i < N; ++i) {
+      y(i) = (i > 0 ? x(i - 1) * x(i) : x(i))
+             + (i + 1 < N ? stan::math::exp(x(i + 1)) : T(0));
+    }
+    return y;
+  }
+};
+
+// y_0 = sum(x), y_1 = x_0 * x_2
+struct wide {
+  template <typename T>
+  Eigen::Matrix<T, Eigen::Dynamic, 1> operator()(
+      const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    Eigen::Matrix<T, Eigen::Dynamic, 1> y(2);
+    y << x.sum(), x(0) * x(2);
+    return y;
+  }
+};
+}  // namespace
+
+TEST(FwdFunctor, sparse_jacobian_tridiagonal) {
+  const int N = 10;
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(N, -0.5, 0.8);
+  Eigen::VectorXd fx;
+  Eigen::MatrixXd J;
+  stan::math::jacobian<double>(tridiagonal(), x, fx, J);
+
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < N; ++i) {
+    for (int j = std::max(0, i - 1); j <= std::min(N - 1, i + 1); ++j) {
+      triplets.emplace_back(i, j, 1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> pattern(N, N);
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+
+  Eigen::VectorXd fx_sparse;
+  Eigen::SparseMatrix<double> J_sparse;
+  stan::math::sparse_jacobian(tridiagonal(), x, pattern, fx_sparse, J_sparse);
+  EXPECT_MATRIX_EQ(fx, fx_sparse);
+  EXPECT_EQ(3 * N - 2, J_sparse.nonZeros());
+  EXPECT_MATRIX_NEAR(J, Eigen::MatrixXd(J_sparse), 1e-12);
+}
+
+TEST(FwdFunctor, sparse_jacobian_rectangular) {
+  Eigen::VectorXd x(4);
+  x << 0.5, -1.0, 2.0, 3.0;
+  Eigen::SparseMatrix<double> pattern(2, 4);
+  for (int j = 0; j < 4; ++j) {
+    pattern.insert(0, j) = 1;
+  }
+  pattern.insert(1, 0) = 1;
+  pattern.insert(1, 2) = 1;
+
+  Eigen::VectorXd fx;
+  Eigen::SparseMatrix<double> J;
+  stan::math::sparse_jacobian(wide(), x, pattern, fx, J);
+  Eigen::MatrixXd J_expected(2, 4);
+  J_expected << 1, 1, 1, 1, 2.0, 0, 0.5, 0;
+  EXPECT_MATRIX_EQ(J_expected, Eigen::MatrixXd(J));
+  EXPECT_FLOAT_EQ(4.5, fx(0));
+  EXPECT_FLOAT_EQ(1.0, fx(1));
+
+  EXPECT_THROW(stan::math::sparse_jacobian(wide(), x, pattern.leftCols(3), fx,
+                                           J),
+               std::invalid_argument);
+}
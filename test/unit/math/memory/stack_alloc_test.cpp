@@ -119,3 +119,121 @@ TEST(stack_alloc, in_stack_second_block) {
   EXPECT_FALSE(allocator.in_stack(x));
   EXPECT_FALSE(allocator.in_stack(y));
 }
+
+TEST(stack_alloc, block_size_policy) {
+  stan::math::block_size_policy doubling;
+  EXPECT_EQ(16, doubling.block_size(9));
+  EXPECT_EQ(200, doubling.next_block_size(100, 10));
+  EXPECT_EQ(304, doubling.next_block_size(100, 300));
+
+  stan::math::block_size_policy quadrupling(4, 1024);
+  EXPECT_EQ(1024, quadrupling.block_size(1));
+  EXPECT_EQ(4096, quadrupling.next_block_size(1024, 10));
+  EXPECT_EQ(9216, quadrupling.next_block_size(1024, 8193));
+}
+
+TEST(stack_alloc, malloc_block_provider_alignment) {
+  stan::math::malloc_block_provider provider;
+  for (size_t nbytes : {1, 8, 24, 1000, 1 << 16}) {
+    char* block = provider.allocate(nbytes);
+    ASSERT_NE(nullptr, block);
+    EXPECT_TRUE(stan::math::is_aligned(
+        block, stan::math::internal::BLOCK_ALIGNMENT));
+    provider.deallocate(block, nbytes);
+  }
+}
+
+TEST(stack_alloc, mmap_block_provider_alloc) {
+  using stan::math::basic_stack_alloc;
+  using stan::math::mmap_block_provider;
+  for (bool huge_pages : {false, true}) {
+    for (bool prefault : {false, true}) {
+      basic_stack_alloc<mmap_block_provider> allocator(
+          stan::math::internal::DEFAULT_INITIAL_NBYTES,
+          mmap_block_provider(huge_pages, prefault));
+      EXPECT_EQ(huge_pages, allocator.provider().huge_pages());
+      EXPECT_EQ(prefault, allocator.provider().prefaults());
+      if (huge_pages) {
+        EXPECT_EQ(stan::math::internal::HUGE_PAGE_NBYTES,
+                  allocator.bytes_allocated());
+      } else {
+        EXPECT_EQ(stan::math::internal::DEFAULT_INITIAL_NBYTES,
+                  allocator.bytes_allocated());
+      }
+
+      std::vector<double*> ds;
+      for (int i = 0; i < 100000; ++i) {
+        allocator.alloc(1320);
+        double* foo = allocator.alloc_array<double>(1);
+        *foo = i;
+        ds.push_back(foo);
+      }
+      for (int i = 0; i < 100000; ++i) {
+        EXPECT_FLOAT_EQ(i, *ds[i]);
+        EXPECT_TRUE(stan::math::is_aligned(ds[i], 8U));
+        EXPECT_TRUE(allocator.in_stack(ds[i]));
+      }
+      allocator.free_all();
+      EXPECT_FALSE(allocator.in_stack(ds.back()));
+    }
+  }
+}
+
+TEST(stack_alloc, peak_bytes_used) {
+  stan::math::stack_alloc allocator;
+  EXPECT_EQ(0, allocator.bytes_used());
+  allocator.alloc(64);
+  allocator.start_nested();
+  allocator.alloc(2 * stan::math::internal::DEFAULT_INITIAL_NBYTES);
+  size_t peak = allocator.bytes_used();
+  EXPECT_GE(peak, 64 + 2 * stan::math::internal::DEFAULT_INITIAL_NBYTES);
+  allocator.recover_nested();
+  EXPECT_EQ(64, allocator.bytes_used());
+  EXPECT_EQ(peak, allocator.peak_bytes_used());
+  allocator.reset_peak_bytes_used();
+  EXPECT_EQ(64, allocator.peak_bytes_used());
+}
+
+TEST(stack_alloc, coalesce) {
+  stan::math::stack_alloc allocator;
+  for (int i = 0; i < 4; ++i) {
+    allocator.alloc(stan::math::internal::DEFAULT_INITIAL_NBYTES);
+  }
+  EXPECT_GT(allocator.num_blocks(), 1);
+  size_t peak = allocator.peak_bytes_used();
+  allocator.recover_all();
+  allocator.coalesce(peak + 8);
+  EXPECT_EQ(1, allocator.num_blocks());
+  EXPECT_EQ(peak + 8, allocator.bytes_allocated());
+
+  for (int i = 0; i < 4; ++i) {
+    char* x = static_cast<char*>(
+        allocator.alloc(stan::math::internal::DEFAULT_INITIAL_NBYTES));
+    x[0] = 'a';
+    EXPECT_TRUE(allocator.in_stack(x));
+  }
+  EXPECT_EQ(1, allocator.num_blocks());
+
+  allocator.free_all();
+  EXPECT_EQ(1, allocator.num_blocks());
+  EXPECT_EQ(stan::math::internal::DEFAULT_INITIAL_NBYTES,
+            allocator.bytes_allocated());
+}
+
+TEST(stack_alloc, num_block_allocations) {
+  stan::math::stack_alloc allocator;
+  EXPECT_EQ(1, allocator.num_block_allocations());
+  allocator.alloc(stan::math::internal::DEFAULT_INITIAL_NBYTES);
+  allocator.alloc(stan::math::internal::DEFAULT_INITIAL_NBYTES);
+  size_t num_blocks = allocator.num_blocks();
+  EXPECT_EQ(num_blocks, allocator.num_block_allocations());
+
+  // reusing the blocks does not allocate
+  allocator.recover_all();
+  allocator.alloc(stan::math::internal::DEFAULT_INITIAL_NBYTES);
+  EXPECT_EQ(num_blocks, allocator.num_block_allocations());
+
+  allocator.recover_all();
+  allocator.coalesce(allocator.bytes_allocated() * 2);
+  EXPECT_EQ(num_blocks + 1, allocator.num_block_allocations());
+}
@@ -1,5 +1,6 @@
 #include <stan/math/mix.hpp>
 #include <gtest/gtest.h>
+#include <test/unit/util.hpp>
 #include <test/unit/math/rev/fun/util.hpp>
 #include <iostream>
 #include <stdexcept>
@@ -42,6 +43,40 @@ struct norm_functor {
   }
 };
 
+// fun3: R^5 --> R, a smooth function coupling all inputs
+struct fun3 {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::pow;
+    using stan::math::sin;
+    using stan::math::square;
+    T lp = 0;
+    for (int i = 0; i < x.size(); ++i) {
+      lp += exp(0.3 * x(i)) * x((i + 1) % x.size()) + square(x(i)) / (i + 1);
+    }
+    return lp + log(1.0 + square(x(0))) * sin(x(1)) + pow(x(2), 2.0) * x(4);
+  }
+};
+
+// fun4: R^5 --> R^3
+struct fun4 {
+  template <typename T>
+  inline Matrix<T, Dynamic, 1> operator()(
+      const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::cos;
+    using stan::math::exp;
+    using stan::math::inv_logit;
+    using stan::math::sqrt;
+    using stan::math::square;
+    Matrix<T, Dynamic, 1> z(3);
+    z << x(0) * x(1) + exp(x(2)), sqrt(square(x(3)) + 1.0) / x(4),
+        inv_logit(x(0) - x(4)) + cos(x(2)) * x(1);
+    return z;
+  }
+};
+
 TEST(MixFunctor, derivative) {
   fun0 f;
   double x = 7;
@@ -186,6 +221,115 @@ TEST(MixFunctor, hessian) {
   EXPECT_FLOAT_EQ(2 * 3, H2(1, 1));
 }
 
+TEST(MixFunctor, jacobianMultiTangent) {
+  fun4 f;
+  Matrix<double, Dynamic, 1> x(5);
+  x << 0.3, -1.2, 0.8, 2.1, 1.7;
+  Matrix<double, Dynamic, 1> fx;
+  Matrix<double, Dynamic, Dynamic> J;
+  stan::math::jacobian(f, x, fx, J);
+
+  Matrix<double, Dynamic, 1> fx1;
+  Matrix<double, Dynamic, Dynamic> J1;
+  stan::math::jacobian<1>(f, x, fx1, J1);
+  EXPECT_MATRIX_NEAR(fx, fx1, 1e-12);
+  EXPECT_MATRIX_NEAR(J, J1, 1e-12);
+
+  Matrix<double, Dynamic, 1> fx2;
+  Matrix<double, Dynamic, Dynamic> J2;
+  stan::math::jacobian<2>(f, x, fx2, J2);
+  EXPECT_MATRIX_NEAR(fx, fx2, 1e-12);
+  EXPECT_MATRIX_NEAR(J, J2, 1e-12);
+
+  Matrix<double, Dynamic, 1> fx8;
+  Matrix<double, Dynamic, Dynamic> J8;
+  stan::math::jacobian<8>(f, x, fx8, J8);
+  EXPECT_MATRIX_NEAR(fx, fx8, 1e-12);
+  EXPECT_MATRIX_NEAR(J, J8, 1e-12);
+}
+
+TEST(MixFunctor, hessianMultiTangent) {
+  fun3 f;
+  Matrix<double, Dynamic, 1> x(5);
+  x << 0.3, -1.2, 0.8, 2.1, 1.7;
+  double fx;
+  Matrix<double, Dynamic, 1> grad;
+  Matrix<double, Dynamic, Dynamic> H;
+  stan::math::hessian(f, x, fx, grad, H);
+
+  double fx1;
+  Matrix<double, Dynamic, 1> grad1;
+  Matrix<double, Dynamic, Dynamic> H1;
+  stan::math::hessian<1>(f, x, fx1, grad1, H1);
+  EXPECT_FLOAT_EQ(fx, fx1);
+  EXPECT_MATRIX_NEAR(grad, grad1, 1e-12);
+  EXPECT_MATRIX_NEAR(H, H1, 1e-12);
+
+  double fx3;
+  Matrix<double, Dynamic, 1> grad3;
+  Matrix<double, Dynamic, Dynamic> H3;
+  stan::math::hessian<3>(f, x, fx3, grad3, H3);
+  EXPECT_FLOAT_EQ(fx, fx3);
+  EXPECT_MATRIX_NEAR(grad, grad3, 1e-12);
+  EXPECT_MATRIX_NEAR(H, H3, 1e-12);
+
+  double fx8;
+  Matrix<double, Dynamic, 1> grad8;
+  Matrix<double, Dynamic, Dynamic> H8;
+  stan::math::hessian<8>(f, x, fx8, grad8, H8);
+  EXPECT_FLOAT_EQ(fx, fx8);
+  EXPECT_MATRIX_NEAR(grad, grad8, 1e-12);
+  EXPECT_MATRIX_NEAR(H, H8, 1e-12);
+}
+
+TEST(MixFunctor, jacobianGrainsize) {
+  fun4 f;
+  Matrix<double, Dynamic, 1> x(5);
+  x << 0.3, -1.2, 0.8, 2.1, 1.7;
+  Matrix<double, Dynamic, 1> fx;
+  Matrix<double, Dynamic, Dynamic> J;
+  stan::math::jacobian<double>(f, x, fx, J);
+
+  for (int grainsize : {1, 2, 10}) {
+    Matrix<double, Dynamic, 1> fx_par;
+    Matrix<double, Dynamic, Dynamic> J_par;
+    stan::math::jacobian(f, x, fx_par, J_par, grainsize);
+    EXPECT_MATRIX_EQ(fx, fx_par);
+    EXPECT_MATRIX_EQ(J, J_par);
+  }
+
+  Matrix<double, Dynamic, 1> fx_par;
+  Matrix<double, Dynamic, Dynamic> J_par;
+  EXPECT_THROW(stan::math::jacobian(f, x, fx_par, J_par, 0),
+               std::domain_error);
+}
+
+TEST(MixFunctor, hessianGrainsize) {
+  fun3 f;
+  Matrix<double, Dynamic, 1> x(5);
+  x << 0.3, -1.2, 0.8, 2.1, 1.7;
+  double fx;
+  Matrix<double, Dynamic, 1> grad;
+  Matrix<double, Dynamic, Dynamic> H;
+  stan::math::hessian(f, x, fx, grad, H);
+
+  for (int grainsize : {1, 2, 10}) {
+    double fx_par;
+    Matrix<double, Dynamic, 1> grad_par;
+    Matrix<double, Dynamic, Dynamic> H_par;
+    stan::math::hessian(f, x, fx_par, grad_par, H_par, grainsize);
+    EXPECT_EQ(fx, fx_par);
+    EXPECT_MATRIX_EQ(grad, grad_par);
+    EXPECT_MATRIX_EQ(H, H_par);
+  }
+
+  double fx_par;
+  Matrix<double, Dynamic, 1> grad_par;
+  Matrix<double, Dynamic, Dynamic> H_par;
+  EXPECT_THROW(stan::math::hessian(f, x, fx_par, grad_par, H_par, -1),
+               std::domain_error);
+}
+
 TEST(MixFunctor, GradientTraceMatrixTimesHessian) {
   Matrix<double, Dynamic, Dynamic> M(2, 2);
   M << 11, 13, 17, 23;
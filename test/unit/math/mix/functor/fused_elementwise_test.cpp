@@ -0,0 +1,72 @@
+#include <stan/math/mix.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/test_ad.hpp>
+#include <stdexcept>
+
+namespace fused_elementwise_test {
+struct exp_fma {
+  template <typename T1, typename T2, typename T3>
+  auto operator()(const T1& x, const T2& y, const T3& z) const {
+    using stan::math::exp;
+    return exp(x * y + z);
+  }
+};
+
+struct log_ratio {
+  template <typename T1, typename T2>
+  auto operator()(const T1& x, const T2& y) const {
+    using stan::math::log1p;
+    using stan::math::square;
+    return log1p(square(x)) / y - 2.5 * x;
+  }
+};
+}  // namespace fused_elementwise_test
+
+TEST(MixFunctor, fusedElementwise) {
+  auto f = [](const auto& a, const auto& b, const auto& c) {
+    return stan::math::fused_elementwise(fused_elementwise_test::exp_fma{}, a,
+                                         b, c);
+  };
+  Eigen::MatrixXd a(2, 3);
+  a << 0.5, -1.2, 0.3, 2.0, 0.1, -0.4;
+  Eigen::MatrixXd b(2, 3);
+  b << 1.1, 0.7, -0.2, 0.3, -1.5, 0.9;
+  Eigen::MatrixXd c(2, 3);
+  c << -0.3, 0.2, 0.6, -1.0, 0.4, 0.0;
+  stan::test::expect_ad(f, a, b, c);
+  stan::test::expect_ad_matvar(f, a, b, c);
+
+  Eigen::VectorXd u(3);
+  u << 0.5, -1.2, 0.3;
+  Eigen::VectorXd v(3);
+  v << 1.1, 0.7, -0.2;
+  double s = 0.4;
+  stan::test::expect_ad(f, u, v, s);
+  stan::test::expect_ad(f, u, s, v);
+  stan::test::expect_ad_matvar(f, u, v, s);
+
+  Eigen::RowVectorXd r(2);
+  r << 0.1, -0.7;
+  stan::test::expect_ad(f, r, r, r);
+  stan::test::expect_ad_matvar(f, r, r, r);
+
+  Eigen::MatrixXd m00(0, 0);
+  stan::test::expect_ad(f, m00, m00, m00);
+  stan::test::expect_ad_matvar(f, m00, m00, m00);
+}
+
+TEST(MixFunctor, fusedElementwiseTwoArgs) {
+  auto f = [](const auto& a, const auto& b) {
+    return stan::math::fused_elementwise(fused_elementwise_test::log_ratio{},
+                                         a, b);
+  };
+  Eigen::VectorXd u(4);
+  u << 0.5, -1.2, 0.3, 2.0;
+  Eigen::VectorXd v(4);
+  v << 1.1, 0.7, 2.2, 0.3;
+  stan::test::expect_ad(f, u, v);
+  stan::test::expect_ad(f, u, 1.3);
+  stan::test::expect_ad(f, 0.8, v);
+  stan::test::expect_ad_matvar(f, u, v);
+  stan::test::expect_ad_matvar(f, u, 1.3);
+}
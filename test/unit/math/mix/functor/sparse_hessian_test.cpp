@@ -0,0 +1,111 @@
+#include <stan/math/mix.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+// Rosenbrock function, which has a tridiagonal Hessian
+struct rosenbrock {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    T lp = 0;
+    for (Eigen::Index i = 0; i + 1 < x.size(); ++i) {
+      lp += 100 * stan::math::square(x(i + 1) - stan::math::square(x(i)))
+            + stan::math::square(1 - x(i));
+    }
+    return lp;
+  }
+};
+
+// x_0 couples to every other argument
+struct arrowhead {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    T lp = 0;
+    for (Eigen::Index i = 1; i < x.size(); ++i) {
+      lp += stan::math::exp(0.1 * x(0) * x(i)) + stan::math::square(x(i));
+    }
+    return lp;
+  }
+};
+
+Eigen::SparseMatrix<double> banded_pattern(int N, int bandwidth) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < N; ++i) {
+    for (int j = std::max(0, i - bandwidth);
+         j <= std::min(N - 1, i + bandwidth); ++j) {
+      triplets.emplace_back(i, j, 1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> pattern(N, N);
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+  return pattern;
+}
+}  // namespace
+
+TEST(MixFunctor, column_coloring_banded) {
+  for (int bandwidth : {0, 1, 2}) {
+    int num_colors = 0;
+    std::vector<int> colors = stan::math::internal::column_coloring(
+        banded_pattern(20, bandwidth), num_colors);
+    EXPECT_EQ(2 * bandwidth + 1, num_colors);
+    for (int j = 0; j < 20; ++j) {
+      EXPECT_EQ(j % num_colors, colors[j]);
+    }
+  }
+}
+
+TEST(MixFunctor, sparse_hessian_tridiagonal) {
+  const int N = 12;
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(N, -1.2, 1.5);
+  double fx;
+  Eigen::VectorXd grad;
+  Eigen::MatrixXd H;
+  stan::math::hessian(rosenbrock(), x, fx, grad, H);
+
+  // the lower band is enough, the pattern is symmetrized
+  Eigen::SparseMatrix<double> lower = banded_pattern(N, 1);
+  lower = lower.triangularView<Eigen::Lower>();
+  double fx_sparse;
+  Eigen::VectorXd grad_sparse;
+  Eigen::SparseMatrix<double> H_sparse;
+  stan::math::sparse_hessian(rosenbrock(), x, lower, fx_sparse, grad_sparse,
+                             H_sparse);
+  EXPECT_FLOAT_EQ(fx, fx_sparse);
+  EXPECT_MATRIX_NEAR(grad, grad_sparse, 1e-10);
+  EXPECT_EQ(3 * N - 2, H_sparse.nonZeros());
+  EXPECT_MATRIX_NEAR(H, Eigen::MatrixXd(H_sparse), 1e-10);
+}
+
+TEST(MixFunctor, sparse_hessian_arrowhead) {
+  const int N = 6;
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(N, 0.3, 1.1);
+  double fx;
+  Eigen::VectorXd grad;
+  Eigen::MatrixXd H;
+  stan::math::hessian(arrowhead(), x, fx, grad, H);
+
+  Eigen::SparseMatrix<double> pattern(N, N);
+  for (int i = 1; i < N; ++i) {
+    pattern.insert(i, 0) = 1;
+  }
+  double fx_sparse;
+  Eigen::VectorXd grad_sparse;
+  Eigen::SparseMatrix<double> H_sparse;
+  stan::math::sparse_hessian(arrowhead(), x, pattern, fx_sparse, grad_sparse,
+                             H_sparse);
+  EXPECT_FLOAT_EQ(fx, fx_sparse);
+  EXPECT_MATRIX_NEAR(grad, grad_sparse, 1e-10);
+  EXPECT_MATRIX_NEAR(H, Eigen::MatrixXd(H_sparse), 1e-10);
+}
+
+TEST(MixFunctor, sparse_hessian_errors) {
+  Eigen::VectorXd x(3);
+  x << 1, 2, 3;
+  double fx;
+  Eigen::VectorXd grad;
+  Eigen::SparseMatrix<double> H;
+  EXPECT_THROW(stan::math::sparse_hessian(rosenbrock(), x, banded_pattern(2, 1),
+                                          fx, grad, H),
+               std::invalid_argument);
+}
@@ -0,0 +1,105 @@
+#define STAN_SCALAR_OP_TAPE
+#include <stan/math/mix.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::VectorXd;
+
+namespace {
+// sum_i (x_i - mu)^2 / sigma + log(sigma), with mu = x_0, sigma = exp(x_1)
+struct normal_like {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::sqrt;
+    using stan::math::square;
+    T mu = x(0);
+    T sigma = exp(x(1));
+    T lp = 0;
+    for (int i = 2; i < x.size(); ++i) {
+      lp += square(x(i) - mu) / sigma + log(sigma);
+    }
+    return lp - 0.5 * sqrt(sigma);
+  }
+};
+
+struct not_taped {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return stan::math::sin(x(0)) * x(1);
+  }
+};
+
+// x_0^2 * x_1 + 3 * x_1^2 / x_2
+struct polynomial {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return x(0) * x(0) * x(1) + 3 * stan::math::square(x(1)) / x(2);
+  }
+};
+}  // namespace
+
+TEST(MixFunctor, tapedHessianTimesVector) {
+  auto hessian = [](const VectorXd& x) {
+    const double x2_sq = x(2) * x(2);
+    Eigen::MatrixXd H(3, 3);
+    H << 2 * x(1), 2 * x(0), 0, 2 * x(0), 6 / x(2), -6 * x(1) / x2_sq, 0,
+        -6 * x(1) / x2_sq, 6 * x(1) * x(1) / (x2_sq * x(2));
+    return H;
+  };
+  stan::math::taped_hessian<polynomial> taped{polynomial()};
+  VectorXd x(3);
+  x << 1.5, -2.0, 0.5;
+  VectorXd v(3);
+  v << 0.3, 1.1, -0.7;
+  double fx;
+  VectorXd Hv;
+  taped.hessian_times_vector(x, v, fx, Hv);
+  EXPECT_TRUE(taped.recorded());
+  EXPECT_FLOAT_EQ(1.5 * 1.5 * -2.0 + 3 * 4.0 / 0.5, fx);
+  EXPECT_MATRIX_NEAR(hessian(x) * v, Hv, 1e-10);
+
+  // replays the recording at a new argument
+  x << -0.5, 1.0, 2.0;
+  taped.hessian_times_vector(x, v, fx, Hv);
+  EXPECT_MATRIX_NEAR(hessian(x) * v, Hv, 1e-10);
+  EXPECT_EQ(1, taped.num_recordings());
+  EXPECT_EQ(0, stan::math::ChainableStack::instance_->var_stack_.size());
+}
+
+TEST(MixFunctor, tapedHessianTimesVectorNormal) {
+  stan::math::taped_hessian<normal_like> taped{normal_like()};
+  VectorXd x = VectorXd::Random(6);
+  VectorXd v = VectorXd::Random(6);
+  double fx;
+  VectorXd Hv;
+  taped.hessian_times_vector(x, v, fx, Hv);
+  double fx_expected;
+  VectorXd Hv_expected;
+  stan::math::hessian_times_vector(normal_like(), x, v, fx_expected,
+                                   Hv_expected);
+  EXPECT_FLOAT_EQ(fx_expected, fx);
+  EXPECT_MATRIX_NEAR(Hv_expected, Hv, 1e-10);
+}
+
+TEST(MixFunctor, tapedHessianTimesVectorFallsBack) {
+  stan::math::taped_hessian<not_taped> taped{not_taped()};
+  VectorXd x(2);
+  x << 0.4, 1.3;
+  VectorXd v(2);
+  v << 2.0, -1.0;
+  double fx;
+  VectorXd Hv;
+  taped.hessian_times_vector(x, v, fx, Hv);
+  EXPECT_FALSE(taped.recorded());
+  EXPECT_FLOAT_EQ(std::sin(0.4) * 1.3, fx);
+  // exact, not approximated with finite differences
+  EXPECT_FLOAT_EQ(-std::sin(0.4) * 1.3 * 2.0 - std::cos(0.4), Hv(0));
+  EXPECT_FLOAT_EQ(std::cos(0.4) * 2.0, Hv(1));
+  EXPECT_THROW(taped.hessian_times_vector(x, VectorXd(3), fx, Hv),
+               std::invalid_argument);
+}
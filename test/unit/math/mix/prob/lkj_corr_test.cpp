@@ -4,8 +4,55 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/math/distributions.hpp>
 #include <test/unit/math/mix/prob/higher_order_utils.hpp>
+#include <test/unit/math/test_ad.hpp>
 #include <vector>
 
+TEST(ProbDistributionsLkjCorr, matvar) {
+  auto f = [](int K) {
+    return [K](const auto& x, const auto& eta) {
+      auto y = stan::math::corr_matrix_constrain(x, K);
+      return stan::math::lkj_corr_lpdf(y, eta);
+    };
+  };
+
+  Eigen::VectorXd x0(0);
+  Eigen::VectorXd x1(1);
+  x1 << 0.3;
+  Eigen::VectorXd x3(3);
+  x3 << -0.2, 0.4, 0.7;
+  for (double eta : {0.5, 2.5}) {
+    stan::test::expect_ad(f(1), x0, eta);
+    stan::test::expect_ad_matvar(f(1), x0, eta);
+    stan::test::expect_ad(f(2), x1, eta);
+    stan::test::expect_ad_matvar(f(2), x1, eta);
+    stan::test::expect_ad(f(3), x3, eta);
+    stan::test::expect_ad_matvar(f(3), x3, eta);
+  }
+}
+
+TEST(ProbDistributionsLkjCorrCholesky, matvar) {
+  auto f = [](int K) {
+    return [K](const auto& x, const auto& eta) {
+      auto L = stan::math::cholesky_corr_constrain(x, K);
+      return stan::math::lkj_corr_cholesky_lpdf(L, eta);
+    };
+  };
+
+  Eigen::VectorXd x0(0);
+  Eigen::VectorXd x1(1);
+  x1 << 0.3;
+  Eigen::VectorXd x3(3);
+  x3 << -0.2, 0.4, 0.7;
+  for (double eta : {0.5, 2.5}) {
+    stan::test::expect_ad(f(1), x0, eta);
+    stan::test::expect_ad_matvar(f(1), x0, eta);
+    stan::test::expect_ad(f(2), x1, eta);
+    stan::test::expect_ad_matvar(f(2), x1, eta);
+    stan::test::expect_ad(f(3), x3, eta);
+    stan::test::expect_ad_matvar(f(3), x3, eta);
+  }
+}
+
 TEST(ProbDistributionsLkjCorr, fvar_var) {
   using stan::math::fvar;
   using stan::math::var;
@@ -0,0 +1,37 @@
+#include <test/unit/math/test_ad.hpp>
+#include <vector>
+
+TEST(ProbDistributionsLkjCov, matvar) {
+  auto f = [](int K) {
+    return [K](const auto& x, const auto& mu, const auto& sigma) {
+      auto y = stan::math::cov_matrix_constrain(x, K);
+      return stan::math::lkj_cov_lpdf(y, mu, sigma, 2.5);
+    };
+  };
+  auto f_scalar = [](int K) {
+    return [K](const auto& x, const auto& mu, const auto& sigma) {
+      auto y = stan::math::cov_matrix_constrain(x, K);
+      return stan::math::lkj_cov_lpdf(y, mu, sigma, 0.5);
+    };
+  };
+
+  Eigen::VectorXd x1(1);
+  x1 << 0.3;
+  Eigen::VectorXd x3(3);
+  x3 << 0.3, -0.2, 0.1;
+  Eigen::VectorXd mu1(1);
+  mu1 << 0.1;
+  Eigen::VectorXd sigma1(1);
+  sigma1 << 1.2;
+  Eigen::VectorXd mu2(2);
+  mu2 << 0.1, -0.4;
+  Eigen::VectorXd sigma2(2);
+  sigma2 << 1.2, 0.8;
+
+  stan::test::expect_ad(f(1), x1, mu1, sigma1);
+  stan::test::expect_ad_matvar(f(1), x1, mu1, sigma1);
+  stan::test::expect_ad(f(2), x3, mu2, sigma2);
+  stan::test::expect_ad_matvar(f(2), x3, mu2, sigma2);
+  stan::test::expect_ad(f_scalar(2), x3, 0.1, 1.2);
+  stan::test::expect_ad_matvar(f_scalar(2), x3, 0.1, 1.2);
+}
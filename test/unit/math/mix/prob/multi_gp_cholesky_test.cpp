@@ -1,5 +1,43 @@
 #include <stan/math/mix.hpp>
 #include <gtest/gtest.h>
+#include <test/unit/math/test_ad.hpp>
+
+TEST(ProbDistributionsMultiGPCholesky, matvar) {
+  auto f = [](const auto& y, const auto& L, const auto& w) {
+    return stan::math::multi_gp_cholesky_lpdf(y, L, w);
+  };
+
+  Eigen::MatrixXd y11(1, 1);
+  y11 << 1;
+  Eigen::VectorXd w1(1);
+  w1 << 3.4;
+  Eigen::MatrixXd L11(1, 1);
+  L11 << 1.2;
+  stan::test::expect_ad(f, y11, L11, w1);
+  stan::test::expect_ad_matvar(f, y11, L11, w1);
+
+  Eigen::MatrixXd y00(0, 0);
+  Eigen::VectorXd w0(0);
+  Eigen::MatrixXd L00(0, 0);
+  stan::test::expect_ad(f, y00, L00, w0);
+  stan::test::expect_ad_matvar(f, y00, L00, w0);
+
+  Eigen::MatrixXd y23(2, 3);
+  y23 << 1.0, 0.1, -0.4, 0.3, 0.5, 2.0;
+  Eigen::VectorXd w2(2);
+  w2 << 0.1, 2.0;
+  Eigen::MatrixXd Sigma33(3, 3);
+  Sigma33 << 3.0, 0.5, 0.2, 0.5, 2.0, -0.3, 0.2, -0.3, 1.5;
+  Eigen::MatrixXd L33 = Sigma33.llt().matrixL();
+  stan::test::expect_ad(f, y23, L33, w2);
+  stan::test::expect_ad_matvar(f, y23, L33, w2);
+
+  // Error sizes
+  stan::test::expect_ad(f, y23, L33, w1);
+  stan::test::expect_ad(f, y23, L11, w2);
+  stan::test::expect_ad_matvar(f, y23, L33, w1);
+  stan::test::expect_ad_matvar(f, y23, L11, w2);
+}
 
 TEST(ProbDistributionsMultiGPCholesky, fvar_var) {
   using Eigen::Dynamic;
@@ -14,3 +14,19 @@ TEST(MathFunctions, inv_logit_nan) {
 
   EXPECT_TRUE(std::isnan(stan::math::inv_logit(nan)));
 }
+
+TEST(MathFunctions, inv_logit_vectorized) {
+  using stan::math::inv_logit;
+  double inf = std::numeric_limits<double>::infinity();
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  Eigen::VectorXd x(13);
+  x << -inf, -800, -40, -20, -1.5, -1e-20, 0, 1e-20, 0.3, 20, 40, 800, inf;
+  Eigen::VectorXd y = inv_logit(x);
+  for (int i = 0; i < x.size(); ++i) {
+    EXPECT_NEAR(inv_logit(x(i)), y(i), 1e-15 * inv_logit(x(i)))
+        << "x = " << x(i);
+  }
+  Eigen::VectorXd x_nan(5);
+  x_nan << 1, 2, nan, 3, 4;
+  EXPECT_TRUE(std::isnan(inv_logit(x_nan)(2)));
+}
@@ -16,3 +16,23 @@ TEST(MathFunctions, log1p_exp_nan) {
 
   EXPECT_TRUE(std::isnan(stan::math::log1p_exp(nan)));
 }
+
+TEST(MathFunctions, log1p_exp_vectorized) {
+  using stan::math::log1p_exp;
+  double inf = std::numeric_limits<double>::infinity();
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  Eigen::VectorXd x(13);
+  x << -inf, -800, -40, -20, -1.5, -1e-20, 0, 1e-20, 0.3, 20, 40, 800, inf;
+  Eigen::VectorXd y = log1p_exp(x);
+  for (int i = 0; i < x.size(); ++i) {
+    if (std::isinf(y(i))) {
+      EXPECT_EQ(log1p_exp(x(i)), y(i));
+    } else {
+      EXPECT_NEAR(log1p_exp(x(i)), y(i), 1e-15 * std::fabs(log1p_exp(x(i))))
+          << "x = " << x(i);
+    }
+  }
+  Eigen::VectorXd x_nan(5);
+  x_nan << 1, 2, nan, 3, 4;
+  EXPECT_TRUE(std::isnan(log1p_exp(x_nan)(2)));
+}
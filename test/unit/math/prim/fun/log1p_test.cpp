@@ -40,3 +40,26 @@ TEST(MathFunctions, log1p_nan) {
   double nan = std::numeric_limits<double>::quiet_NaN();
   EXPECT_TRUE(std::isnan(stan::math::log1p(nan)));
 }
+
+TEST(MathFunctions, log1p_vectorized) {
+  using stan::math::log1p;
+  double inf = std::numeric_limits<double>::infinity();
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  Eigen::VectorXd x(11);
+  x << -1, -0.999, -0.5, -1e-10, -1e-300, 0, 1e-300, 1e-10, 0.5, 1e300, inf;
+  Eigen::VectorXd y = log1p(x);
+  for (int i = 0; i < x.size(); ++i) {
+    if (std::isinf(y(i))) {
+      EXPECT_EQ(log1p(x(i)), y(i));
+    } else {
+      EXPECT_NEAR(log1p(x(i)), y(i), 1e-15 * std::fabs(log1p(x(i))))
+          << "x = " << x(i);
+    }
+  }
+  Eigen::VectorXd x_nan(5);
+  x_nan << 1, 2, nan, 3, 4;
+  EXPECT_TRUE(std::isnan(log1p(x_nan)(2)));
+  Eigen::VectorXd x_bad(5);
+  x_bad << 1, 2, -3, 3, 4;
+  EXPECT_THROW(log1p(x_bad), std::domain_error);
+}
@@ -156,3 +156,26 @@ TEST(MathMatrixPrim, multiply_vector_int) {
   EXPECT_EQ(4.0, prod_vec[1]);
   EXPECT_EQ(6.0, prod_vec[2]);
 }
+
+TEST(MathMatrixPrim, multiply_float_matrix_double_vector) {
+  using stan::math::multiply;
+  // more rows than one block of the result
+  Eigen::MatrixXf m = Eigen::MatrixXf::Random(1000, 7);
+  Eigen::VectorXd v = Eigen::VectorXd::Random(7);
+  Eigen::VectorXd expected = m.cast<double>() * v;
+  Eigen::VectorXd prod = multiply(m, v);
+  ASSERT_EQ(1000, prod.size());
+  for (int i = 0; i < prod.size(); ++i) {
+    EXPECT_NEAR(expected(i), prod(i), 1e-14);
+  }
+
+  Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> m_rm
+      = m;
+  Eigen::VectorXd prod_rm = multiply(m_rm, v);
+  for (int i = 0; i < prod.size(); ++i) {
+    EXPECT_NEAR(expected(i), prod_rm(i), 1e-14);
+  }
+
+  EXPECT_EQ(0, multiply(Eigen::MatrixXf(0, 7), v).size());
+  EXPECT_THROW(multiply(m, Eigen::VectorXd(3)), std::invalid_argument);
+}
@@ -0,0 +1,99 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+stan::math::var big_tape(int n) {
+  stan::math::var x = 1.5;
+  stan::math::var lp = 0;
+  for (int i = 0; i < n; ++i) {
+    lp += x * i;
+  }
+  return lp;
+}
+}  // namespace
+
+TEST(AgradRevStack, adaptiveArenaCoalescesAfterRecover) {
+  auto* stack = stan::math::ChainableStack::instance_;
+  stan::math::recover_memory();
+
+  stan::math::grad(big_tape(100000).vi_);
+  EXPECT_GT(stack->memalloc_.num_blocks(), 1);
+  size_t tape_vars = stack->var_stack_.size();
+  stan::math::recover_memory();
+
+  EXPECT_EQ(1, stack->memalloc_.num_blocks());
+  size_t arena_bytes = stack->memalloc_.bytes_allocated();
+  size_t capacity = stack->var_stack_.capacity();
+  EXPECT_GE(capacity, tape_vars);
+
+  for (int n = 0; n < 5; ++n) {
+    stan::math::grad(big_tape(100000).vi_);
+    EXPECT_EQ(1, stack->memalloc_.num_blocks());
+    EXPECT_EQ(arena_bytes, stack->memalloc_.bytes_allocated());
+    EXPECT_EQ(capacity, stack->var_stack_.capacity());
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevStack, adaptiveArenaCoalescesAfterNested) {
+  auto* stack = stan::math::ChainableStack::instance_;
+  stan::math::recover_memory();
+  stack->memalloc_.free_all();
+
+  {
+    stan::math::nested_rev_autodiff nested;
+    stan::math::grad(big_tape(200000).vi_);
+    EXPECT_GT(stack->memalloc_.num_blocks(), 1);
+  }
+  EXPECT_EQ(1, stack->memalloc_.num_blocks());
+  size_t arena_bytes = stack->memalloc_.bytes_allocated();
+
+  for (int n = 0; n < 5; ++n) {
+    stan::math::nested_rev_autodiff nested;
+    stan::math::grad(big_tape(200000).vi_);
+    EXPECT_EQ(1, stack->memalloc_.num_blocks());
+    EXPECT_EQ(arena_bytes, stack->memalloc_.bytes_allocated());
+  }
+}
+
+TEST(AgradRevStack, adaptiveArenaKeepsOuterTape) {
+  auto* stack = stan::math::ChainableStack::instance_;
+  stan::math::recover_memory();
+  stack->memalloc_.free_all();
+
+  stan::math::var a = 2.0;
+  {
+    stan::math::nested_rev_autodiff nested;
+    stan::math::grad(big_tape(200000).vi_);
+  }
+  // the outer tape is still alive so the arena must not be coalesced
+  EXPECT_GT(stack->memalloc_.num_blocks(), 1);
+  EXPECT_FLOAT_EQ(2.0, a.val());
+  stan::math::recover_memory();
+  EXPECT_EQ(1, stack->memalloc_.num_blocks());
+}
+
+TEST(AgradRevStack, adaptiveArenaDisabled) {
+  auto* stack = stan::math::ChainableStack::instance_;
+  stan::math::recover_memory();
+  stack->memalloc_.free_all();
+  size_t window = stack->tape_size_window_;
+  stack->tape_size_window_ = 0;
+  stack->recent_tape_sizes_.clear();
+
+  stan::math::grad(big_tape(100000).vi_);
+  size_t num_blocks = stack->memalloc_.num_blocks();
+  EXPECT_GT(num_blocks, 1);
+  stan::math::recover_memory();
+  EXPECT_EQ(num_blocks, stack->memalloc_.num_blocks());
+  // the peak still refers to the current tape only
+  EXPECT_EQ(0, stack->memalloc_.peak_bytes_used());
+
+  stan::math::var a = 2.0;
+  EXPECT_EQ(2.0, a.val());
+  EXPECT_LT(stack->memalloc_.peak_bytes_used(), 1024);
+  stan::math::recover_memory();
+
+  stack->tape_size_window_ = window;
+}
@@ -99,6 +99,7 @@ TEST(Profiling, var_loop) {
     profile<var> t1("t1", profiles);
     var a = i;
     var b = 2.0;
+    EXPECT_EQ(2.0, b.val());
     c = c + a;
     std::chrono::milliseconds timespan(10);
     std::this_thread::sleep_for(timespan);
@@ -123,3 +124,54 @@ TEST(Profiling, duplicate_active_profile) {
   profile<var> t1("t1", profiles);
   EXPECT_THROW(profile<var>("t1", profiles), std::runtime_error);
 }
+
+TEST(Profiling, var_memory) {
+  using stan::math::profile;
+  using stan::math::var;
+  auto* stack = stan::math::ChainableStack::instance_;
+  stan::math::recover_memory();
+  stack->memalloc_.free_all();
+  struct alloc_obj : public stan::math::chainable_alloc {
+    std::vector<double> x_{1.0, 2.0};
+  };
+
+  stan::math::profile_map profiles;
+  var c = 0;
+  {
+    profile<var> t1("t1", profiles);
+    for (int i = 0; i < 10000; ++i) {
+      c = c + i;
+    }
+    new alloc_obj();
+    new alloc_obj();
+    {
+      // recovered before the end of the region, but counts for the peak
+      stan::math::nested_rev_autodiff nested;
+      var d = 0;
+      for (int i = 0; i < 10000; ++i) {
+        d = d + i;
+      }
+    }
+  }
+  {
+    profile<double> t2("t2", profiles);
+    double d = 0;
+    d += 1;
+  }
+  stan::math::profile_key key_t1 = {"t1", std::this_thread::get_id()};
+  stan::math::profile_key key_t2 = {"t2", std::this_thread::get_id()};
+  const auto& t1 = profiles[key_t1];
+  EXPECT_EQ(2, t1.get_alloc_stack_used());
+  EXPECT_GE(t1.get_arena_bytes_used(), 10000 * sizeof(stan::math::vari));
+  EXPECT_GT(t1.get_arena_peak_bytes(), t1.get_arena_bytes_used());
+  EXPECT_EQ(stack->memalloc_.num_blocks(), t1.get_arena_blocks());
+  EXPECT_GT(t1.get_arena_blocks(), 1);
+  EXPECT_EQ(t1.get_arena_blocks() - 1 + 2, t1.get_num_heap_allocations());
+
+  const auto& t2 = profiles[key_t2];
+  EXPECT_EQ(0, t2.get_alloc_stack_used());
+  EXPECT_EQ(0, t2.get_arena_bytes_used());
+  EXPECT_EQ(0, t2.get_arena_peak_bytes());
+  EXPECT_EQ(0, t2.get_num_heap_allocations());
+  stan::math::recover_memory();
+}
@@ -0,0 +1,123 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace {
+using stan::math::var;
+using stan::math::vari;
+using stan::math::internal::push_scalar_op;
+using stan::math::internal::scalar_op;
+
+var taped(scalar_op op, const var& a, const var& b) {
+  double val = 0;
+  switch (op) {
+    case scalar_op::add_vv:
+      val = a.val() + b.val();
+      break;
+    case scalar_op::subtract_vv:
+      val = a.val() - b.val();
+      break;
+    case scalar_op::multiply_vv:
+      val = a.val() * b.val();
+      break;
+    case scalar_op::divide_vv:
+      val = a.val() / b.val();
+      break;
+    default:
+      break;
+  }
+  return var(push_scalar_op(op, val, a.vi_, b.vi_));
+}
+}  // namespace
+
+TEST(AgradRevScalarOpTape, binaryGradients) {
+  double a_val = 1.3;
+  double b_val = -2.1;
+  std::vector<scalar_op> ops{scalar_op::add_vv, scalar_op::subtract_vv,
+                             scalar_op::multiply_vv, scalar_op::divide_vv};
+  std::vector<double> vals{a_val + b_val, a_val - b_val, a_val * b_val,
+                           a_val / b_val};
+  std::vector<double> a_adjs{1, 1, b_val, 1 / b_val};
+  std::vector<double> b_adjs{1, -1, a_val, -a_val / (b_val * b_val)};
+  for (size_t i = 0; i < ops.size(); ++i) {
+    var a = a_val;
+    var b = b_val;
+    var f = taped(ops[i], a, b);
+    f.grad();
+    EXPECT_FLOAT_EQ(vals[i], f.val());
+    EXPECT_FLOAT_EQ(a_adjs[i], a.adj());
+    EXPECT_FLOAT_EQ(b_adjs[i], b.adj());
+    stan::math::recover_memory();
+  }
+}
+
+TEST(AgradRevScalarOpTape, unaryGradients) {
+  var a = 0.7;
+  var f = var(push_scalar_op(scalar_op::exp_v, std::exp(a.val()), a.vi_));
+  var g = var(push_scalar_op(scalar_op::log_v, std::log(f.val()), f.vi_));
+  var h = var(push_scalar_op(scalar_op::sqrt_v, std::sqrt(g.val()), g.vi_));
+  var k = var(push_scalar_op(scalar_op::square_v, h.val() * h.val(), h.vi_));
+  var m = var(push_scalar_op(scalar_op::negate_v, -k.val(), k.vi_));
+  var n
+      = var(push_scalar_op(scalar_op::divide_dv, 2.0 / m.val(), m.vi_, 2.0));
+  var p
+      = var(push_scalar_op(scalar_op::subtract_dv, 1.0 - n.val(), n.vi_, 1.0));
+  var q
+      = var(push_scalar_op(scalar_op::multiply_vd, p.val() * 3.0, p.vi_, 3.0));
+  // q = 3 * (1 - 2 / -a) = 3 + 6 / a
+  EXPECT_FLOAT_EQ(3.0 + 6.0 / 0.7, q.val());
+  q.grad();
+  EXPECT_FLOAT_EQ(-6.0 / (0.7 * 0.7), a.adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevScalarOpTape, interleavesWithOtherVari) {
+  // x * y is taped, the callback vari splits the segment
+  var x = 1.5;
+  var y = 2.5;
+  var xy = var(push_scalar_op(scalar_op::multiply_vv, x.val() * y.val(),
+                              x.vi_, y.vi_));
+  var z = stan::math::make_callback_var(
+      xy.val() * xy.val(), [xy](auto& vi) mutable {
+        xy.adj() += 2.0 * xy.val() * vi.adj();
+      });
+  var w = var(push_scalar_op(scalar_op::add_vv, z.val() + x.val(), z.vi_,
+                             x.vi_));
+  var u = var(push_scalar_op(scalar_op::add_vd, w.val() + 1.0, w.vi_, 1.0));
+  // u = (x * y)^2 + x + 1
+  u.grad();
+  EXPECT_FLOAT_EQ(2.0 * 1.5 * 2.5 * 2.5 + 1.0, x.adj());
+  EXPECT_FLOAT_EQ(2.0 * 1.5 * 2.5 * 1.5, y.adj());
+
+  stan::math::set_zero_all_adjoints();
+  EXPECT_FLOAT_EQ(0.0, xy.adj());
+  EXPECT_FLOAT_EQ(0.0, x.adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevScalarOpTape, longTapesAndNesting) {
+  var x = 0.5;
+  var sum = x;
+  // spans several segments
+  for (int i = 0; i < 1000; ++i) {
+    sum = var(push_scalar_op(scalar_op::add_vv, sum.val() + x.val(), sum.vi_,
+                             x.vi_));
+  }
+  {
+    stan::math::nested_rev_autodiff nested;
+    var y = 2.0;
+    var y2 = var(push_scalar_op(scalar_op::multiply_vv, y.val() * x.val(),
+                                y.vi_, x.vi_));
+    stan::math::grad(y2.vi_);
+    EXPECT_FLOAT_EQ(0.5, y.adj());
+    EXPECT_FLOAT_EQ(2.0, x.adj());
+    nested.set_zero_all_adjoints();
+  }
+  x.adj() = 0;
+  var more = var(push_scalar_op(scalar_op::multiply_vd, sum.val() * 2.0,
+                                sum.vi_, 2.0));
+  more.grad();
+  EXPECT_FLOAT_EQ(2.0 * 1001, x.adj());
+  stan::math::recover_memory();
+}
@@ -0,0 +1,55 @@
+#define STAN_TAPE_HISTOGRAM
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <typeindex>
+
+TEST(AgradRevTapeHistogram, countsChainCalls) {
+  using stan::math::var;
+  stan::math::reset_tape_histogram();
+  Eigen::Matrix<var, -1, 1> x(3);
+  x << 1.0, 2.0, 3.0;
+  var lp = 0;
+  for (int i = 0; i < 10; ++i) {
+    lp += stan::math::log_sum_exp(x) * i;
+  }
+  lp.grad();
+
+  const auto& histogram = stan::math::tape_histogram();
+  EXPECT_FALSE(histogram.empty());
+  size_t total = 0;
+  for (const auto& entry : histogram) {
+    EXPECT_GT(entry.second.count_, 0);
+    EXPECT_GE(entry.second.time_, 0.0);
+    total += entry.second.count_;
+  }
+  EXPECT_EQ(stan::math::ChainableStack::instance_->var_stack_.size(), total);
+
+  std::stringstream report;
+  stan::math::print_tape_histogram(report);
+  EXPECT_EQ(0, report.str().find("TAPE HISTOGRAM, types="));
+  EXPECT_NE(std::string::npos, report.str().find("chain calls="
+                                                 + std::to_string(total)));
+  stan::math::recover_memory();
+
+  stan::math::reset_tape_histogram();
+  EXPECT_TRUE(stan::math::tape_histogram().empty());
+}
+
+TEST(AgradRevTapeHistogram, nestedGrad) {
+  using stan::math::var;
+  stan::math::reset_tape_histogram();
+  var a = 2.0;
+  {
+    stan::math::nested_rev_autodiff nested;
+    var b = a * a;
+    stan::math::grad(b.vi_);
+  }
+  size_t total = 0;
+  for (const auto& entry : stan::math::tape_histogram()) {
+    total += entry.second.count_;
+  }
+  EXPECT_EQ(1, total);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,154 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+using stan::math::var;
+
+template <typename T1, typename T2>
+auto group_lp(const std::vector<double>& y, const T1& mu,
+              const T2& log_sigma) {
+  using stan::math::exp;
+  using stan::math::square;
+  decltype(mu * log_sigma) lp = 0;
+  for (double y_n : y) {
+    lp -= 0.5 * square((y_n - mu) / exp(log_sigma)) + log_sigma;
+  }
+  return lp;
+}
+
+std::vector<std::vector<double>> groups(int G, int N) {
+  std::vector<std::vector<double>> y(G);
+  for (int g = 0; g < G; ++g) {
+    for (int n = 0; n < N; ++n) {
+      y[g].push_back(0.1 * g - 0.05 * n);
+    }
+  }
+  return y;
+}
+}  // namespace
+
+TEST(AgradRevTapeSegments, gradientMatchesSerial) {
+  auto y = groups(32, 20);
+  std::vector<double> mu_adj;
+  std::vector<double> log_sigma_adj;
+  double lp_val;
+  {
+    var mu = 0.3;
+    std::vector<var> log_sigma;
+    for (size_t g = 0; g < y.size(); ++g) {
+      log_sigma.emplace_back(0.2 + 0.01 * g);
+    }
+    var lp = 0;
+    for (size_t g = 0; g < y.size(); ++g) {
+      lp += group_lp(y[g], mu, log_sigma[g]);
+    }
+    lp.grad();
+    lp_val = lp.val();
+    mu_adj.push_back(mu.adj());
+    for (auto& x : log_sigma) {
+      log_sigma_adj.push_back(x.adj());
+    }
+    stan::math::recover_memory();
+  }
+
+  var mu = 0.3;
+  std::vector<var> log_sigma;
+  for (size_t g = 0; g < y.size(); ++g) {
+    log_sigma.emplace_back(0.2 + 0.01 * g);
+  }
+  stan::math::tape_segments segments;
+  std::vector<var> terms(y.size());
+  for (size_t g = 0; g < y.size(); ++g) {
+    segments.begin();
+    var mu_g = segments.local(mu);
+    var log_sigma_g = segments.local(log_sigma[g]);
+    terms[g] = group_lp(y[g], mu_g, log_sigma_g);
+    segments.end();
+  }
+  segments.join();
+  EXPECT_EQ(y.size(), segments.size());
+  var lp = stan::math::sum(terms);
+  // only the join node and the sum are left on the stack
+  EXPECT_EQ(2, stan::math::ChainableStack::instance_->var_stack_.size());
+  lp.grad();
+  EXPECT_FLOAT_EQ(lp_val, lp.val());
+  EXPECT_FLOAT_EQ(mu_adj[0], mu.adj());
+  for (size_t g = 0; g < y.size(); ++g) {
+    EXPECT_FLOAT_EQ(log_sigma_adj[g], log_sigma[g].adj());
+  }
+
+  stan::math::set_zero_all_adjoints();
+  EXPECT_FLOAT_EQ(0.0, mu.adj());
+  EXPECT_FLOAT_EQ(0.0, terms[0].adj());
+  lp.grad();
+  EXPECT_FLOAT_EQ(mu_adj[0], mu.adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevTapeSegments, containersAndGaps) {
+  Eigen::Matrix<stan::math::var, -1, 1> beta(3);
+  beta << 0.5, -1.0, 2.0;
+  stan::math::tape_segments segments;
+  std::vector<var> terms;
+  for (int g = 0; g < 4; ++g) {
+    // created between segments and used as a shared variable
+    var scale = beta(g % 3) * 2.0;
+    segments.begin();
+    auto beta_g = segments.local(beta);
+    var scale_g = segments.local(scale);
+    terms.push_back(stan::math::dot_self(beta_g) * scale_g);
+    segments.end();
+  }
+  segments.join();
+  var lp = stan::math::sum(terms);
+  lp.grad();
+  // lp = |beta|^2 * 2 * (2 beta_0 + beta_1 + beta_2)
+  double norm = 0.25 + 1.0 + 4.0;
+  double s = 2.0 * (2 * 0.5 - 1.0 + 2.0);
+  EXPECT_FLOAT_EQ(norm * s, lp.val());
+  EXPECT_FLOAT_EQ(2 * 0.5 * s + norm * 4.0, beta(0).adj());
+  EXPECT_FLOAT_EQ(2 * -1.0 * s + norm * 2.0, beta(1).adj());
+  EXPECT_FLOAT_EQ(2 * 2.0 * s + norm * 2.0, beta(2).adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevTapeSegments, nested) {
+  var mu = 1.5;
+  {
+    stan::math::nested_rev_autodiff nested;
+    stan::math::tape_segments segments;
+    std::vector<var> terms;
+    for (int g = 0; g < 3; ++g) {
+      segments.begin();
+      terms.push_back(stan::math::square(segments.local(mu)) * (g + 1));
+      segments.end();
+    }
+    segments.join();
+    var lp = stan::math::sum(terms);
+    stan::math::grad(lp.vi_);
+    EXPECT_FLOAT_EQ(2 * 1.5 * 6, mu.adj());
+  }
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevTapeSegments, misuseThrows) {
+  var mu = 1.5;
+  stan::math::tape_segments segments;
+  EXPECT_THROW(segments.end(), std::logic_error);
+  EXPECT_THROW(segments.local(mu), std::logic_error);
+  segments.begin();
+  EXPECT_THROW(segments.begin(), std::logic_error);
+  EXPECT_THROW(segments.join(), std::logic_error);
+  var x = segments.local(mu) * 2.0;
+  segments.end();
+  var y = x * 3.0;
+  EXPECT_FLOAT_EQ(9.0, y.val());
+  EXPECT_THROW(segments.join(), std::logic_error);
+  {
+    stan::math::nested_rev_autodiff nested;
+    EXPECT_THROW(segments.begin(), std::logic_error);
+  }
+  stan::math::recover_memory();
+}
@@ -0,0 +1,187 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+// runs the AR(1) recursion s_t = rho * s_{t - 1} + mu for the steps
+// [begin, end) and returns the final state and the log density of y
+struct ar_block {
+  const std::vector<double>& y_;
+  int begin_;
+  int end_;
+
+  template <typename T_s, typename T_p>
+  inline Eigen::Matrix<stan::return_type_t<T_s, T_p>, Eigen::Dynamic, 1>
+  operator()(const T_s& s0, const Eigen::Matrix<T_p, Eigen::Dynamic, 1>& p)
+      const {
+    using T = stan::return_type_t<T_s, T_p>;
+    T s = s0;
+    T lp = 0;
+    for (int t = begin_; t < end_; ++t) {
+      s = p(0) * s + p(1);
+      lp += stan::math::normal_lpdf(y_[t], s, stan::math::exp(p(2)));
+    }
+    Eigen::Matrix<T, Eigen::Dynamic, 1> res(2);
+    res << s, lp;
+    return res;
+  }
+};
+
+template <typename T>
+T ar_lp(const std::vector<double>& y, const T& s0,
+        const Eigen::Matrix<T, Eigen::Dynamic, 1>& p, int block_size) {
+  T s = s0;
+  T lp = 0;
+  const int N = y.size();
+  for (int begin = 0; begin < N; begin += block_size) {
+    ar_block block{y, begin, std::min(begin + block_size, N)};
+    auto res = block_size < N ? stan::math::checkpoint(block, s, p)
+                              : block(s, p);
+    s = res(0);
+    lp += res(1);
+  }
+  return lp;
+}
+
+std::vector<double> ar_data(int N) {
+  std::vector<double> y(N);
+  for (int t = 0; t < N; ++t) {
+    y[t] = std::sin(0.1 * t) + 0.3 * std::cos(0.7 * t);
+  }
+  return y;
+}
+
+struct scaled_square {
+  template <typename T1, typename T2>
+  inline stan::return_type_t<T1, T2> operator()(const T1& x,
+                                                const T2& c) const {
+    return c * stan::math::square(x);
+  }
+};
+
+struct outer_block {
+  template <typename T>
+  inline T operator()(const T& x) const {
+    T y = stan::math::checkpoint(scaled_square(), x, 3.0);
+    return stan::math::exp(stan::math::checkpoint(scaled_square(), y, 0.5));
+  }
+};
+
+// owns heap memory and counts its live copies
+struct weighted_sum {
+  static int live_;
+  std::vector<double> w_;
+
+  explicit weighted_sum(std::vector<double> w) : w_(std::move(w)) { ++live_; }
+  weighted_sum(const weighted_sum& other) : w_(other.w_) { ++live_; }
+  weighted_sum(weighted_sum&& other) : w_(std::move(other.w_)) { ++live_; }
+  ~weighted_sum() { --live_; }
+
+  template <typename T>
+  inline stan::value_type_t<T> operator()(const T& x) const {
+    stan::value_type_t<T> res = 0;
+    for (size_t i = 0; i < w_.size(); ++i) {
+      res += w_[i] * x(i);
+    }
+    return res;
+  }
+};
+int weighted_sum::live_ = 0;
+
+struct identity {
+  template <typename T>
+  inline T operator()(const T& x) const {
+    return x;
+  }
+};
+}  // namespace
+
+TEST(RevFunctor, checkpoint_matches_direct_gradient) {
+  using stan::math::var;
+  const int N = 100;
+  std::vector<double> y = ar_data(N);
+  Eigen::VectorXd p_val(3);
+  p_val << 0.8, 0.1, -0.5;
+
+  std::vector<Eigen::VectorXd> grads;
+  std::vector<double> lps;
+  for (int block_size : {N, 10, 7}) {
+    stan::math::nested_rev_autodiff nested;
+    var s0 = 0.2;
+    Eigen::Matrix<var, Eigen::Dynamic, 1> p = p_val;
+    var lp = ar_lp(y, s0, p, block_size);
+    lp.grad();
+    Eigen::VectorXd g(4);
+    g << s0.adj(), p.adj();
+    grads.push_back(g);
+    lps.push_back(lp.val());
+  }
+  for (size_t i = 1; i < grads.size(); ++i) {
+    EXPECT_FLOAT_EQ(lps[0], lps[i]);
+    EXPECT_MATRIX_NEAR(grads[0], grads[i], 1e-10);
+  }
+}
+
+TEST(RevFunctor, checkpoint_keeps_block_graphs_off_the_stack) {
+  using stan::math::var;
+  const int N = 100;
+  std::vector<double> y = ar_data(N);
+  Eigen::VectorXd p_val(3);
+  p_val << 0.8, 0.1, -0.5;
+
+  std::vector<size_t> stack_sizes;
+  for (int block_size : {N, 10}) {
+    stan::math::nested_rev_autodiff nested;
+    var s0 = 0.2;
+    Eigen::Matrix<var, Eigen::Dynamic, 1> p = p_val;
+    var lp = ar_lp(y, s0, p, block_size);
+    stack_sizes.push_back(stan::math::nested_size());
+    lp.grad();
+  }
+  // one callback per block and the sums of the block results
+  EXPECT_LE(stack_sizes[1], 3 * 10);
+  EXPECT_GT(stack_sizes[0], 3 * N);
+}
+
+TEST(RevFunctor, checkpoint_nested) {
+  using stan::math::var;
+  var x = 1.3;
+  var f = stan::math::checkpoint(outer_block(), x);
+  // exp(1.5 * 3 * x^4)
+  EXPECT_FLOAT_EQ(std::exp(4.5 * std::pow(1.3, 4)), f.val());
+  f.grad();
+  EXPECT_FLOAT_EQ(f.val() * 18 * std::pow(1.3, 3), x.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevFunctor, checkpoint_returning_argument) {
+  using stan::math::var;
+  var x = 2.0;
+  var f = stan::math::checkpoint(identity(), x);
+  var g = 3 * f + x;
+  g.grad();
+  EXPECT_FLOAT_EQ(2.0, f.val());
+  EXPECT_FLOAT_EQ(4.0, x.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevFunctor, checkpoint_double_arguments) {
+  EXPECT_FLOAT_EQ(12.0, stan::math::checkpoint(scaled_square(), 2.0, 3.0));
+}
+
+TEST(RevFunctor, checkpoint_destroys_function_on_recover) {
+  using stan::math::var;
+  {
+    weighted_sum f({1.0, 2.0, 3.0});
+    Eigen::Matrix<var, Eigen::Dynamic, 1> x(3);
+    x << 1.0, 1.0, 1.0;
+    var g = stan::math::checkpoint(f, x);
+    EXPECT_GT(weighted_sum::live_, 1);
+    g.grad();
+    EXPECT_FLOAT_EQ(6.0, g.val());
+    EXPECT_FLOAT_EQ(3.0, x.adj()(2));
+  }
+  stan::math::recover_memory();
+  EXPECT_EQ(0, weighted_sum::live_);
+}
@@ -0,0 +1,78 @@
+#define STAN_ODE_FORWARD_SENSITIVITIES
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/functor/harmonic_oscillator.hpp>
+#include <test/unit/math/rev/functor/var_only_ode_functor.hpp>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+struct StanAgradRevOdeForward : public ::testing::Test {
+  void SetUp() { stan::math::recover_memory(); }
+  std::stringstream msgs;
+  std::vector<double> x;
+  std::vector<int> x_int;
+};
+
+TEST_F(StanAgradRevOdeForward, coupled_ode_system_forward_matches_reverse) {
+  using stan::math::coupled_ode_system;
+  using stan::math::var;
+
+  harm_osc_ode_fun_eigen harm_osc;
+  Eigen::VectorXd y0(2);
+  y0 << 1.0, 0.5;
+
+  // the oscillator only uses theta[0], so the extra parameters only
+  // add zero sensitivities, but with more than twice as many
+  // parameters as states the sensitivities are computed in reverse mode
+  std::vector<var> theta_forward{0.15};
+  std::vector<var> theta_reverse{0.15, 1.0, 2.0, 3.0, 4.0};
+
+  coupled_ode_system<decltype(harm_osc), double, std::vector<var>,
+                     std::vector<double>, std::vector<int>>
+      system_forward(harm_osc, y0, &msgs, theta_forward, x, x_int);
+  coupled_ode_system<decltype(harm_osc), double, std::vector<var>,
+                     std::vector<double>, std::vector<int>>
+      system_reverse(harm_osc, y0, &msgs, theta_reverse, x, x_int);
+  EXPECT_TRUE(system_forward.use_forward_mode_);
+  EXPECT_FALSE(system_reverse.use_forward_mode_);
+
+  std::vector<double> z_forward{1.0, 0.5, 1.0, 2.0};
+  std::vector<double> z_reverse{1.0, 0.5, 1.0, 2.0, 0.3, -0.2,
+                                0.1, 0.0, 0.0, 0.0, 0.0, 0.0};
+  std::vector<double> dz_dt_forward;
+  std::vector<double> dz_dt_reverse;
+  system_forward(z_forward, dz_dt_forward, 0.0);
+  system_reverse(z_reverse, dz_dt_reverse, 0.0);
+
+  EXPECT_TRUE(stan::math::empty_nested());
+  ASSERT_EQ(4, dz_dt_forward.size());
+  ASSERT_EQ(12, dz_dt_reverse.size());
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_FLOAT_EQ(dz_dt_forward[i], dz_dt_reverse[i]);
+  }
+  // d/dt of the sensitivities to theta[1], which does not enter the RHS
+  EXPECT_FLOAT_EQ(-0.2, dz_dt_reverse[4]);
+  EXPECT_FLOAT_EQ(-0.3 + 0.15 * 0.2, dz_dt_reverse[5]);
+}
+
+TEST_F(StanAgradRevOdeForward, coupled_ode_system_var_only_rhs) {
+  using stan::math::coupled_ode_system;
+  using stan::math::var;
+
+  // a RHS without fvar overloads falls back to reverse mode
+  var_only_decay_ode_fun decay;
+  Eigen::VectorXd y0(2);
+  y0 << 1.0, 2.0;
+  std::vector<var> theta{0.5, 0.25};
+
+  coupled_ode_system<var_only_decay_ode_fun, double, std::vector<var>> system(
+      decay, y0, &msgs, theta);
+  EXPECT_FALSE(system.use_forward_mode_);
+
+  std::vector<double> ts{1.0};
+  auto ys = stan::math::ode_rk45(decay, y0, 0.0, ts, &msgs, theta);
+  ys[0](1).grad();
+  EXPECT_NEAR(2.0 * std::exp(-0.25), ys[0](1).val(), 1e-6);
+  EXPECT_NEAR(-2.0 * std::exp(-0.25), theta[1].adj(), 1e-6);
+}
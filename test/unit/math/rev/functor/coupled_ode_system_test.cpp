@@ -4,6 +4,8 @@
 #include <test/unit/math/prim/functor/harmonic_oscillator.hpp>
 #include <test/unit/math/prim/functor/mock_ode_functor.hpp>
 #include <test/unit/math/prim/functor/mock_throwing_ode_functor.hpp>
+#include <test/unit/math/rev/functor/var_only_ode_functor.hpp>
+#include <cmath>
 #include <vector>
 #include <string>
 
@@ -743,3 +745,52 @@ TEST_F(StanAgradRevOde, coupled_ode_system_extra_args) {
   EXPECT_FLOAT_EQ(dz_dt[6], -2.1225);
   EXPECT_FLOAT_EQ(dz_dt[7], -3.9015);
 }
+
+TEST_F(StanAgradRevOde, coupled_ode_system_var_only_rhs) {
+  using stan::math::coupled_ode_system;
+  using stan::math::var;
+
+  var_only_decay_ode_fun decay;
+  Eigen::VectorXd y0(2);
+  y0 << 1.0, 2.0;
+  std::vector<var> theta{0.5, 0.25};
+
+  coupled_ode_system<var_only_decay_ode_fun, double, std::vector<var>> system(
+      decay, y0, &msgs, theta);
+  EXPECT_FALSE(system.use_forward_mode_);
+
+  // states, then their sensitivities to theta[0] and to theta[1]
+  std::vector<double> z{1.0, 2.0, 0.1, 0.2, 0.3, 0.4};
+  std::vector<double> dz_dt;
+  system(z, dz_dt, 0.0);
+
+  ASSERT_EQ(6, dz_dt.size());
+  EXPECT_FLOAT_EQ(-0.5, dz_dt[0]);
+  EXPECT_FLOAT_EQ(-0.5, dz_dt[1]);
+  EXPECT_FLOAT_EQ(-1.0 - 0.5 * 0.1, dz_dt[2]);
+  EXPECT_FLOAT_EQ(-0.25 * 0.2, dz_dt[3]);
+  EXPECT_FLOAT_EQ(-0.5 * 0.3, dz_dt[4]);
+  EXPECT_FLOAT_EQ(-2.0 - 0.25 * 0.4, dz_dt[5]);
+}
+
+TEST_F(StanAgradRevOde, ode_rk45_var_only_rhs) {
+  using stan::math::var;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y0(2);
+  y0 << 1.0, 2.0;
+  std::vector<var> theta{0.5, 0.25};
+  std::vector<double> ts{1.0};
+
+  auto ys_rk45 = stan::math::ode_rk45(var_only_decay_ode_fun(), y0, 0.0, ts,
+                                      &msgs, theta);
+  auto ys_ckrk = stan::math::ode_ckrk(var_only_decay_ode_fun(), y0, 0.0, ts,
+                                      &msgs, theta);
+  for (var y : {ys_rk45[0](1), ys_ckrk[0](1)}) {
+    EXPECT_NEAR(2.0 * std::exp(-0.25), y.val(), 1e-6);
+    stan::math::set_zero_all_adjoints();
+    y.grad();
+    EXPECT_NEAR(std::exp(-0.25), y0(1).adj(), 1e-6);
+    EXPECT_NEAR(-2.0 * std::exp(-0.25), theta[1].adj(), 1e-6);
+    EXPECT_FLOAT_EQ(0.0, theta[0].adj());
+  }
+}
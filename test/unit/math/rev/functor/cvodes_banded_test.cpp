@@ -0,0 +1,183 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace cvodes_banded_test {
+
+// discretized reaction diffusion equation, with a tridiagonal Jacobian
+struct reaction_diffusion {
+  template <typename T_y, typename T_theta>
+  Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1>
+  operator()(double t, const Eigen::Matrix<T_y, Eigen::Dynamic, 1>& y,
+             std::ostream* msgs, const std::vector<T_theta>& theta) const {
+    const int N = y.size();
+    Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1> dy_dt(
+        N);
+    for (int i = 0; i < N; ++i) {
+      auto left = i > 0 ? y(i - 1) : y(i);
+      auto right = i < N - 1 ? y(i + 1) : y(i);
+      dy_dt(i) = theta[0] * (left - 2 * y(i) + right) - theta[1] * y(i) * y(i);
+    }
+    return dy_dt;
+  }
+};
+
+// reaction_diffusion only defined for double and var states
+struct var_only_reaction_diffusion {
+  Eigen::VectorXd operator()(double t, const Eigen::VectorXd& y,
+                             std::ostream* msgs,
+                             const std::vector<double>& theta) const {
+    return reaction_diffusion()(t, y, msgs, theta);
+  }
+
+  template <typename T_theta>
+  Eigen::Matrix<stan::math::var, Eigen::Dynamic, 1> operator()(
+      double t, const Eigen::Matrix<stan::math::var, Eigen::Dynamic, 1>& y,
+      std::ostream* msgs, const std::vector<T_theta>& theta) const {
+    return reaction_diffusion()(t, y, msgs, theta);
+  }
+};
+
+// transport downstream, with two nonzero diagonals below the main diagonal
+struct downstream {
+  template <typename T_y, typename T_theta>
+  Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1>
+  operator()(double t, const Eigen::Matrix<T_y, Eigen::Dynamic, 1>& y,
+             std::ostream* msgs, const std::vector<T_theta>& theta) const {
+    const int N = y.size();
+    Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1> dy_dt(
+        N);
+    for (int i = 0; i < N; ++i) {
+      dy_dt(i) = -theta[0] * y(i);
+      if (i > 0) {
+        dy_dt(i) += theta[1] * y(i - 1);
+      }
+      if (i > 1) {
+        dy_dt(i) += 0.5 * theta[1] * y(i - 2);
+      }
+    }
+    return dy_dt;
+  }
+};
+
+template <typename F, typename Banded, typename Dense>
+void expect_banded_matches_dense(const F& f, const std::vector<double>& theta,
+                                 const Banded& banded, const Dense& dense) {
+  using stan::math::var;
+  const int N = 11;
+  Eigen::VectorXd y0 = Eigen::VectorXd::Zero(N);
+  y0(0) = 1.0;
+  y0(N / 2) = 0.5;
+  std::vector<double> ts{0.5, 1.0, 5.0};
+
+  std::vector<var> theta_banded(theta.begin(), theta.end());
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y0_banded = y0;
+  auto ys_banded = banded(f, y0_banded, ts, theta_banded);
+
+  std::vector<var> theta_dense(theta.begin(), theta.end());
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y0_dense = y0;
+  auto ys_dense = dense(f, y0_dense, ts, theta_dense);
+
+  ASSERT_EQ(ys_banded.size(), ts.size());
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (int i = 0; i < N; ++i) {
+      EXPECT_NEAR(ys_banded[n](i).val(), ys_dense[n](i).val(), 1e-8);
+
+      stan::math::set_zero_all_adjoints();
+      ys_banded[n](i).grad();
+      std::vector<double> theta_adj_banded(theta.size());
+      for (size_t k = 0; k < theta.size(); ++k) {
+        theta_adj_banded[k] = theta_banded[k].adj();
+      }
+      Eigen::VectorXd y0_adj_banded = y0_banded.adj();
+
+      stan::math::set_zero_all_adjoints();
+      ys_dense[n](i).grad();
+      for (size_t k = 0; k < theta.size(); ++k) {
+        EXPECT_NEAR(theta_adj_banded[k], theta_dense[k].adj(), 1e-6);
+      }
+      for (int j = 0; j < N; ++j) {
+        EXPECT_NEAR(y0_adj_banded(j), y0_dense(j).adj(), 1e-6);
+      }
+    }
+  }
+  stan::math::recover_memory();
+}
+
+}  // namespace cvodes_banded_test
+
+TEST(StanMathOdeBanded, bdf_tridiagonal_matches_dense) {
+  expect_banded_matches_dense(
+      cvodes_banded_test::reaction_diffusion(), {0.7, 0.3},
+      [](const auto& f, const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_bdf_banded_tol(f, y0, 0.0, ts, 1e-10, 1e-10,
+                                              1e6, 1, 1, nullptr, theta);
+      },
+      [](const auto& f, const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_bdf_tol(f, y0, 0.0, ts, 1e-10, 1e-10, 1e6,
+                                       nullptr, theta);
+      });
+}
+
+TEST(StanMathOdeBanded, bdf_lower_band_matches_dense) {
+  expect_banded_matches_dense(
+      cvodes_banded_test::downstream(), {1.3, 0.8},
+      [](const auto& f, const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_bdf_banded_tol(f, y0, 0.0, ts, 1e-10, 1e-10,
+                                              1e6, 0, 2, nullptr, theta);
+      },
+      [](const auto& f, const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_bdf_tol(f, y0, 0.0, ts, 1e-10, 1e-10, 1e6,
+                                       nullptr, theta);
+      });
+}
+
+TEST(StanMathOdeBanded, adams_tridiagonal_matches_dense) {
+  expect_banded_matches_dense(
+      cvodes_banded_test::reaction_diffusion(), {0.7, 0.3},
+      [](const auto& f, const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_adams_banded_tol(f, y0, 0.0, ts, 1e-10, 1e-10,
+                                                1e6, 1, 1, nullptr, theta);
+      },
+      [](const auto& f, const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_adams_tol(f, y0, 0.0, ts, 1e-10, 1e-10, 1e6,
+                                         nullptr, theta);
+      });
+}
+
+TEST(StanMathOdeBanded, var_only_rhs_matches_dense) {
+  // without fvar overloads the band is taken from the reverse mode Jacobian
+  expect_banded_matches_dense(
+      cvodes_banded_test::var_only_reaction_diffusion(), {0.7, 0.3},
+      [](const auto& f, const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_bdf_banded_tol(f, y0, 0.0, ts, 1e-10, 1e-10,
+                                              1e6, 1, 1, nullptr, theta);
+      },
+      [](const auto& f, const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_bdf_tol(f, y0, 0.0, ts, 1e-10, 1e-10, 1e6,
+                                       nullptr, theta);
+      });
+}
+
+TEST(StanMathOdeBanded, bandwidth_errors) {
+  Eigen::VectorXd y0 = Eigen::VectorXd::Ones(4);
+  std::vector<double> ts{1.0};
+  std::vector<double> theta{0.7, 0.3};
+  cvodes_banded_test::reaction_diffusion f;
+
+  EXPECT_NO_THROW(stan::math::ode_bdf_banded_tol(f, y0, 0.0, ts, 1e-8, 1e-8,
+                                                 1e6, 3, 3, nullptr, theta));
+  EXPECT_THROW(stan::math::ode_bdf_banded_tol(f, y0, 0.0, ts, 1e-8, 1e-8, 1e6,
+                                              -1, 1, nullptr, theta),
+               std::domain_error);
+  EXPECT_THROW(stan::math::ode_bdf_banded_tol(f, y0, 0.0, ts, 1e-8, 1e-8, 1e6,
+                                              1, -1, nullptr, theta),
+               std::domain_error);
+  EXPECT_THROW(stan::math::ode_bdf_banded_tol(f, y0, 0.0, ts, 1e-8, 1e-8, 1e6,
+                                              4, 1, nullptr, theta),
+               std::domain_error);
+  EXPECT_THROW(stan::math::ode_adams_banded_tol(f, y0, 0.0, ts, 1e-8, 1e-8,
+                                                1e6, 1, 4, nullptr, theta),
+               std::domain_error);
+}
@@ -0,0 +1,145 @@
+#define STAN_CVODES_CACHE
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace cvodes_cache_test {
+
+// independent exponential decays y_i' = -theta_i y_i
+struct decay {
+  template <typename T_y, typename T_theta>
+  Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1>
+  operator()(double t, const T_y& y, std::ostream* msgs,
+             const std::vector<T_theta>& theta) const {
+    Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1> dy_dt(
+        y.size());
+    for (int i = 0; i < y.size(); ++i) {
+      dy_dt(i) = -theta[i] * y.coeff(i);
+    }
+    return dy_dt;
+  }
+};
+
+// inverse of I - gamma J
+struct decay_preconditioner {
+  Eigen::VectorXd operator()(double t, const Eigen::VectorXd& y,
+                             const Eigen::VectorXd& r, double gamma,
+                             std::ostream* msgs,
+                             const std::vector<double>& theta) const {
+    Eigen::VectorXd z(r.size());
+    for (int i = 0; i < r.size(); ++i) {
+      z(i) = r(i) / (1.0 + gamma * theta[i]);
+    }
+    return z;
+  }
+};
+
+template <typename Solve>
+void expect_decay(const Solve& solve, int N) {
+  using stan::math::var;
+  std::vector<double> ts{0.5, 1.0, 2.0};
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y0(N);
+  std::vector<var> theta(N);
+  for (int i = 0; i < N; ++i) {
+    y0(i) = 1.0 + i;
+    theta[i] = 0.5 + 0.25 * i;
+  }
+
+  auto ys = solve(y0, ts, theta);
+  ASSERT_EQ(ys.size(), ts.size());
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (int i = 0; i < N; ++i) {
+      const double decayed = std::exp(-theta[i].val() * ts[n]);
+      EXPECT_NEAR(ys[n](i).val(), y0(i).val() * decayed, 1e-6);
+
+      stan::math::set_zero_all_adjoints();
+      ys[n](i).grad();
+      EXPECT_NEAR(y0(i).adj(), decayed, 1e-6);
+      EXPECT_NEAR(theta[i].adj(), -ts[n] * y0(i).val() * decayed, 1e-6);
+    }
+  }
+  stan::math::recover_memory();
+
+  std::vector<double> theta_d(N);
+  Eigen::VectorXd y0_d(N);
+  for (int i = 0; i < N; ++i) {
+    y0_d(i) = y0(i).val();
+    theta_d[i] = theta[i].val();
+  }
+  auto ys_d = solve(y0_d, ts, theta_d);
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (int i = 0; i < N; ++i) {
+      EXPECT_NEAR(ys_d[n](i), y0_d(i) * std::exp(-theta_d[i] * ts[n]), 1e-6);
+    }
+  }
+}
+
+}  // namespace cvodes_cache_test
+
+TEST(StanMathOdeCvodesCache, repeated_solves) {
+  auto bdf = [](const auto& y0, const auto& ts, const auto& theta) {
+    return stan::math::ode_bdf_tol(cvodes_cache_test::decay(), y0, 0.0, ts,
+                                   1e-10, 1e-10, 1e6, nullptr, theta);
+  };
+  auto adams = [](const auto& y0, const auto& ts, const auto& theta) {
+    return stan::math::ode_adams_tol(cvodes_cache_test::decay(), y0, 0.0, ts,
+                                     1e-10, 1e-10, 1e6, nullptr, theta);
+  };
+  auto banded = [](const auto& y0, const auto& ts, const auto& theta) {
+    return stan::math::ode_bdf_banded_tol(cvodes_cache_test::decay(), y0, 0.0,
+                                          ts, 1e-10, 1e-10, 1e6, 0, 0, nullptr,
+                                          theta);
+  };
+  auto krylov = [](const auto& y0, const auto& ts, const auto& theta) {
+    return stan::math::ode_bdf_krylov_tol(cvodes_cache_test::decay(), y0, 0.0,
+                                          ts, 1e-10, 1e-10, 1e6, nullptr,
+                                          theta);
+  };
+  auto preconditioned = [](const auto& y0, const auto& ts,
+                            const auto& theta) {
+    return stan::math::ode_bdf_krylov_tol(
+        cvodes_cache_test::decay(), cvodes_cache_test::decay_preconditioner(),
+        y0, 0.0, ts, 1e-10, 1e-10, 1e6, nullptr, theta);
+  };
+
+  std::size_t& hits = stan::math::internal::cvodes_workspace_cache_hits();
+  hits = 0;
+  for (int N : {2, 3, 2, 5, 3}) {
+    cvodes_cache_test::expect_decay(bdf, N);
+    cvodes_cache_test::expect_decay(adams, N);
+    cvodes_cache_test::expect_decay(banded, N);
+    cvodes_cache_test::expect_decay(krylov, N);
+    cvodes_cache_test::expect_decay(preconditioned, N);
+  }
+  // each expect_decay solves once with vars and once with doubles, which
+  // are different integrator types; the first solve of each size, type
+  // and linear solver creates a workspace and later ones reuse it
+  const std::size_t num_solves = 5 * 5 * 2;
+  const std::size_t num_created = 3 * 5 * 2;
+  EXPECT_EQ(num_solves - num_created, hits);
+}
+
+TEST(StanMathOdeCvodesCache, solve_after_error) {
+  auto bdf = [](const auto& y0, const auto& ts, const auto& theta) {
+    return stan::math::ode_bdf_tol(cvodes_cache_test::decay(), y0, 0.0, ts,
+                                   1e-10, 1e-10, 1e6, nullptr, theta);
+  };
+  cvodes_cache_test::expect_decay(bdf, 3);
+
+  Eigen::VectorXd y0 = Eigen::VectorXd::Ones(3);
+  std::vector<double> theta{0.5, 0.75, 1.0};
+  std::vector<double> ts{100.0};
+  EXPECT_THROW(stan::math::ode_bdf_tol(cvodes_cache_test::decay(), y0, 0.0, ts,
+                                       1e-10, 1e-10, 2, nullptr, theta),
+               std::domain_error);
+
+  // the failed solve took the cached double workspace and freed it
+  std::size_t& hits = stan::math::internal::cvodes_workspace_cache_hits();
+  const std::size_t hits_before = hits;
+  cvodes_cache_test::expect_decay(bdf, 3);
+  EXPECT_EQ(hits_before + 1, hits);
+  cvodes_cache_test::expect_decay(bdf, 3);
+  EXPECT_EQ(hits_before + 3, hits);
+}
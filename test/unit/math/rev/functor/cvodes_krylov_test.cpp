@@ -0,0 +1,205 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <test/unit/math/rev/functor/var_only_ode_functor.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace cvodes_krylov_test {
+
+// stiff discretized reaction diffusion equation
+struct reaction_diffusion {
+  template <typename T_y, typename T_theta>
+  Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1>
+  operator()(double t, const T_y& y, std::ostream* msgs,
+             const std::vector<T_theta>& theta) const {
+    const int N = y.size();
+    Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1> dy_dt(
+        N);
+    for (int i = 0; i < N; ++i) {
+      const auto left = i > 0 ? y.coeff(i - 1) : y.coeff(i);
+      const auto right = i < N - 1 ? y.coeff(i + 1) : y.coeff(i);
+      dy_dt(i) = theta[0] * (left - 2 * y.coeff(i) + right)
+                 - theta[1] * y.coeff(i) * y.coeff(i);
+    }
+    return dy_dt;
+  }
+};
+
+// inverse of the diagonal of I - gamma J
+struct jacobi_preconditioner {
+  int* num_calls;
+  Eigen::VectorXd operator()(double t, const Eigen::VectorXd& y,
+                             const Eigen::VectorXd& r, double gamma,
+                             std::ostream* msgs,
+                             const std::vector<double>& theta) const {
+    ++*num_calls;
+    return r.array()
+           / (1.0 + gamma * (2.0 * theta[0] + 2.0 * theta[1] * y.array()));
+  }
+};
+
+struct wrong_size_preconditioner {
+  Eigen::VectorXd operator()(double t, const Eigen::VectorXd& y,
+                             const Eigen::VectorXd& r, double gamma,
+                             std::ostream* msgs,
+                             const std::vector<double>& theta) const {
+    return r.head(1);
+  }
+};
+
+const int N = 20;
+const std::vector<double> theta_val{50.0, 0.5};
+const std::vector<double> ts{0.1, 0.5, 2.0};
+
+Eigen::VectorXd initial_state() {
+  Eigen::VectorXd y0(N);
+  for (int i = 0; i < N; ++i) {
+    y0(i) = 1.0 / (1.0 + i);
+  }
+  return y0;
+}
+
+template <typename Krylov, typename Dense>
+void expect_krylov_matches_dense(const Krylov& krylov, const Dense& dense) {
+  using stan::math::var;
+  Eigen::VectorXd y0 = initial_state();
+
+  std::vector<var> theta_krylov(theta_val.begin(), theta_val.end());
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y0_krylov = y0;
+  auto ys_krylov = krylov(y0_krylov, theta_krylov);
+
+  std::vector<var> theta_dense(theta_val.begin(), theta_val.end());
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y0_dense = y0;
+  auto ys_dense = dense(y0_dense, theta_dense);
+
+  ASSERT_EQ(ys_krylov.size(), ts.size());
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (int i = 0; i < N; i += 3) {
+      EXPECT_NEAR(ys_krylov[n](i).val(), ys_dense[n](i).val(), 1e-6);
+
+      stan::math::set_zero_all_adjoints();
+      ys_krylov[n](i).grad();
+      const double theta_0_adj_krylov = theta_krylov[0].adj();
+      const double theta_1_adj_krylov = theta_krylov[1].adj();
+      Eigen::VectorXd y0_adj_krylov = y0_krylov.adj();
+
+      stan::math::set_zero_all_adjoints();
+      ys_dense[n](i).grad();
+      EXPECT_NEAR(theta_0_adj_krylov, theta_dense[0].adj(), 1e-5);
+      EXPECT_NEAR(theta_1_adj_krylov, theta_dense[1].adj(), 1e-5);
+      for (int j = 0; j < N; ++j) {
+        EXPECT_NEAR(y0_adj_krylov(j), y0_dense(j).adj(), 1e-5);
+      }
+    }
+  }
+  stan::math::recover_memory();
+}
+
+template <typename Solve>
+void expect_var_only_decay(const Solve& solve) {
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y0(2);
+  y0 << 1.0, 2.0;
+  std::vector<var> theta{0.5, 0.25};
+
+  auto ys = solve(y0, theta);
+  const double decayed = std::exp(-0.25);
+  EXPECT_NEAR(2.0 * decayed, ys[0](1).val(), 1e-6);
+  ys[0](1).grad();
+  EXPECT_NEAR(decayed, y0(1).adj(), 1e-6);
+  EXPECT_NEAR(-2.0 * decayed, theta[1].adj(), 1e-6);
+  EXPECT_FLOAT_EQ(0.0, theta[0].adj());
+  stan::math::recover_memory();
+}
+
+}  // namespace cvodes_krylov_test
+
+TEST(StanMathOdeKrylov, bdf_matches_dense) {
+  using cvodes_krylov_test::reaction_diffusion;
+  using cvodes_krylov_test::ts;
+  cvodes_krylov_test::expect_krylov_matches_dense(
+      [](const auto& y0, const auto& theta) {
+        return stan::math::ode_bdf_krylov_tol(reaction_diffusion(), y0, 0.0, ts,
+                                              1e-10, 1e-10, 1e6, nullptr,
+                                              theta);
+      },
+      [](const auto& y0, const auto& theta) {
+        return stan::math::ode_bdf_tol(reaction_diffusion(), y0, 0.0, ts,
+                                       1e-10, 1e-10, 1e6, nullptr, theta);
+      });
+}
+
+TEST(StanMathOdeKrylov, bdf_preconditioned_matches_dense) {
+  using cvodes_krylov_test::reaction_diffusion;
+  using cvodes_krylov_test::ts;
+  int num_calls = 0;
+  cvodes_krylov_test::jacobi_preconditioner preconditioner{&num_calls};
+  cvodes_krylov_test::expect_krylov_matches_dense(
+      [&](const auto& y0, const auto& theta) {
+        return stan::math::ode_bdf_krylov_tol(reaction_diffusion(),
+                                              preconditioner, y0, 0.0, ts,
+                                              1e-10, 1e-10, 1e6, nullptr,
+                                              theta);
+      },
+      [](const auto& y0, const auto& theta) {
+        return stan::math::ode_bdf_tol(reaction_diffusion(), y0, 0.0, ts,
+                                       1e-10, 1e-10, 1e6, nullptr, theta);
+      });
+  EXPECT_GT(num_calls, 0);
+}
+
+TEST(StanMathOdeKrylov, bdf_preconditioner_size) {
+  Eigen::VectorXd y0 = cvodes_krylov_test::initial_state();
+  EXPECT_THROW_MSG(
+      stan::math::ode_bdf_krylov_tol(
+          cvodes_krylov_test::reaction_diffusion(),
+          cvodes_krylov_test::wrong_size_preconditioner(), y0, 0.0,
+          cvodes_krylov_test::ts, 1e-10, 1e-10, 1e6, nullptr,
+          cvodes_krylov_test::theta_val),
+      std::invalid_argument, "preconditioned residual");
+}
+
+TEST(StanMathOdeKrylov, adjoint_matches_dense) {
+  using cvodes_krylov_test::reaction_diffusion;
+  using cvodes_krylov_test::ts;
+  const Eigen::VectorXd abs_tol = Eigen::VectorXd::Constant(20, 1e-10);
+  auto adjoint = [&](int solver) {
+    return [&, solver](const auto& y0, const auto& theta) {
+      return stan::math::ode_adjoint_tol_ctl(
+          reaction_diffusion(), y0, 0.0, ts, 1e-10, abs_tol, 1e-10, abs_tol,
+          1e-10, 1e-10, 1e6, 150, 1, solver, solver, nullptr, theta);
+    };
+  };
+  cvodes_krylov_test::expect_krylov_matches_dense(adjoint(3), adjoint(2));
+}
+
+TEST(StanMathOdeKrylov, var_only_rhs) {
+  // without fvar overloads CVODES approximates the Jacobian-vector
+  // products with difference quotients
+  const std::vector<double> ts{1.0};
+  const Eigen::VectorXd abs_tol = Eigen::VectorXd::Constant(2, 1e-10);
+  cvodes_krylov_test::expect_var_only_decay(
+      [&](const auto& y0, const auto& theta) {
+        return stan::math::ode_bdf_krylov_tol(var_only_decay_ode_fun(), y0,
+                                              0.0, ts, 1e-10, 1e-10, 1e6,
+                                              nullptr, theta);
+      });
+  cvodes_krylov_test::expect_var_only_decay(
+      [&](const auto& y0, const auto& theta) {
+        return stan::math::ode_adjoint_tol_ctl(
+            var_only_decay_ode_fun(), y0, 0.0, ts, 1e-10, abs_tol, 1e-10,
+            abs_tol, 1e-10, 1e-10, 1e6, 150, 1, 3, 3, nullptr, theta);
+      });
+  cvodes_krylov_test::expect_var_only_decay(
+      [&](const auto& y0, const auto& theta) {
+        return stan::math::ode_bdf(var_only_decay_ode_fun(), y0, 0.0, ts,
+                                   nullptr, theta);
+      });
+  cvodes_krylov_test::expect_var_only_decay(
+      [&](const auto& y0, const auto& theta) {
+        return stan::math::ode_adams(var_only_decay_ode_fun(), y0, 0.0, ts,
+                                     nullptr, theta);
+      });
+}
@@ -0,0 +1,220 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace cvodes_ode_batch_test {
+
+// two compartment model with first order absorption and elimination
+struct absorption_elimination {
+  template <typename T_y, typename T_theta>
+  Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1>
+  operator()(double t, const T_y& y, std::ostream* msgs,
+             const std::vector<T_theta>& theta) const {
+    Eigen::Matrix<stan::return_type_t<T_y, T_theta>, Eigen::Dynamic, 1> dy_dt(
+        2);
+    dy_dt(0) = -theta[0] * y.coeff(0);
+    dy_dt(1) = theta[0] * y.coeff(0) - theta[1] * y.coeff(1);
+    return dy_dt;
+  }
+};
+
+const std::vector<std::vector<double>> ts{
+    {0.5, 1.0, 2.0}, {1.0, 3.0}, {0.25, 0.5, 4.0, 8.0}, {2.0}};
+const std::vector<std::vector<double>> theta_val{
+    {1.2, 0.3}, {0.8, 0.2}, {1.5, 0.5}, {0.6, 0.1}};
+
+std::vector<Eigen::VectorXd> initial_states() {
+  std::vector<Eigen::VectorXd> y0(ts.size(), Eigen::VectorXd(2));
+  for (size_t s = 0; s < y0.size(); ++s) {
+    y0[s] << 10.0 * (1 + s), 0.5 * s;
+  }
+  return y0;
+}
+
+template <typename Batch, typename Single>
+void expect_batch_matches_single(const Batch& batch, const Single& single) {
+  using stan::math::var;
+  const std::vector<Eigen::VectorXd> y0 = initial_states();
+  const size_t num_subjects = y0.size();
+
+  std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>> y0_batch;
+  std::vector<std::vector<var>> theta_batch;
+  for (size_t s = 0; s < num_subjects; ++s) {
+    y0_batch.emplace_back(y0[s]);
+    theta_batch.emplace_back(theta_val[s].begin(), theta_val[s].end());
+  }
+  auto ys_batch = batch(y0_batch, theta_batch);
+  ASSERT_EQ(ys_batch.size(), num_subjects);
+
+  for (size_t s = 0; s < num_subjects; ++s) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> y0_single = y0[s];
+    std::vector<var> theta_single(theta_val[s].begin(), theta_val[s].end());
+    auto ys_single = single(y0_single, ts[s], theta_single);
+    ASSERT_EQ(ys_batch[s].size(), ts[s].size());
+
+    for (size_t n = 0; n < ts[s].size(); ++n) {
+      for (int i = 0; i < 2; ++i) {
+        EXPECT_FLOAT_EQ(ys_batch[s][n](i).val(), ys_single[n](i).val());
+
+        stan::math::set_zero_all_adjoints();
+        ys_batch[s][n](i).grad();
+        for (size_t r = 0; r < num_subjects; ++r) {
+          if (r != s) {
+            EXPECT_EQ(theta_batch[r][0].adj(), 0.0);
+            EXPECT_EQ(y0_batch[r](0).adj(), 0.0);
+          }
+        }
+        const std::vector<double> theta_adj_batch{theta_batch[s][0].adj(),
+                                                  theta_batch[s][1].adj()};
+        const Eigen::VectorXd y0_adj_batch = y0_batch[s].adj();
+
+        stan::math::set_zero_all_adjoints();
+        ys_single[n](i).grad();
+        EXPECT_FLOAT_EQ(theta_adj_batch[0], theta_single[0].adj());
+        EXPECT_FLOAT_EQ(theta_adj_batch[1], theta_single[1].adj());
+        EXPECT_FLOAT_EQ(y0_adj_batch(0), y0_single(0).adj());
+        EXPECT_FLOAT_EQ(y0_adj_batch(1), y0_single(1).adj());
+      }
+    }
+  }
+  stan::math::recover_memory();
+}
+
+}  // namespace cvodes_ode_batch_test
+
+TEST(StanMathOdeBatch, bdf_matches_single) {
+  using cvodes_ode_batch_test::absorption_elimination;
+  cvodes_ode_batch_test::expect_batch_matches_single(
+      [](const auto& y0, const auto& theta) {
+        return stan::math::ode_bdf_batch_tol(absorption_elimination(), y0, 0.0,
+                                             cvodes_ode_batch_test::ts, 1e-8,
+                                             1e-8, 1e6, nullptr, theta);
+      },
+      [](const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_bdf_tol(absorption_elimination(), y0, 0.0, ts,
+                                       1e-8, 1e-8, 1e6, nullptr, theta);
+      });
+}
+
+TEST(StanMathOdeBatch, adams_matches_single) {
+  using cvodes_ode_batch_test::absorption_elimination;
+  cvodes_ode_batch_test::expect_batch_matches_single(
+      [](const auto& y0, const auto& theta) {
+        return stan::math::ode_adams_batch(absorption_elimination(), y0, 0.0,
+                                           cvodes_ode_batch_test::ts, nullptr,
+                                           theta);
+      },
+      [](const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_adams(absorption_elimination(), y0, 0.0, ts,
+                                     nullptr, theta);
+      });
+}
+
+TEST(StanMathOdeBatch, rk45_matches_single) {
+  using cvodes_ode_batch_test::absorption_elimination;
+  cvodes_ode_batch_test::expect_batch_matches_single(
+      [](const auto& y0, const auto& theta) {
+        return stan::math::ode_rk45_batch(absorption_elimination(), y0, 0.0,
+                                          cvodes_ode_batch_test::ts, nullptr,
+                                          theta);
+      },
+      [](const auto& y0, const auto& ts, const auto& theta) {
+        return stan::math::ode_rk45(absorption_elimination(), y0, 0.0, ts,
+                                    nullptr, theta);
+      });
+}
+
+TEST(StanMathOdeBatch, var_times) {
+  using stan::math::var;
+  using cvodes_ode_batch_test::absorption_elimination;
+  const std::vector<Eigen::VectorXd> y0
+      = cvodes_ode_batch_test::initial_states();
+  const auto& theta = cvodes_ode_batch_test::theta_val;
+
+  var t0_batch = -0.5;
+  std::vector<std::vector<var>> ts_batch;
+  for (const auto& ts_s : cvodes_ode_batch_test::ts) {
+    ts_batch.emplace_back(ts_s.begin(), ts_s.end());
+  }
+  auto ys_batch = stan::math::ode_bdf_batch(
+      absorption_elimination(), y0, t0_batch, ts_batch, nullptr, theta);
+
+  for (size_t s = 0; s < y0.size(); ++s) {
+    var t0_single = -0.5;
+    std::vector<var> ts_single(ts_batch[s].size());
+    for (size_t n = 0; n < ts_single.size(); ++n) {
+      ts_single[n] = ts_batch[s][n].val();
+    }
+    auto ys_single = stan::math::ode_bdf(
+        absorption_elimination(), y0[s], t0_single, ts_single, nullptr,
+        theta[s]);
+
+    for (size_t n = 0; n < ts_single.size(); ++n) {
+      stan::math::set_zero_all_adjoints();
+      ys_batch[s][n](1).grad();
+      const double t0_adj_batch = t0_batch.adj();
+      const double t_adj_batch = ts_batch[s][n].adj();
+
+      stan::math::set_zero_all_adjoints();
+      ys_single[n](1).grad();
+      EXPECT_FLOAT_EQ(ys_batch[s][n](1).val(), ys_single[n](1).val());
+      EXPECT_FLOAT_EQ(t0_adj_batch, t0_single.adj());
+      EXPECT_FLOAT_EQ(t_adj_batch, ts_single[n].adj());
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeBatch, double_inputs) {
+  using cvodes_ode_batch_test::absorption_elimination;
+  const std::vector<Eigen::VectorXd> y0
+      = cvodes_ode_batch_test::initial_states();
+  const auto& ts = cvodes_ode_batch_test::ts;
+  const auto& theta = cvodes_ode_batch_test::theta_val;
+
+  const std::vector<std::vector<Eigen::VectorXd>> ys_batch
+      = stan::math::ode_bdf_batch(absorption_elimination(), y0, 0.0, ts,
+                                  nullptr, theta);
+  ASSERT_EQ(ys_batch.size(), y0.size());
+  for (size_t s = 0; s < y0.size(); ++s) {
+    const std::vector<Eigen::VectorXd> ys_single = stan::math::ode_bdf(
+        absorption_elimination(), y0[s], 0.0, ts[s], nullptr, theta[s]);
+    ASSERT_EQ(ys_batch[s].size(), ys_single.size());
+    for (size_t n = 0; n < ys_single.size(); ++n) {
+      EXPECT_MATRIX_FLOAT_EQ(ys_batch[s][n], ys_single[n]);
+    }
+  }
+}
+
+TEST(StanMathOdeBatch, errors) {
+  using cvodes_ode_batch_test::absorption_elimination;
+  const std::vector<Eigen::VectorXd> y0
+      = cvodes_ode_batch_test::initial_states();
+  const auto& ts = cvodes_ode_batch_test::ts;
+  const auto& theta = cvodes_ode_batch_test::theta_val;
+
+  std::vector<std::vector<double>> ts_short(ts.begin(), ts.end() - 1);
+  EXPECT_THROW_MSG(stan::math::ode_bdf_batch(absorption_elimination(), y0, 0.0,
+                                             ts_short, nullptr, theta),
+                   std::invalid_argument, "number of output time vectors");
+
+  std::vector<std::vector<double>> theta_short(theta.begin(), theta.end() - 1);
+  EXPECT_THROW_MSG(stan::math::ode_rk45_batch(absorption_elimination(), y0,
+                                              0.0, ts, nullptr, theta_short),
+                   std::invalid_argument, "number of arguments");
+
+  std::vector<std::vector<double>> ts_unsorted = ts;
+  ts_unsorted[2] = {1.0, 0.5};
+  EXPECT_THROW_MSG(stan::math::ode_bdf_batch(absorption_elimination(), y0, 0.0,
+                                             ts_unsorted, nullptr, theta),
+                   std::domain_error, "ode_bdf_batch");
+
+  EXPECT_TRUE((stan::math::ode_adams_batch_tol(
+                   absorption_elimination(),
+                   std::vector<Eigen::VectorXd>{}, 0.0,
+                   std::vector<std::vector<double>>{}, 1e-8, 1e-8, 1e6,
+                   nullptr, std::vector<std::vector<double>>{})
+                   .empty()));
+}
@@ -0,0 +1,81 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+
+namespace fused_elementwise_test {
+struct exp_fma {
+  template <typename T1, typename T2, typename T3>
+  auto operator()(const T1& x, const T2& y, const T3& z) const {
+    using stan::math::exp;
+    return exp(x * y + z);
+  }
+};
+
+struct log_ratio {
+  template <typename T1, typename T2>
+  auto operator()(const T1& x, const T2& y) const {
+    using stan::math::log1p;
+    using stan::math::square;
+    return log1p(square(x)) / y - 2.5 * x;
+  }
+};
+}  // namespace fused_elementwise_test
+
+TEST(RevFunctor, fusedElementwiseMatrixVar) {
+  using stan::math::var;
+  Eigen::MatrixXd x(2, 2);
+  x << 0.5, -1.2, 0.3, 2.0;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> x_v = x;
+  var y_v = 1.5;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> res
+      = stan::math::fused_elementwise(fused_elementwise_test::log_ratio{}, x_v,
+                                      y_v);
+  stan::math::sum(res).grad();
+  double y_adj = 0;
+  for (int i = 0; i < x.size(); ++i) {
+    const double x_i = x(i);
+    EXPECT_FLOAT_EQ(std::log1p(x_i * x_i) / 1.5 - 2.5 * x_i, res(i).val());
+    EXPECT_FLOAT_EQ(2 * x_i / (1 + x_i * x_i) / 1.5 - 2.5, x_v(i).adj());
+    y_adj -= std::log1p(x_i * x_i) / (1.5 * 1.5);
+  }
+  EXPECT_FLOAT_EQ(y_adj, y_v.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevFunctor, fusedElementwiseOneNode) {
+  using stan::math::var_value;
+  Eigen::VectorXd a = Eigen::VectorXd::Random(5);
+  Eigen::VectorXd b = Eigen::VectorXd::Random(5);
+  var_value<Eigen::VectorXd> a_v(a);
+  var_value<Eigen::VectorXd> b_v(b);
+  stan::math::var c_v = 0.3;
+  auto& stack = stan::math::ChainableStack::instance_->var_stack_;
+  const size_t start = stack.size();
+  auto res = stan::math::fused_elementwise(fused_elementwise_test::exp_fma{},
+                                           a_v, b_v, c_v);
+  // only the callback is chained
+  EXPECT_EQ(start + 1, stack.size());
+  stan::math::sum(res).grad();
+  for (int i = 0; i < 5; ++i) {
+    const double e = std::exp(a(i) * b(i) + 0.3);
+    EXPECT_FLOAT_EQ(e, res.val()(i));
+    EXPECT_FLOAT_EQ(e * b(i), a_v.adj()(i));
+    EXPECT_FLOAT_EQ(e * a(i), b_v.adj()(i));
+  }
+  EXPECT_FLOAT_EQ((a.array() * b.array() + 0.3).exp().sum(), c_v.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevFunctor, fusedElementwiseSizes) {
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> a = Eigen::VectorXd::Ones(3);
+  Eigen::VectorXd b = Eigen::VectorXd::Ones(4);
+  EXPECT_THROW(stan::math::fused_elementwise(
+                   fused_elementwise_test::log_ratio{}, a, b),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::fused_elementwise(
+                   fused_elementwise_test::log_ratio{}, b, a),
+               std::invalid_argument);
+  stan::math::recover_memory();
+}
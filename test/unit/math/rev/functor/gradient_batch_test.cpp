@@ -0,0 +1,103 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace gradient_batch_test {
+// f(x, y) = x^2 * y + 3 * y^2
+struct fun1 {
+  template <typename T>
+  inline T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    return x(0) * x(0) * x(1) + 3.0 * x(1) * x(1);
+  }
+};
+
+// throws for a negative first argument
+struct fun_throws {
+  template <typename T>
+  inline T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    if (x(0) < 0) {
+      throw std::domain_error("negative argument");
+    }
+    return stan::math::log(x(0)) * x(1);
+  }
+};
+}  // namespace gradient_batch_test
+
+TEST(RevFunctor, gradientBatch) {
+  using stan::math::gradient;
+  using stan::math::gradient_batch;
+  gradient_batch_test::fun1 f;
+  Eigen::MatrixXd X(5, 2);
+  X << 5, 7, -1, 2, 0, 0, 0.5, -3, 11, 13;
+  for (int grainsize : {1, 2, 5, 10}) {
+    Eigen::VectorXd fx;
+    Eigen::MatrixXd grad_fx;
+    auto errors = gradient_batch(f, X, fx, grad_fx, grainsize);
+    ASSERT_EQ(5, fx.size());
+    ASSERT_EQ(5, grad_fx.rows());
+    ASSERT_EQ(2, grad_fx.cols());
+    ASSERT_EQ(5, errors.size());
+    for (int b = 0; b < X.rows(); ++b) {
+      double fx_b;
+      Eigen::VectorXd grad_b;
+      gradient(f, Eigen::VectorXd(X.row(b).transpose()), fx_b, grad_b);
+      EXPECT_FALSE(errors[b]);
+      EXPECT_FLOAT_EQ(fx_b, fx(b));
+      EXPECT_FLOAT_EQ(grad_b(0), grad_fx(b, 0));
+      EXPECT_FLOAT_EQ(grad_b(1), grad_fx(b, 1));
+    }
+  }
+  EXPECT_EQ(0, stan::math::ChainableStack::instance_->var_stack_.size());
+}
+
+TEST(RevFunctor, gradientBatchIsolatesErrors) {
+  using stan::math::gradient_batch;
+  gradient_batch_test::fun_throws f;
+  Eigen::MatrixXd X(4, 2);
+  X << 2, 3, -1, 2, 0.5, 4, -2, 1;
+  Eigen::VectorXd fx;
+  Eigen::MatrixXd grad_fx;
+  auto errors = gradient_batch(f, X, fx, grad_fx);
+  ASSERT_EQ(4, errors.size());
+
+  EXPECT_FALSE(errors[0]);
+  EXPECT_FLOAT_EQ(std::log(2.0) * 3, fx(0));
+  EXPECT_FLOAT_EQ(3 / 2.0, grad_fx(0, 0));
+  EXPECT_FLOAT_EQ(std::log(2.0), grad_fx(0, 1));
+  EXPECT_FALSE(errors[2]);
+  EXPECT_FLOAT_EQ(std::log(0.5) * 4, fx(2));
+  EXPECT_FLOAT_EQ(4 / 0.5, grad_fx(2, 0));
+  EXPECT_FLOAT_EQ(std::log(0.5), grad_fx(2, 1));
+
+  for (int b : {1, 3}) {
+    ASSERT_TRUE(errors[b]);
+    EXPECT_THROW(std::rethrow_exception(errors[b]), std::domain_error);
+    EXPECT_TRUE(std::isnan(fx(b)));
+    EXPECT_TRUE(std::isnan(grad_fx(b, 0)));
+    EXPECT_TRUE(std::isnan(grad_fx(b, 1)));
+  }
+  EXPECT_EQ(0, stan::math::ChainableStack::instance_->var_stack_.size());
+}
+
+TEST(RevFunctor, gradientBatchEmpty) {
+  gradient_batch_test::fun1 f;
+  Eigen::MatrixXd X(0, 2);
+  Eigen::VectorXd fx;
+  Eigen::MatrixXd grad_fx;
+  auto errors = stan::math::gradient_batch(f, X, fx, grad_fx);
+  EXPECT_EQ(0, errors.size());
+  EXPECT_EQ(0, fx.size());
+  EXPECT_EQ(0, grad_fx.rows());
+  EXPECT_EQ(2, grad_fx.cols());
+}
+
+TEST(RevFunctor, gradientBatchGrainsize) {
+  gradient_batch_test::fun1 f;
+  Eigen::MatrixXd X(2, 2);
+  Eigen::VectorXd fx;
+  Eigen::MatrixXd grad_fx;
+  EXPECT_THROW(stan::math::gradient_batch(f, X, fx, grad_fx, 0),
+               std::domain_error);
+}
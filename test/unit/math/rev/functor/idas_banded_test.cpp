@@ -0,0 +1,95 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace idas_banded_test {
+
+// discretized diffusion with decay, closed by an algebraic boundary
+// condition, with tridiagonal Jacobians
+struct diffusion_dae {
+  template <typename T_yy, typename T_yp, typename T_theta>
+  Eigen::Matrix<stan::return_type_t<T_yy, T_yp, T_theta>, Eigen::Dynamic, 1>
+  operator()(double t, const Eigen::Matrix<T_yy, Eigen::Dynamic, 1>& yy,
+             const Eigen::Matrix<T_yp, Eigen::Dynamic, 1>& yp,
+             std::ostream* msgs, const std::vector<T_theta>& theta) const {
+    const int N = yy.size();
+    Eigen::Matrix<stan::return_type_t<T_yy, T_yp, T_theta>, Eigen::Dynamic, 1>
+        res(N);
+    for (int i = 0; i < N - 1; ++i) {
+      auto left = i > 0 ? yy(i - 1) : yy(i);
+      res(i) = yp(i) - theta[0] * (left - 2 * yy(i) + yy(i + 1))
+               + theta[1] * yy(i);
+    }
+    res(N - 1) = yy(N - 1) - yy(N - 2);
+    return res;
+  }
+};
+
+}  // namespace idas_banded_test
+
+TEST(StanMathDaeBanded, tridiagonal_matches_dense) {
+  using stan::math::var;
+  const int N = 9;
+  const std::vector<double> theta{0.6, 0.2};
+  Eigen::VectorXd yy0(N);
+  for (int i = 0; i < N - 1; ++i) {
+    yy0(i) = 1.0 / (1.0 + i);
+  }
+  yy0(N - 1) = yy0(N - 2);
+  Eigen::VectorXd zero = Eigen::VectorXd::Zero(N);
+  Eigen::VectorXd yp0
+      = -idas_banded_test::diffusion_dae()(0.0, yy0, zero, nullptr, theta);
+  yp0(N - 1) = yp0(N - 2);
+  std::vector<double> ts{0.5, 1.0, 4.0};
+
+  std::vector<var> theta_banded(theta.begin(), theta.end());
+  auto ys_banded = stan::math::dae_banded_tol(
+      idas_banded_test::diffusion_dae(), yy0, yp0, 0.0, ts, 1e-10, 1e-10, 1e6,
+      1, 1, nullptr, theta_banded);
+
+  std::vector<var> theta_dense(theta.begin(), theta.end());
+  auto ys_dense
+      = stan::math::dae_tol(idas_banded_test::diffusion_dae(), yy0, yp0, 0.0,
+                            ts, 1e-10, 1e-10, 1e6, nullptr, theta_dense);
+
+  ASSERT_EQ(ys_banded.size(), ts.size());
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (int i = 0; i < N; ++i) {
+      EXPECT_NEAR(ys_banded[n](i).val(), ys_dense[n](i).val(), 1e-8);
+
+      stan::math::set_zero_all_adjoints();
+      ys_banded[n](i).grad();
+      const double theta_adj_banded_0 = theta_banded[0].adj();
+      const double theta_adj_banded_1 = theta_banded[1].adj();
+
+      stan::math::set_zero_all_adjoints();
+      ys_dense[n](i).grad();
+      EXPECT_NEAR(theta_adj_banded_0, theta_dense[0].adj(), 1e-6);
+      EXPECT_NEAR(theta_adj_banded_1, theta_dense[1].adj(), 1e-6);
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathDaeBanded, bandwidth_errors) {
+  const int N = 4;
+  Eigen::VectorXd yy0 = Eigen::VectorXd::Ones(N);
+  Eigen::VectorXd yp0(N);
+  yp0 << -0.2, -0.2, -0.2, -0.2;
+  std::vector<double> ts{1.0};
+  std::vector<double> theta{0.6, 0.2};
+  idas_banded_test::diffusion_dae f;
+
+  EXPECT_NO_THROW(stan::math::dae_banded_tol(f, yy0, yp0, 0.0, ts, 1e-8, 1e-8,
+                                             1e6, 3, 3, nullptr, theta));
+  EXPECT_THROW(stan::math::dae_banded_tol(f, yy0, yp0, 0.0, ts, 1e-8, 1e-8,
+                                          1e6, -1, 1, nullptr, theta),
+               std::domain_error);
+  EXPECT_THROW(stan::math::dae_banded_tol(f, yy0, yp0, 0.0, ts, 1e-8, 1e-8,
+                                          1e6, 1, -1, nullptr, theta),
+               std::domain_error);
+  EXPECT_THROW(stan::math::dae_banded_tol(f, yy0, yp0, 0.0, ts, 1e-8, 1e-8,
+                                          1e6, 1, 4, nullptr, theta),
+               std::domain_error);
+}
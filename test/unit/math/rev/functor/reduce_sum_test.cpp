@@ -431,3 +431,79 @@ TEST(StanMathRev_reduce_sum, linked_args) {
 
   stan::math::recover_memory();
 }
+
+TEST(StanMathRev_reduce_sum, repeated_calls_copy_new_shared_values) {
+  using stan::math::var;
+  using stan::math::test::count_lpdf;
+  using stan::math::test::get_new_msg;
+
+  const std::size_t elems = 1000;
+  std::vector<int> data(elems);
+  for (std::size_t i = 0; i != elems; ++i)
+    data[i] = i % 20;
+  std::vector<int> idata;
+
+  // scopes are reused across calls, but must see the new argument values
+  for (double lambda_d : {2.0, 5.0, 10.0, 5.0}) {
+    var lambda_v = lambda_d;
+    std::vector<var> vlambda_v(1, lambda_v);
+    var poisson_lpdf = stan::math::reduce_sum<count_lpdf<var>>(
+        data, 1, get_new_msg(), vlambda_v, idata);
+    var lambda_ref = lambda_d;
+    var poisson_lpdf_ref = stan::math::poisson_lpmf(data, lambda_ref);
+    EXPECT_FLOAT_EQ(poisson_lpdf_ref.val(), poisson_lpdf.val());
+
+    stan::math::grad(poisson_lpdf_ref.vi_);
+    const double lambda_ref_adj = lambda_ref.adj();
+    stan::math::set_zero_all_adjoints();
+    stan::math::grad(poisson_lpdf.vi_);
+    EXPECT_FLOAT_EQ(lambda_ref_adj, lambda_v.adj());
+    stan::math::recover_memory();
+  }
+}
+
+namespace {
+struct indexed_square_lpdf {
+  template <typename T>
+  inline auto operator()(const std::vector<int>& idx_slice, int start,
+                         int end, std::ostream* msgs,
+                         const std::vector<T>& theta) const {
+    stan::return_type_t<T> lp = 0;
+    for (int i : idx_slice) {
+      lp += stan::math::square(theta[i]);
+    }
+    return lp;
+  }
+};
+}  // namespace
+
+TEST(StanMathRev_reduce_sum, chunks_touching_few_shared_args) {
+  using stan::math::var;
+  using stan::math::test::get_new_msg;
+
+  // every term uses one of many shared parameters
+  const int num_params = 2000;
+  std::vector<int> idx;
+  for (int i = 0; i < num_params; i += 3) {
+    idx.push_back(i);
+    idx.push_back(i);
+  }
+  std::vector<var> theta;
+  for (int i = 0; i < num_params; ++i) {
+    theta.emplace_back(0.001 * i);
+  }
+  var lp_static = stan::math::reduce_sum_static<indexed_square_lpdf>(
+      idx, 4, get_new_msg(), theta);
+  var lp = stan::math::reduce_sum<indexed_square_lpdf>(idx, 4, get_new_msg(),
+                                                       theta);
+  EXPECT_FLOAT_EQ(lp_static.val(), lp.val());
+  stan::math::grad(lp.vi_);
+  for (int i = 0; i < num_params; ++i) {
+    EXPECT_FLOAT_EQ(i % 3 == 0 ? 4 * 0.001 * i : 0.0, theta[i].adj());
+  }
+  stan::math::set_zero_all_adjoints();
+  stan::math::grad(lp_static.vi_);
+  EXPECT_FLOAT_EQ(4 * 0.001 * 3, theta[3].adj());
+  EXPECT_FLOAT_EQ(0.0, theta[4].adj());
+  stan::math::recover_memory();
+}
@@ -0,0 +1,186 @@
+#define STAN_SCALAR_OP_TAPE
+#include <stan/math/rev.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::VectorXd;
+
+namespace {
+// sum_i (x_i - mu)^2 / sigma + log(sigma), with mu = x_0, sigma = exp(x_1)
+struct normal_like {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    using stan::math::exp;
+    using stan::math::log;
+    using stan::math::sqrt;
+    using stan::math::square;
+    T mu = x(0);
+    T sigma = exp(x(1));
+    T lp = 0;
+    for (int i = 2; i < x.size(); ++i) {
+      lp += square(x(i) - mu) / sigma + log(sigma);
+    }
+    return lp - 0.5 * sqrt(sigma);
+  }
+};
+
+struct branching {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    if (x(0) > 0) {
+      return x(0) * x(1);
+    }
+    return exp(x(1)) - x(0);
+  }
+};
+
+struct abs_product {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return stan::math::fabs(x(0)) * x(1);
+  }
+};
+
+// branches inside library functions on the values of their arguments
+struct library_branches {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    T y = stan::math::fdim(x(0), x(1)) + stan::math::step(x(1)) * x(0);
+    if (stan::math::is_nan(x(0))) {
+      y += x(1);
+    }
+    return y + stan::math::fmax(x(0), x(1));
+  }
+};
+
+struct rounded {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return stan::math::floor(x(0)) * x(1);
+  }
+};
+
+struct not_taped {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return stan::math::sin(x(0)) * x(1);
+  }
+};
+
+template <typename F>
+void expect_taped_gradient(stan::math::taped_gradient<F>& taped,
+                           const VectorXd& x) {
+  double fx;
+  VectorXd grad_fx;
+  taped(x, fx, grad_fx);
+  double fx_expected;
+  VectorXd grad_fx_expected;
+  stan::math::gradient(F(), x, fx_expected, grad_fx_expected);
+  EXPECT_FLOAT_EQ(fx_expected, fx);
+  ASSERT_EQ(grad_fx_expected.size(), grad_fx.size());
+  for (int i = 0; i < x.size(); ++i) {
+    EXPECT_FLOAT_EQ(grad_fx_expected(i), grad_fx(i));
+  }
+}
+}  // namespace
+
+TEST(RevFunctor, tapedGradientReplays) {
+  stan::math::taped_gradient<normal_like> taped{normal_like()};
+  for (int n = 0; n < 5; ++n) {
+    VectorXd x = VectorXd::Random(6);
+    expect_taped_gradient(taped, x);
+  }
+  EXPECT_TRUE(taped.recorded());
+  EXPECT_EQ(1, taped.num_recordings());
+  EXPECT_EQ(4, taped.num_replays());
+  EXPECT_GT(taped.size(), 0);
+  EXPECT_EQ(0, stan::math::ChainableStack::instance_->var_stack_.size());
+}
+
+TEST(RevFunctor, tapedGradientDetectsBranches) {
+  stan::math::taped_gradient<branching> taped{branching()};
+  VectorXd x(2);
+  x << 1.5, 0.3;
+  expect_taped_gradient(taped, x);
+  x << 2.5, -0.3;
+  expect_taped_gradient(taped, x);
+  EXPECT_EQ(1, taped.num_recordings());
+  EXPECT_EQ(1, taped.num_replays());
+
+  // other branch
+  x << -1.5, 0.3;
+  expect_taped_gradient(taped, x);
+  EXPECT_EQ(2, taped.num_recordings());
+  x << -0.5, 0.7;
+  expect_taped_gradient(taped, x);
+  EXPECT_EQ(2, taped.num_replays());
+
+  // and back
+  x << 0.5, 0.7;
+  expect_taped_gradient(taped, x);
+  EXPECT_EQ(3, taped.num_recordings());
+}
+
+TEST(RevFunctor, tapedGradientDetectsLibraryBranches) {
+  stan::math::taped_gradient<abs_product> taped{abs_product()};
+  VectorXd x(2);
+  x << -1.0, 3.0;
+  expect_taped_gradient(taped, x);
+  x << -2.0, 3.0;
+  expect_taped_gradient(taped, x);
+  EXPECT_EQ(1, taped.num_recordings());
+  EXPECT_EQ(1, taped.num_replays());
+
+  // fabs takes the other branch on the other side of zero
+  x << 2.0, 3.0;
+  double fx;
+  VectorXd grad_fx;
+  taped(x, fx, grad_fx);
+  EXPECT_FLOAT_EQ(6.0, fx);
+  EXPECT_FLOAT_EQ(3.0, grad_fx(0));
+  EXPECT_FLOAT_EQ(2.0, grad_fx(1));
+  EXPECT_EQ(2, taped.num_recordings());
+  EXPECT_EQ(1, taped.num_replays());
+
+  stan::math::taped_gradient<library_branches> taped_branches{
+      library_branches()};
+  for (double x0 : {-1.5, -0.5, 0.5, 1.5}) {
+    for (double x1 : {-1.0, 1.0}) {
+      x << x0, x1;
+      expect_taped_gradient(taped_branches, x);
+    }
+  }
+  EXPECT_GT(taped_branches.num_recordings(), 1);
+}
+
+TEST(RevFunctor, tapedGradientDoesNotReplayConstantsOfValues) {
+  stan::math::taped_gradient<rounded> taped{rounded()};
+  VectorXd x(2);
+  for (double x0 : {0.5, 1.5, 2.5}) {
+    x << x0, 3.0;
+    expect_taped_gradient(taped, x);
+  }
+  EXPECT_FALSE(taped.recorded());
+  EXPECT_EQ(0, taped.num_replays());
+}
+
+TEST(RevFunctor, tapedGradientFallsBack) {
+  stan::math::taped_gradient<not_taped> taped{not_taped()};
+  for (int n = 0; n < 3; ++n) {
+    VectorXd x = VectorXd::Random(2);
+    expect_taped_gradient(taped, x);
+  }
+  EXPECT_FALSE(taped.recorded());
+  EXPECT_EQ(0, taped.num_replays());
+}
+
+TEST(RevFunctor, tapedGradientSizeChange) {
+  stan::math::taped_gradient<normal_like> taped{normal_like()};
+  expect_taped_gradient(taped, VectorXd::Random(4));
+  expect_taped_gradient(taped, VectorXd::Random(7));
+  EXPECT_EQ(2, taped.num_recordings());
+  EXPECT_EQ(0, taped.num_replays());
+}
@@ -0,0 +1,36 @@
+#ifndef TEST_UNIT_MATH_REV_FUNCTOR_VAR_ONLY_ODE_FUNCTOR_HPP
+#define TEST_UNIT_MATH_REV_FUNCTOR_VAR_ONLY_ODE_FUNCTOR_HPP
+
+#include <stan/math/rev.hpp>
+#include <ostream>
+#include <vector>
+
+/**
+ * Independent exponential decays y_i' = -theta_i y_i, with a right
+ * hand side that is only defined for double and var states, like a
+ * hand written functor without forward mode support.
+ */
+struct var_only_decay_ode_fun {
+  Eigen::VectorXd operator()(double t, const Eigen::VectorXd& y,
+                             std::ostream* msgs,
+                             const std::vector<double>& theta) const {
+    Eigen::VectorXd dy_dt(y.size());
+    for (int i = 0; i < y.size(); ++i) {
+      dy_dt(i) = -theta[i] * y(i);
+    }
+    return dy_dt;
+  }
+
+  template <typename T_theta>
+  Eigen::Matrix<stan::math::var, Eigen::Dynamic, 1> operator()(
+      double t, const Eigen::Matrix<stan::math::var, Eigen::Dynamic, 1>& y,
+      std::ostream* msgs, const std::vector<T_theta>& theta) const {
+    Eigen::Matrix<stan::math::var, Eigen::Dynamic, 1> dy_dt(y.size());
+    for (int i = 0; i < y.size(); ++i) {
+      dy_dt(i) = -theta[i] * y(i);
+    }
+    return dy_dt;
+  }
+};
+
+#endif
@@ -0,0 +1,37 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+TEST(ProbBernoulliLogit, large_theta_gradient) {
+  using stan::math::var;
+  // d/dtheta log(inv_logit(theta)) = inv_logit(-theta) > 0 for n = 1
+  for (double theta_val : {19.0, 21.0, 25.0, 40.0}) {
+    var theta = theta_val;
+    var logp = stan::math::bernoulli_logit_lpmf(1, theta);
+    logp.grad();
+    EXPECT_FLOAT_EQ(logp.val(), -std::log1p(std::exp(-theta_val)));
+    EXPECT_GT(theta.adj(), 0.0);
+    EXPECT_FLOAT_EQ(theta.adj(), stan::math::inv_logit(-theta_val));
+    stan::math::recover_memory();
+  }
+
+  var theta = 25.0;
+  var logp = stan::math::bernoulli_logit_lpmf(1, theta);
+  logp.grad();
+  EXPECT_FLOAT_EQ(theta.adj(), std::exp(-25.0));
+  stan::math::recover_memory();
+}
+
+TEST(ProbBernoulliLogit, large_theta_gradient_vectorized) {
+  using stan::math::var;
+  std::vector<int> n{1, 0, 1, 0};
+  std::vector<var> theta{25.0, -25.0, -25.0, 25.0};
+  var logp = stan::math::bernoulli_logit_lpmf(n, theta);
+  logp.grad();
+  EXPECT_FLOAT_EQ(theta[0].adj(), std::exp(-25.0));
+  EXPECT_FLOAT_EQ(theta[1].adj(), -std::exp(-25.0));
+  EXPECT_FLOAT_EQ(theta[2].adj(), stan::math::inv_logit(25.0));
+  EXPECT_FLOAT_EQ(theta[3].adj(), -stan::math::inv_logit(25.0));
+  stan::math::recover_memory();
+}
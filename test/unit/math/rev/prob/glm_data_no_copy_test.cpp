@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstddef>
+
+namespace stan {
+namespace test {
+// number of elements of the largest Eigen matrix, array or product
+// temporary allocated since it was last reset, recorded by the storage
+// constructor plugin below
+std::size_t largest_eigen_allocation = 0;
+}  // namespace test
+}  // namespace stan
+
+#define EIGEN_DENSE_STORAGE_CTOR_PLUGIN                                    \
+  stan::test::largest_eigen_allocation = std::max(                         \
+      stan::test::largest_eigen_allocation, static_cast<std::size_t>(size));
+
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+//  The GLMs must read data design matrices in place, so that memory
+//  mapped data larger than the memory can be passed straight in.  Each
+//  call may allocate temporaries with one element per instance, but
+//  nothing as large as the design matrix, for any of the layouts below.
+namespace {
+
+const int N = 2000;
+const int K = 50;
+const std::size_t x_size = N * K;
+
+template <typename F, typename T_x>
+std::size_t largest_allocation(const F& f, const T_x& x) {
+  stan::test::largest_eigen_allocation = 0;
+  stan::math::var lp = f(x);
+  lp.grad();
+  std::size_t largest = stan::test::largest_eigen_allocation;
+  stan::math::recover_memory();
+  return largest;
+}
+
+template <typename F>
+void expect_no_copy_of_double_x(const F& f) {
+  using Eigen::Dynamic;
+  using Eigen::Matrix;
+  Matrix<double, Dynamic, Dynamic> x
+      = Matrix<double, Dynamic, Dynamic>::Random(N, K);
+  Matrix<double, Dynamic, Dynamic, Eigen::RowMajor> x_row_major = x;
+  Matrix<double, Dynamic, Dynamic> x_outer
+      = Matrix<double, Dynamic, Dynamic>::Random(N + 3, K + 2);
+  x_outer.block(1, 2, N, K) = x;
+
+  Eigen::Map<const Matrix<double, Dynamic, Dynamic>> x_map(x.data(), N, K);
+  Eigen::Map<const Matrix<double, Dynamic, Dynamic, Eigen::RowMajor>>
+      x_row_major_map(x_row_major.data(), N, K);
+  EXPECT_LT(largest_allocation(f, x_map), x_size);
+  EXPECT_LT(largest_allocation(f, x_row_major_map), x_size);
+  EXPECT_LT(largest_allocation(f, x_outer.block(1, 2, N, K)), x_size);
+}
+
+template <typename F>
+void expect_no_copy_of_x(const F& f) {
+  expect_no_copy_of_double_x(f);
+  Eigen::MatrixXf x_float = Eigen::MatrixXf::Random(N, K);
+  Eigen::Map<const Eigen::MatrixXf> x_float_map(x_float.data(), N, K);
+  EXPECT_LT(largest_allocation(f, x_float_map), x_size);
+}
+
+std::vector<int> binary_outcomes() {
+  std::vector<int> y(N);
+  for (int i = 0; i < N; i++) {
+    y[i] = i % 2;
+  }
+  return y;
+}
+
+std::vector<int> categories() {
+  std::vector<int> y(N);
+  for (int i = 0; i < N; i++) {
+    y[i] = 1 + i % 3;
+  }
+  return y;
+}
+
+}  // namespace
+
+TEST(ProbDistributionsGLM, instrumentation_sees_copies) {
+  Eigen::MatrixXd x = Eigen::MatrixXd::Random(N, K);
+  Eigen::Map<const Eigen::MatrixXd> x_map(x.data(), N, K);
+  EXPECT_GE(largest_allocation(
+                [](const auto& x) {
+                  Eigen::MatrixXd x_copy = x;
+                  return stan::math::var(x_copy(0, 0));
+                },
+                x_map),
+            x_size);
+}
+
+TEST(ProbDistributionsGLM, normal_id_glm_no_copy_of_data) {
+  using stan::math::var;
+  Eigen::VectorXd y = Eigen::VectorXd::Random(N);
+  expect_no_copy_of_x([&](const auto& x) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> beta = Eigen::VectorXd::Random(K);
+    var alpha = 0.3;
+    var sigma = 1.2;
+    return stan::math::normal_id_glm_lpdf(y, x, alpha, beta, sigma);
+  });
+}
+
+TEST(ProbDistributionsGLM, bernoulli_logit_glm_no_copy_of_data) {
+  using stan::math::var;
+  std::vector<int> y = binary_outcomes();
+  expect_no_copy_of_x([&](const auto& x) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> beta = Eigen::VectorXd::Random(K);
+    var alpha = 0.3;
+    return stan::math::bernoulli_logit_glm_lpmf(y, x, alpha, beta);
+  });
+}
+
+TEST(ProbDistributionsGLM, poisson_log_glm_no_copy_of_data) {
+  using stan::math::var;
+  std::vector<int> y = binary_outcomes();
+  expect_no_copy_of_x([&](const auto& x) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> beta = Eigen::VectorXd::Random(K);
+    var alpha = 0.3;
+    return stan::math::poisson_log_glm_lpmf(y, x, alpha, beta);
+  });
+}
+
+TEST(ProbDistributionsGLM, neg_binomial_2_log_glm_no_copy_of_data) {
+  using stan::math::var;
+  std::vector<int> y = binary_outcomes();
+  expect_no_copy_of_x([&](const auto& x) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> beta = Eigen::VectorXd::Random(K);
+    var alpha = 0.3;
+    var phi = 2.0;
+    return stan::math::neg_binomial_2_log_glm_lpmf(y, x, alpha, beta, phi);
+  });
+}
+
+TEST(ProbDistributionsGLM, ordered_logistic_glm_no_copy_of_data) {
+  using stan::math::var;
+  std::vector<int> y = categories();
+  expect_no_copy_of_x([&](const auto& x) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> beta = Eigen::VectorXd::Random(K);
+    Eigen::Matrix<var, Eigen::Dynamic, 1> cuts(2);
+    cuts << -0.5, 0.5;
+    return stan::math::ordered_logistic_glm_lpmf(y, x, beta, cuts);
+  });
+}
+
+TEST(ProbDistributionsGLM, categorical_logit_glm_no_copy_of_data) {
+  using stan::math::var;
+  std::vector<int> y = categories();
+  expect_no_copy_of_double_x([&](const auto& x) {
+    Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> beta
+        = Eigen::MatrixXd::Random(K, 3);
+    Eigen::Matrix<var, Eigen::Dynamic, 1> alpha = Eigen::VectorXd::Zero(3);
+    return stan::math::categorical_logit_glm_lpmf(y, x, alpha, beta);
+  });
+}
@@ -756,3 +756,40 @@ TEST(ProbDistributionsNormalIdGLM, glm_matches_normal_id_error_checking) {
   EXPECT_THROW(stan::math::normal_id_glm_lpdf(y, x, alpha, beta, sigmaw3),
                std::domain_error);
 }
+
+//  We check that single precision data gives the same values and gradients
+//  as the same data in double precision, and that the elementwise normal
+//  accepts single precision data too.
+TEST(ProbDistributionsNormalIdGLM, glm_matches_float_data) {
+  using Eigen::Dynamic;
+  using Eigen::Matrix;
+  using stan::math::var;
+  Matrix<float, Dynamic, 1> y_f = Matrix<float, Dynamic, 1>::Random(7);
+  Matrix<float, Dynamic, Dynamic> x_f
+      = Matrix<float, Dynamic, Dynamic>::Random(7, 3);
+  Matrix<double, Dynamic, 1> y_d = y_f.cast<double>();
+  Matrix<double, Dynamic, Dynamic> x_d = x_f.cast<double>();
+  Matrix<double, Dynamic, 1> beta_d(3);
+  beta_d << 0.3, 2, -0.7;
+  EXPECT_FLOAT_EQ(
+      stan::math::normal_id_glm_lpdf(y_d, x_d, 0.3, beta_d, 1.5),
+      stan::math::normal_id_glm_lpdf(y_f, x_f, 0.3, beta_d, 1.5));
+  EXPECT_FLOAT_EQ(stan::math::normal_lpdf(y_d, 0.3, 1.5),
+                  stan::math::normal_lpdf(y_f, 0.3, 1.5));
+
+  Matrix<var, Dynamic, 1> beta1 = beta_d;
+  Matrix<var, Dynamic, 1> beta2 = beta_d;
+  var alpha1 = 0.3;
+  var alpha2 = 0.3;
+  var sigma1 = 1.5;
+  var sigma2 = 1.5;
+  var lp1 = stan::math::normal_id_glm_lpdf(y_d, x_d, alpha1, beta1, sigma1);
+  var lp2 = stan::math::normal_id_glm_lpdf(y_f, x_f, alpha2, beta2, sigma2);
+  (lp1 + lp2).grad();
+  EXPECT_FLOAT_EQ(lp1.val(), lp2.val());
+  EXPECT_FLOAT_EQ(alpha1.adj(), alpha2.adj());
+  EXPECT_FLOAT_EQ(sigma1.adj(), sigma2.adj());
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_FLOAT_EQ(beta1[i].adj(), beta2[i].adj());
+  }
+}
@@ -570,3 +570,33 @@ TEST(ProbDistributionsPoissonLogGLM, glm_matches_poisson_log_vars_propto) {
   double lp1_val = lp1.val();
   EXPECT_FLOAT_EQ(lp_val, lp1_val);
 }
+
+//  We check that single precision data gives the same values and gradients
+//  as the same data in double precision.
+TEST(ProbDistributionsPoissonLogGLM, glm_matches_float_data) {
+  using Eigen::Dynamic;
+  using Eigen::Matrix;
+  using stan::math::var;
+  using std::vector;
+  vector<int> y{15, 3, 5, 0, 1, 7, 2};
+  Matrix<float, Dynamic, Dynamic> x_f
+      = Matrix<float, Dynamic, Dynamic>::Random(7, 3);
+  Matrix<double, Dynamic, Dynamic> x_d = x_f.cast<double>();
+  Matrix<double, Dynamic, 1> beta_d(3);
+  beta_d << 0.3, 2, -0.7;
+  EXPECT_FLOAT_EQ(stan::math::poisson_log_glm_lpmf(y, x_d, 0.3, beta_d),
+                  stan::math::poisson_log_glm_lpmf(y, x_f, 0.3, beta_d));
+
+  Matrix<var, Dynamic, 1> beta1 = beta_d;
+  Matrix<var, Dynamic, 1> beta2 = beta_d;
+  var alpha1 = 0.3;
+  var alpha2 = 0.3;
+  var lp1 = stan::math::poisson_log_glm_lpmf(y, x_d, alpha1, beta1);
+  var lp2 = stan::math::poisson_log_glm_lpmf(y, x_f, alpha2, beta2);
+  (lp1 + lp2).grad();
+  EXPECT_FLOAT_EQ(lp1.val(), lp2.val());
+  EXPECT_FLOAT_EQ(alpha1.adj(), alpha2.adj());
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_FLOAT_EQ(beta1[i].adj(), beta2[i].adj());
+  }
+}